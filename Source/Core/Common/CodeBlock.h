@@ -65,6 +65,9 @@ public:
 		}
 	}
 
+	u8* GetRegion() const { return region; }
+	size_t GetRegionSize() const { return region_size; }
+
 	bool IsInSpace(u8* ptr) const
 	{
 		return (ptr >= region) && (ptr < (region + region_size));
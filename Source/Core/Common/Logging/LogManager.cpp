@@ -2,17 +2,24 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdarg>
 #include <cstring>
+#include <ctime>
 #include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
 
+#if defined __ANDROID__ || defined __APPLE__
+#include <pthread.h>
+#endif
+
 #include "Common/FileUtil.h"
 #include "Common/IniFile.h"
 #include "Common/StringUtil.h"
-#include "Common/Timer.h"
+#include "Common/Thread.h"
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/Logging/LogManager.h"
@@ -28,9 +35,100 @@ void GenericLog(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type,
 	va_end(args);
 }
 
+struct LogRecord
+{
+	u64 sequence;
+	u64 time_ms;
+	const char* file;
+	int line;
+	LogTypes::LOG_LEVELS level;
+	LogTypes::LOG_TYPE type;
+	// Messages this thread dropped right before this one
+	u32 dropped;
+	char text[MAX_MSGLEN];
+};
+
+// Single producer, single consumer: only the owning thread advances head and only the logging
+// thread advances tail.
+class LogRing
+{
+public:
+	static const u32 SIZE = 512;
+
+	std::array<LogRecord, SIZE> records;
+	std::atomic<u32> head{0};
+	std::atomic<u32> tail{0};
+
+	// Only touched by the owning thread
+	u32 dropped = 0;
+	u64 window_start = 0;
+	u32 window_count = 0;
+};
+
+namespace
+{
+struct RingHandle
+{
+	u32 owner = 0;
+	std::shared_ptr<LogRing> ring;
+};
+
+std::atomic<u32> s_next_manager_id(1);
+
+u64 GetTimeMs()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Same format as Common::Timer::GetTimeFormatted
+std::string FormatTime(u64 time_ms)
+{
+	time_t seconds = (time_t)(time_ms / 1000);
+	char tmp[13];
+	strftime(tmp, 6, "%M:%S", localtime(&seconds));
+	return StringFromFormat("%s:%03d", tmp, (int)(time_ms % 1000));
+}
+
+// Android and OSX don't support thread_local
+#if defined __ANDROID__ || defined __APPLE__
+pthread_key_t s_ring_key;
+pthread_once_t s_ring_key_once = PTHREAD_ONCE_INIT;
+
+void DeleteRingHandle(void* handle)
+{
+	delete static_cast<RingHandle*>(handle);
+}
+
+void CreateRingKey()
+{
+	pthread_key_create(&s_ring_key, DeleteRingHandle);
+}
+
+RingHandle* GetRingHandle()
+{
+	pthread_once(&s_ring_key_once, CreateRingKey);
+	RingHandle* handle = static_cast<RingHandle*>(pthread_getspecific(s_ring_key));
+	if (!handle)
+	{
+		handle = new RingHandle();
+		pthread_setspecific(s_ring_key, handle);
+	}
+	return handle;
+}
+#else
+RingHandle* GetRingHandle()
+{
+	static thread_local RingHandle handle;
+	return &handle;
+}
+#endif
+}
+
 LogManager* LogManager::m_logManager = nullptr;
 
 LogManager::LogManager()
+	: m_id(s_next_manager_id++), m_sequence(0), m_dropped(0), m_exit(false)
 {
 	// create log containers
 	m_Log[LogTypes::ACTIONREPLAY] = new LogContainer("ActionReplay", "ActionReplay");
@@ -102,10 +200,16 @@ LogManager::LogManager()
 		if (enable && write_console)
 			container->AddListener(LogListener::CONSOLE_LISTENER);
 	}
+
+	m_thread = std::thread(&LogManager::LoggingThread, this);
 }
 
 LogManager::~LogManager()
 {
+	m_exit = true;
+	m_wake.notify_one();
+	m_thread.join();
+
 	for (LogContainer* container : m_Log)
 		delete container;
 
@@ -114,25 +218,143 @@ LogManager::~LogManager()
 	delete m_listeners[LogListener::FILE_LISTENER];
 }
 
+LogRing* LogManager::GetRing()
+{
+	RingHandle* handle = GetRingHandle();
+	if (handle->owner != m_id)
+	{
+		handle->owner = m_id;
+		handle->ring = std::make_shared<LogRing>();
+		std::lock_guard<std::mutex> lk(m_rings_lock);
+		m_rings.push_back(handle->ring);
+	}
+	return handle->ring.get();
+}
+
 void LogManager::Log(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type,
 	const char* file, int line, const char* format, va_list args)
 {
-	char temp[MAX_MSGLEN];
 	LogContainer* log = m_Log[type];
 
 	if (!(log->IsEnabled() && level <= log->GetLevel() && log->HasListeners()))
 		return;
 
-	CharArrayFromFormatV(temp, MAX_MSGLEN, format, args);
+	LogRing* ring = GetRing();
+	const u64 now = GetTimeMs();
+	if (now - ring->window_start >= 1000)
+	{
+		ring->window_start = now;
+		ring->window_count = 0;
+	}
+
+	const u32 head = ring->head.load(std::memory_order_relaxed);
+	const u32 used = head - ring->tail.load(std::memory_order_acquire);
+	if (used == LogRing::SIZE || ring->window_count >= MAX_MESSAGES_PER_SECOND)
+	{
+		ring->dropped++;
+		m_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	ring->window_count++;
+
+	LogRecord& record = ring->records[head % LogRing::SIZE];
+	record.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+	record.time_ms = now;
+	record.file = file;
+	record.line = line;
+	record.level = level;
+	record.type = type;
+	record.dropped = ring->dropped;
+	ring->dropped = 0;
+	CharArrayFromFormatV(record.text, MAX_MSGLEN, format, args);
+	ring->head.store(head + 1, std::memory_order_release);
+
+	if (used + 1 == LogRing::SIZE / 4)
+		m_wake.notify_one();
+}
+
+void LogManager::LoggingThread()
+{
+	Common::SetCurrentThreadName("Logging thread");
+
+	while (true)
+	{
+		const bool exit = m_exit.load();
+		Drain();
+		if (exit)
+			break;
+
+		std::unique_lock<std::mutex> lk(m_wake_lock);
+		m_wake.wait_for(lk, std::chrono::milliseconds(10), [this] { return m_exit.load(); });
+	}
+}
 
-	std::string msg = StringFromFormat("%s %s:%u %c[%s]: %s\n",
-		Common::Timer::GetTimeFormatted().c_str(),
-		file, line,
-		LogTypes::LOG_LEVEL_TO_CHAR[(int)level],
-		log->GetShortName().c_str(), temp);
+void LogManager::Drain()
+{
+	std::vector<std::shared_ptr<LogRing>> rings;
+	{
+		std::lock_guard<std::mutex> lk(m_rings_lock);
+		// Rings of threads that have exited are only referenced from here
+		m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+			[](const std::shared_ptr<LogRing>& ring) {
+				return ring.use_count() == 1 && ring->head.load() == ring->tail.load();
+			}), m_rings.end());
+		rings = m_rings;
+	}
+
+	// Merge the threads' messages back into the order they were logged in
+	std::vector<const LogRecord*> batch;
+	std::vector<u32> heads(rings.size());
+	for (size_t i = 0; i < rings.size(); ++i)
+	{
+		LogRing& ring = *rings[i];
+		heads[i] = ring.head.load(std::memory_order_acquire);
+		for (u32 pos = ring.tail.load(std::memory_order_relaxed); pos != heads[i]; ++pos)
+			batch.push_back(&ring.records[pos % LogRing::SIZE]);
+	}
+	if (batch.empty())
+		return;
+
+	std::sort(batch.begin(), batch.end(), [](const LogRecord* a, const LogRecord* b) {
+		return a->sequence < b->sequence;
+	});
+
+	BitSet32 used_listeners;
+	for (const LogRecord* record : batch)
+		Dispatch(*record, &used_listeners);
+	for (auto listener_id : used_listeners)
+		m_listeners[listener_id]->Flush();
+
+	for (size_t i = 0; i < rings.size(); ++i)
+		rings[i]->tail.store(heads[i], std::memory_order_release);
+}
+
+void LogManager::Dispatch(const LogRecord& record, BitSet32* used_listeners)
+{
+	LogContainer* log = m_Log[record.type];
+	const std::string time = FormatTime(record.time_ms);
+
+	std::string msg;
+	if (record.dropped)
+	{
+		msg = StringFromFormat("%s %c[%s]: (%u messages dropped)\n", time.c_str(),
+			LogTypes::LOG_LEVEL_TO_CHAR[(int)LogTypes::LWARNING], log->GetShortName().c_str(),
+			record.dropped);
+	}
+
+	msg += StringFromFormat("%s %s:%u %c[%s]: %s\n",
+		time.c_str(),
+		record.file, record.line,
+		LogTypes::LOG_LEVEL_TO_CHAR[(int)record.level],
+		log->GetShortName().c_str(), record.text);
 
 	for (auto listener_id : *log)
-		m_listeners[listener_id]->Log(level, msg.c_str());
+	{
+		if (!m_listeners[listener_id])
+			continue;
+		m_listeners[listener_id]->Log(record.level, msg.c_str());
+		(*used_listeners)[listener_id] = true;
+	}
 }
 
 void LogManager::Init()
@@ -165,5 +387,11 @@ void FileLogListener::Log(LogTypes::LOG_LEVELS, const char* msg)
 		return;
 
 	std::lock_guard<std::mutex> lk(m_log_lock);
-	m_logfile << msg << std::flush;
+	m_logfile << msg;
+}
+
+void FileLogListener::Flush()
+{
+	std::lock_guard<std::mutex> lk(m_log_lock);
+	m_logfile.flush();
 }
@@ -5,11 +5,16 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstdarg>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
@@ -26,6 +31,8 @@ public:
 	{}
 
 	virtual void Log(LogTypes::LOG_LEVELS, const char* msg) = 0;
+	// Called after each batch of messages
+	virtual void Flush() {}
 
 	enum LISTENER
 	{
@@ -43,6 +50,7 @@ public:
 	FileLogListener(const std::string& filename);
 
 	void Log(LogTypes::LOG_LEVELS, const char* msg) override;
+	void Flush() override;
 
 	bool IsValid() const
 	{
@@ -136,7 +144,13 @@ private:
 };
 
 class ConsoleListener;
+struct LogRecord;
+class LogRing;
 
+// Log calls only format the message text into a ring owned by the calling thread. Timestamps,
+// prefixes and the listeners are handled on a separate thread, so verbose channels don't stall
+// the emulation threads. Messages are dropped (and counted) when a thread logs faster than
+// MAX_MESSAGES_PER_SECOND or fills its ring before the logging thread catches up.
 class LogManager : NonCopyable
 {
 private:
@@ -144,9 +158,26 @@ private:
 	static LogManager* m_logManager;  // Singleton. Ugh.
 	std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners;
 
+	const u32 m_id;
+	std::mutex m_rings_lock;
+	std::vector<std::shared_ptr<LogRing>> m_rings;
+	std::atomic<u64> m_sequence;
+	std::atomic<u64> m_dropped;
+
+	std::thread m_thread;
+	std::mutex m_wake_lock;
+	std::condition_variable m_wake;
+	std::atomic<bool> m_exit;
+
 	LogManager();
 	~LogManager();
+
+	LogRing* GetRing();
+	void LoggingThread();
+	void Drain();
+	void Dispatch(const LogRecord& record, BitSet32* used_listeners);
 public:
+	static const u32 MAX_MESSAGES_PER_SECOND = 20000;
 
 	static u32 GetMaxLevel()
 	{
@@ -156,6 +187,11 @@ public:
 	void Log(LogTypes::LOG_LEVELS level, LogTypes::LOG_TYPE type,
 		const char* file, int line, const char* fmt, va_list args);
 
+	u64 GetDroppedCount() const
+	{
+		return m_dropped.load(std::memory_order_relaxed);
+	}
+
 	void SetLogLevel(LogTypes::LOG_TYPE type, LogTypes::LOG_LEVELS level)
 	{
 		m_Log[type]->SetLevel(level);
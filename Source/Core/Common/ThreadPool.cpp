@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Common/Common.h"
 #include "Common/CPUDetect.h"
 #include "Common/ThreadPool.h"
@@ -114,6 +116,61 @@ void ThreadPool::Workloop(ThreadPool &state, size_t ID)
 	}
 }
 
+namespace
+{
+struct LoopState
+{
+	std::function<void(int, int)> loop;
+	int lower;
+	int upper;
+	int slices;
+	std::atomic<int> next_slice;
+	std::atomic<int> done_slices;
+
+	void Run()
+	{
+		int i;
+		while ((i = next_slice.fetch_add(1)) < slices)
+		{
+			const int range = upper - lower;
+			loop(lower + range * i / slices, lower + range * (i + 1) / slices);
+			done_slices.fetch_add(1);
+		}
+	}
+};
+}
+
+void ThreadPool::Loop(const std::function<void(int, int)>& loop, int lower, int upper, int min_range)
+{
+	const int range = upper - lower;
+	const int max_slices = static_cast<int>(Getinstance().m_workerThreads.size()) + 1;
+	const int slices = std::min(max_slices, range / std::max(min_range, 1));
+	if (slices <= 1)
+	{
+		if (range > 0)
+			loop(lower, upper);
+		return;
+	}
+
+	auto state = std::make_shared<LoopState>();
+	state->loop = loop;
+	state->lower = lower;
+	state->upper = upper;
+	state->slices = slices;
+	state->next_slice.store(0);
+	state->done_slices.store(0);
+
+	// The workers may be asleep, so the calling thread takes slices as well. Tasks that start late
+	// find nothing left to do.
+	for (int i = 1; i < slices; i++)
+		AsyncWorker::ExecuteAsync([state] { state->Run(); });
+	state->Run();
+
+	size_t count = 0;
+	while (state->done_slices.load() < slices)
+		cYield(count++);
+}
+
 AsyncWorker& AsyncWorker::Getinstance()
 {
 	static AsyncWorker intance;
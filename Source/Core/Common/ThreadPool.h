@@ -31,6 +31,7 @@
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <vector>
 #include "Common/Thread.h"
@@ -455,6 +456,9 @@ public:
 	static void NotifyWorkPending();
 	static void RegisterWorker(IWorker* worker);
 	static void UnregisterWorker(IWorker* worker);
+	// Calls loop(l, u) for consecutive slices of [lower, upper) on the pool workers and the calling
+	// thread, and returns once all slices are done. Slices are at least min_range long.
+	static void Loop(const std::function<void(int, int)>& loop, int lower, int upper, int min_range = 16);
 };
 
 class AsyncWorker final: IWorker
@@ -0,0 +1,342 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Load generator for the traversal server.
+//
+// Simulates a number of NetPlay hosts, each with its own socket, that say hello, keep pinging and
+// connect to each other at a fixed rate. Prints the throughput and connect latency every second.
+//
+// usage: traversal_loadgen [-a address] [-p port] [-c clients] [-r connects_per_second] [-d seconds]
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+
+#include "Common/TraversalProto.h"
+
+namespace
+{
+struct Client
+{
+	int sock;
+	bool registered = false;
+	TraversalHostId hostId;
+	u64 lastHello = 0;
+	u64 lastPing = 0;
+};
+
+struct Counters
+{
+	u64 packetsSent = 0;
+	u64 packetsReceived = 0;
+	u64 hellos = 0;
+	u64 connectsStarted = 0;
+	u64 connectsReady = 0;
+	u64 connectsFailed = 0;
+	u64 latencyTotalUs = 0;
+	u64 latencyMaxUs = 0;
+};
+
+sockaddr_storage s_server;
+socklen_t s_server_len;
+std::vector<Client> s_clients;
+std::vector<size_t> s_registered;
+// Send time of every ConnectPlease that hasn't been answered yet
+std::unordered_map<TraversalRequestId, u64> s_connects;
+std::mt19937_64 s_random;
+Counters s_counters;
+}
+
+static u64 GetTime()
+{
+	timeval tv;
+	gettimeofday(&tv, nullptr);
+	return (u64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static void Send(Client& client, const TraversalPacket& packet)
+{
+	if (sendto(client.sock, &packet, sizeof(packet), 0, (sockaddr*)&s_server, s_server_len) == sizeof(packet))
+		s_counters.packetsSent++;
+}
+
+static void SendAck(Client& client, TraversalRequestId requestId, bool ok)
+{
+	TraversalPacket ack = {};
+	ack.type = TraversalPacketAck;
+	ack.requestId = requestId;
+	ack.ack.ok = ok;
+	Send(client, ack);
+}
+
+static void SendHello(Client& client, u64 now)
+{
+	TraversalPacket hello = {};
+	hello.type = TraversalPacketHelloFromClient;
+	hello.requestId = s_random();
+	hello.helloFromClient.protoVersion = TraversalProtoVersion;
+	Send(client, hello);
+	client.lastHello = now;
+}
+
+static void SendPing(Client& client, u64 now)
+{
+	TraversalPacket ping = {};
+	ping.type = TraversalPacketPing;
+	ping.requestId = s_random();
+	ping.ping.hostId = client.hostId;
+	Send(client, ping);
+	client.lastPing = now;
+}
+
+static void StartConnect(u64 now)
+{
+	if (s_registered.size() < 2)
+		return;
+
+	size_t from = s_registered[s_random() % s_registered.size()];
+	size_t to = s_registered[s_random() % s_registered.size()];
+	if (from == to)
+		return;
+
+	TraversalPacket please = {};
+	please.type = TraversalPacketConnectPlease;
+	please.requestId = s_random();
+	please.connectPlease.hostId = s_clients[to].hostId;
+	Send(s_clients[from], please);
+	s_connects[please.requestId] = now;
+	s_counters.connectsStarted++;
+}
+
+static void FinishConnect(TraversalRequestId requestId, bool ok, u64 now)
+{
+	auto it = s_connects.find(requestId);
+	if (it == s_connects.end())
+		return;
+
+	if (ok)
+	{
+		u64 latency = now - it->second;
+		s_counters.connectsReady++;
+		s_counters.latencyTotalUs += latency;
+		s_counters.latencyMaxUs = std::max(s_counters.latencyMaxUs, latency);
+	}
+	else
+	{
+		s_counters.connectsFailed++;
+	}
+	s_connects.erase(it);
+}
+
+static void HandlePacket(size_t index, const TraversalPacket& packet, u64 now)
+{
+	Client& client = s_clients[index];
+	switch (packet.type)
+	{
+	case TraversalPacketAck:
+		return;
+	case TraversalPacketHelloFromServer:
+		if (packet.helloFromServer.ok && !client.registered)
+		{
+			client.registered = true;
+			client.hostId = packet.helloFromServer.yourHostId;
+			client.lastPing = now;
+			s_registered.push_back(index);
+			s_counters.hellos++;
+		}
+		break;
+	case TraversalPacketPleaseSendPacket:
+		// a real host would punch a hole towards the address here
+		break;
+	case TraversalPacketConnectReady:
+		FinishConnect(packet.connectReady.requestId, true, now);
+		break;
+	case TraversalPacketConnectFailed:
+		FinishConnect(packet.connectFailed.requestId, false, now);
+		break;
+	default:
+		fprintf(stderr, "unexpected packet type %d\n", packet.type);
+		break;
+	}
+	// the server resends until it sees an ack, so duplicates are acked as well
+	SendAck(client, packet.requestId, true);
+}
+
+static void PrintStats(const Counters& last, double seconds)
+{
+	u64 ready = s_counters.connectsReady - last.connectsReady;
+	printf("clients %zu/%zu  out %.0f/s  in %.0f/s  connects %.0f/s ok, %llu failed, %zu pending  "
+	       "latency avg %.2f ms max %.2f ms\n",
+	       s_registered.size(), s_clients.size(),
+	       (s_counters.packetsSent - last.packetsSent) / seconds,
+	       (s_counters.packetsReceived - last.packetsReceived) / seconds, ready / seconds,
+	       (unsigned long long)(s_counters.connectsFailed - last.connectsFailed), s_connects.size(),
+	       ready ? (s_counters.latencyTotalUs - last.latencyTotalUs) / 1000.0 / ready : 0.0,
+	       s_counters.latencyMaxUs / 1000.0);
+	fflush(stdout);
+	s_counters.latencyMaxUs = 0;
+}
+
+int main(int argc, char** argv)
+{
+	const char* address = "localhost";
+	const char* port = "6262";
+	int numClients = 1000;
+	int connectRate = 1000;
+	int duration = 0;
+
+	int opt;
+	while ((opt = getopt(argc, argv, "a:p:c:r:d:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'a':
+			address = optarg;
+			break;
+		case 'p':
+			port = optarg;
+			break;
+		case 'c':
+			numClients = std::max(1, atoi(optarg));
+			break;
+		case 'r':
+			connectRate = std::max(0, atoi(optarg));
+			break;
+		case 'd':
+			duration = std::max(0, atoi(optarg));
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-a address] [-p port] [-c clients] [-r connects_per_second] "
+			                "[-d seconds (0 = forever)]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	addrinfo hints = {};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_DGRAM;
+	addrinfo* result;
+	int rv = getaddrinfo(address, port, &hints, &result);
+	if (rv != 0)
+	{
+		fprintf(stderr, "getaddrinfo: %s\n", gai_strerror(rv));
+		return 1;
+	}
+	memcpy(&s_server, result->ai_addr, result->ai_addrlen);
+	s_server_len = result->ai_addrlen;
+	const int family = result->ai_family;
+	freeaddrinfo(result);
+
+	int epollFd = epoll_create1(0);
+	if (epollFd < 0)
+	{
+		perror("epoll_create1");
+		return 1;
+	}
+
+	s_random.seed(GetTime());
+	const u64 start = GetTime();
+	s_clients.resize(numClients);
+	for (int i = 0; i < numClients; i++)
+	{
+		Client& client = s_clients[i];
+		client.sock = socket(family, SOCK_DGRAM, 0);
+		if (client.sock < 0)
+		{
+			perror("socket (raise the open file limit for more clients)");
+			return 1;
+		}
+		fcntl(client.sock, F_SETFL, fcntl(client.sock, F_GETFL) | O_NONBLOCK);
+
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.u64 = i;
+		if (epoll_ctl(epollFd, EPOLL_CTL_ADD, client.sock, &event) < 0)
+		{
+			perror("epoll_ctl");
+			return 1;
+		}
+		SendHello(client, start);
+	}
+
+	u64 lastReport = start;
+	u64 connectsDue = 0;
+	Counters last = s_counters;
+	std::vector<epoll_event> events(256);
+	while (true)
+	{
+		int count = epoll_wait(epollFd, events.data(), (int)events.size(), 1);
+		if (count < 0 && errno != EINTR)
+		{
+			perror("epoll_wait");
+			return 1;
+		}
+		u64 now = GetTime();
+
+		for (int i = 0; i < count; i++)
+		{
+			size_t index = events[i].data.u64;
+			TraversalPacket packet;
+			while (recv(s_clients[index].sock, &packet, sizeof(packet), 0) == sizeof(packet))
+			{
+				s_counters.packetsReceived++;
+				HandlePacket(index, packet, now);
+			}
+		}
+
+		for (Client& client : s_clients)
+		{
+			if (!client.registered && now - client.lastHello >= 1000000)
+				SendHello(client, now);
+			else if (client.registered && now - client.lastPing >= 1000000)
+				SendPing(client, now);
+		}
+
+		u64 wanted = (now - start) * connectRate / 1000000;
+		for (; connectsDue < wanted; connectsDue++)
+			StartConnect(now);
+
+		if (now - lastReport >= 1000000)
+		{
+			PrintStats(last, (now - lastReport) / 1000000.0);
+			last = s_counters;
+			lastReport = now;
+
+			// requests the server gave up on without telling us are counted as lost
+			for (auto it = s_connects.begin(); it != s_connects.end();)
+			{
+				if (now - it->second > 10000000)
+				{
+					s_counters.connectsFailed++;
+					it = s_connects.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		if (duration && now - start >= (u64)duration * 1000000)
+			break;
+	}
+
+	printf("total: %llu hellos, %llu connects started, %llu ready, %llu failed\n",
+	       (unsigned long long)s_counters.hellos, (unsigned long long)s_counters.connectsStarted,
+	       (unsigned long long)s_counters.connectsReady, (unsigned long long)s_counters.connectsFailed);
+	return 0;
+}
@@ -1,11 +1,25 @@
 // This file is public domain, in case it's useful to anyone. -comex
 
 // The central server implementation.
+//
+// Every worker thread owns a UDP socket bound to the same port and handles packets in batches.
+// On Linux the sockets use SO_REUSEPORT, so the kernel spreads clients over the workers, and
+// recvmmsg/sendmmsg/epoll. Hosts and outstanding requests live in tables sharded by their key,
+// so workers rarely touch the same lock.
+//
+// usage: traversal_server [-p port] [-s stats_port] [-t threads] [-v]
+// Connecting to the stats port (e.g. with curl) returns the current counters as text.
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <unistd.h>
 #include <unordered_map>
 #include <utility>
@@ -15,12 +29,39 @@
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
 #include "Common/TraversalProto.h"
 
-#define DEBUG 1
 #define NUMBER_OF_TRIES 5
+#define NUMBER_OF_SHARDS 64
+#define BATCH_SIZE 64
+// Resends and expiry are handled at this granularity
+#define TICK_US 100000
+// One slot per second, which has to cover HOST_EXPIRY_US
+#define WHEEL_SLOTS 64
+
+static const u64 HOST_EXPIRY_US = 30 * 1000000; // 30s
 
-static u64 currentTime;
+static bool verbose = false;
+static int urandomFd;
+static int numWorkers;
+
+namespace std
+{
+	template <>
+	struct hash<TraversalHostId>
+	{
+		size_t operator()(const TraversalHostId& id) const
+		{
+			auto p = (u32*) id.data();
+			return p[0] ^ ((p[1] << 13) | (p[1] >> 19));
+		}
+	};
+}
 
 struct OutgoingPacketInfo
 {
@@ -29,93 +70,101 @@ struct OutgoingPacketInfo
 	sockaddr_in6 dest;
 	int tries;
 	u64 sendTime;
+	u64 firstSendTime;
 };
 
-template <typename T>
-struct EvictEntry
+struct HostEntry
 {
+	TraversalInetAddress address;
 	u64 updateTime;
-	T value;
 };
 
-template <typename V>
-struct EvictFindResult
+struct HostShard
 {
-	bool found;
-	V* value;
+	std::mutex lock;
+	std::unordered_map<TraversalHostId, HostEntry> hosts;
+	// Timer wheel: every host is listed in the slot of the second it would expire in. Hosts that
+	// were refreshed in the meantime are moved on when their slot comes up.
+	std::array<std::vector<TraversalHostId>, WHEEL_SLOTS> wheel;
+	u64 wheelSecond = 0;
 };
 
-template <typename K, typename V>
-EvictFindResult<V> EvictFind(std::unordered_map<K, EvictEntry<V>>& map, const K& key, bool refresh = false)
+struct RequestShard
 {
-	retry:
-	const u64 expiryTime = 30 * 1000000; // 30s
-	EvictFindResult<V> result;
-	if (map.bucket_count())
-	{
-		auto bucket = map.bucket(key);
-		auto it = map.begin(bucket);
-		for (; it != map.end(bucket); ++it)
-		{
-			if (currentTime - it->second.updateTime > expiryTime)
-			{
-				map.erase(it->first);
-				goto retry;
-			}
-			if (it->first == key)
-			{
-				if (refresh)
-					it->second.updateTime = currentTime;
-				result.found = true;
-				result.value = &it->second.value;
-				return result;
-			}
-		}
-	}
-#if DEBUG
-	printf("failed to find key '");
-	for (size_t i = 0; i < sizeof(key); i++) {
-		printf("%02x", ((u8*) &key)[i]);
-	}
-	printf("'\n");
+	std::mutex lock;
+	std::unordered_map<TraversalRequestId, OutgoingPacketInfo> packets;
+};
+
+static HostShard hostShards[NUMBER_OF_SHARDS];
+static RequestShard requestShards[NUMBER_OF_SHARDS];
+
+struct Stats
+{
+	std::atomic<u64> packetsReceived{0};
+	std::atomic<u64> packetsSent{0};
+	std::atomic<u64> badPackets{0};
+	std::atomic<u64> resends{0};
+	std::atomic<u64> connectsReady{0};
+	std::atomic<u64> connectsFailed{0};
+	std::atomic<u64> acks{0};
+	std::atomic<u64> ackLatencyUs{0};
+	std::atomic<s64> activeHosts{0};
+	std::atomic<s64> pendingRequests{0};
+};
+
+static Stats stats;
+
+struct Datagram
+{
+	TraversalPacket packet;
+	sockaddr_in6 addr;
+	size_t size;
+};
+
+struct Worker
+{
+	int index;
+	int sock;
+	int statsSock = -1;
+#ifdef __linux__
+	int epollFd;
 #endif
-	result.found = false;
-	return result;
-}
+	u64 now;
+	u64 nextTick = 0;
+	std::vector<Datagram> incoming;
+	std::vector<Datagram> outgoing;
+	u8 random[8192];
+	size_t randomLeft = 0;
+	std::thread thread;
+};
 
-template <typename K, typename V>
-V* EvictSet(std::unordered_map<K, EvictEntry<V>>& map, const K& key)
+// Per second rates, only touched by the worker serving the stats socket
+struct RateSample
 {
-	// can't use a local_iterator to emplace...
-	auto& result = map[key];
-	result.updateTime = currentTime;
-	return &result.value;
-}
+	u64 time = 0;
+	u64 packetsReceived = 0;
+	u64 packetsSent = 0;
+	u64 acks = 0;
+	u64 ackLatencyUs = 0;
+	double packetsInPerSecond = 0;
+	double packetsOutPerSecond = 0;
+	double ackLatencyAvgUs = 0;
+};
 
-namespace std
+static RateSample rates;
+static u64 startTime;
+
+static u64 GetTime()
 {
-	template <>
-	struct hash<TraversalHostId>
+	timeval tv;
+	if (gettimeofday(&tv, nullptr) < 0)
 	{
-		size_t operator()(const TraversalHostId& id) const
-		{
-			auto p = (u32*) id.data();
-			return p[0] ^ ((p[1] << 13) | (p[1] >> 19));
-		}
-	};
+		perror("gettimeofday");
+		exit(1);
+	}
+	return (u64) tv.tv_sec * 1000000 + tv.tv_usec;
 }
 
-static int sock;
-static int urandomFd;
-static std::unordered_map<
-	TraversalRequestId,
-	OutgoingPacketInfo
-> outgoingPackets;
-static std::unordered_map<
-	TraversalHostId,
-	EvictEntry<TraversalInetAddress>
-> connectedClients;
-
 static TraversalInetAddress MakeInetAddress(const sockaddr_in6& addr)
 {
 	if (addr.sin6_family != AF_INET6)
@@ -164,203 +213,344 @@ static sockaddr_in6 MakeSinAddr(const TraversalInetAddress& addr)
 	return result;
 }
 
-static void GetRandomBytes(void* output, size_t size)
+static void GetRandomBytes(Worker* worker, void* output, size_t size)
 {
-	static u8 bytes[8192];
-	static size_t bytesLeft = 0;
-	if (bytesLeft < size)
+	if (worker->randomLeft < size)
 	{
-		ssize_t rv = read(urandomFd, bytes, sizeof(bytes));
-		if (rv != sizeof(bytes))
+		ssize_t rv = read(urandomFd, worker->random, sizeof(worker->random));
+		if (rv != sizeof(worker->random))
 		{
 			perror("read from /dev/urandom");
 			exit(1);
 		}
-		bytesLeft = sizeof(bytes);
+		worker->randomLeft = sizeof(worker->random);
 	}
-	memcpy(output, bytes + (bytesLeft -= size), size);
+	memcpy(output, worker->random + (worker->randomLeft -= size), size);
 }
 
-static void GetRandomHostId(TraversalHostId* hostId)
+static void GetRandomHostId(Worker* worker, TraversalHostId* hostId)
 {
 	char buf[9];
 	u32 num;
-	GetRandomBytes(&num, sizeof(num));
+	GetRandomBytes(worker, &num, sizeof(num));
 	sprintf(buf, "%08x", num);
 	memcpy(hostId->data(), buf, 8);
 }
 
-static const char* SenderName(sockaddr_in6* addr)
+static std::string SenderName(const sockaddr_in6* addr)
 {
-	static char buf[INET6_ADDRSTRLEN + 10];
+	char buf[INET6_ADDRSTRLEN + 10];
 	inet_ntop(PF_INET6, &addr->sin6_addr, buf, sizeof(buf));
 	sprintf(buf + strlen(buf), ":%d", ntohs(addr->sin6_port));
 	return buf;
 }
 
-static void TrySend(const void* buffer, size_t size, sockaddr_in6* addr)
+static HostShard& GetHostShard(const TraversalHostId& hostId)
 {
-#if DEBUG
-	printf("-> %d %llu %s\n", ((TraversalPacket*) buffer)->type,
-		   (long long)((TraversalPacket*) buffer)->requestId, SenderName(addr));
-#endif
-	if ((size_t) sendto(sock, buffer, size, 0, (sockaddr*) addr, sizeof(*addr)) != size)
-	{
-		perror("sendto");
-	}
+	return hostShards[std::hash<TraversalHostId>()(hostId) % NUMBER_OF_SHARDS];
 }
 
-static TraversalPacket* AllocPacket(const sockaddr_in6& dest, TraversalRequestId misc = 0)
+static RequestShard& GetRequestShard(TraversalRequestId requestId)
 {
-	TraversalRequestId requestId;
-	GetRandomBytes(&requestId, sizeof(requestId));
-	OutgoingPacketInfo* info = &outgoingPackets[requestId];
-	info->dest = dest;
-	info->misc = misc;
-	info->tries = 0;
-	info->sendTime = currentTime;
-	TraversalPacket* result = &info->packet;
-	memset(result, 0, sizeof(*result));
-	result->requestId = requestId;
-	return result;
+	return requestShards[requestId % NUMBER_OF_SHARDS];
 }
 
-static void SendPacket(OutgoingPacketInfo* info)
+// Has to be called with the shard locked. Expired hosts count as missing even before the wheel
+// gets to them.
+static HostEntry* FindHost(HostShard& shard, const TraversalHostId& hostId, u64 now)
 {
-	info->tries++;
-	info->sendTime = currentTime;
-	TrySend(&info->packet, sizeof(info->packet), &info->dest);
+	auto it = shard.hosts.find(hostId);
+	if (it == shard.hosts.end() || now - it->second.updateTime > HOST_EXPIRY_US)
+	{
+		if (verbose)
+			printf("failed to find key '%.8s'\n", hostId.data());
+		return nullptr;
+	}
+	return &it->second;
 }
 
-
-static void ResendPackets()
+static void ExpireHosts(HostShard& shard, u64 now)
 {
-	std::vector<std::pair<TraversalInetAddress, TraversalRequestId>> todoFailures;
-	todoFailures.clear();
-	for (auto it = outgoingPackets.begin(); it != outgoingPackets.end();)
+	std::lock_guard<std::mutex> lk(shard.lock);
+	const u64 nowSecond = now / 1000000;
+	if (shard.wheelSecond == 0 || nowSecond - shard.wheelSecond > WHEEL_SLOTS)
+		shard.wheelSecond = nowSecond - std::min<u64>(nowSecond, WHEEL_SLOTS);
+
+	for (; shard.wheelSecond < nowSecond; shard.wheelSecond++)
 	{
-		OutgoingPacketInfo* info = &it->second;
-		if (currentTime - info->sendTime >= (u64) (300000 * info->tries))
+		std::vector<TraversalHostId> due;
+		due.swap(shard.wheel[shard.wheelSecond % WHEEL_SLOTS]);
+		for (const TraversalHostId& hostId : due)
 		{
-			if (info->tries >= NUMBER_OF_TRIES)
-			{
-				if (info->packet.type == TraversalPacketPleaseSendPacket)
-				{
-					todoFailures.push_back(std::make_pair(info->packet.pleaseSendPacket.address, info->misc));
-				}
-				it = outgoingPackets.erase(it);
+			auto it = shard.hosts.find(hostId);
+			if (it == shard.hosts.end())
 				continue;
+			u64 expiry = it->second.updateTime + HOST_EXPIRY_US;
+			if (expiry <= now)
+			{
+				shard.hosts.erase(it);
+				stats.activeHosts--;
 			}
 			else
 			{
-				SendPacket(info);
+				shard.wheel[(expiry / 1000000) % WHEEL_SLOTS].push_back(hostId);
 			}
 		}
-		++it;
 	}
+}
 
-	for (const auto& p : todoFailures)
+static void QueueSend(Worker* worker, const TraversalPacket& packet, const sockaddr_in6& addr)
+{
+	if (verbose)
 	{
-		TraversalPacket* fail = AllocPacket(MakeSinAddr(p.first));
-		fail->type = TraversalPacketConnectFailed;
-		fail->connectFailed.requestId = p.second;
-		fail->connectFailed.reason = TraversalConnectFailedClientDidntRespond;
+		printf("-> %d %llu %s\n", packet.type, (long long) packet.requestId,
+			   SenderName(&addr).c_str());
 	}
+	worker->outgoing.push_back({packet, addr, sizeof(packet)});
 }
 
-static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
+static void FlushSends(Worker* worker)
 {
-#if DEBUG
-	printf("<- %d %llu %s\n", packet->type, (long long)packet->requestId, SenderName(addr));
+	size_t sent = 0;
+	while (sent < worker->outgoing.size())
+	{
+		size_t count = std::min<size_t>(worker->outgoing.size() - sent, BATCH_SIZE);
+#ifdef __linux__
+		mmsghdr msgs[BATCH_SIZE];
+		iovec iovs[BATCH_SIZE];
+		for (size_t i = 0; i < count; i++)
+		{
+			Datagram& dgram = worker->outgoing[sent + i];
+			iovs[i].iov_base = &dgram.packet;
+			iovs[i].iov_len = dgram.size;
+			memset(&msgs[i], 0, sizeof(msgs[i]));
+			msgs[i].msg_hdr.msg_name = &dgram.addr;
+			msgs[i].msg_hdr.msg_namelen = sizeof(dgram.addr);
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		int rv = sendmmsg(worker->sock, msgs, (unsigned int) count, 0);
+		if (rv <= 0)
+		{
+			if (rv < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+				perror("sendmmsg");
+			// a datagram that can't be sent is dropped, like on any other lossy hop
+			sent++;
+			continue;
+		}
+		stats.packetsSent += rv;
+		sent += rv;
+#else
+		for (size_t i = 0; i < count; i++)
+		{
+			Datagram& dgram = worker->outgoing[sent + i];
+			if ((size_t) sendto(worker->sock, &dgram.packet, dgram.size, 0, (sockaddr*) &dgram.addr,
+			                    sizeof(dgram.addr)) != dgram.size)
+				perror("sendto");
+			else
+				stats.packetsSent++;
+		}
+		sent += count;
 #endif
-	bool packetOk = true;
-	switch (packet->type)
+	}
+	worker->outgoing.clear();
+}
+
+// Sends a packet that is resent until it is acked
+static void SendReliable(Worker* worker, TraversalPacket* packet, const sockaddr_in6& dest,
+                         TraversalRequestId misc = 0)
+{
+	TraversalRequestId requestId;
+	GetRandomBytes(worker, &requestId, sizeof(requestId));
+	packet->requestId = requestId;
+
+	RequestShard& shard = GetRequestShard(requestId);
 	{
-		case TraversalPacketAck:
-			{
-			auto it = outgoingPackets.find(packet->requestId);
-			if (it == outgoingPackets.end())
-				break;
+		std::lock_guard<std::mutex> lk(shard.lock);
+		OutgoingPacketInfo* info = &shard.packets[requestId];
+		info->packet = *packet;
+		info->dest = dest;
+		info->misc = misc;
+		info->tries = 1;
+		info->sendTime = worker->now;
+		info->firstSendTime = worker->now;
+	}
+	stats.pendingRequests++;
+	QueueSend(worker, *packet, dest);
+}
 
+static void ResendPackets(Worker* worker, RequestShard& shard)
+{
+	std::vector<std::pair<TraversalInetAddress, TraversalRequestId>> todoFailures;
+	{
+		std::lock_guard<std::mutex> lk(shard.lock);
+		for (auto it = shard.packets.begin(); it != shard.packets.end();)
+		{
 			OutgoingPacketInfo* info = &it->second;
-
-			if (info->packet.type == TraversalPacketPleaseSendPacket)
+			if (worker->now - info->sendTime >= (u64) (300000 * info->tries))
 			{
-				TraversalPacket* ready = AllocPacket(MakeSinAddr(info->packet.pleaseSendPacket.address));
-				if (packet->ack.ok)
+				if (info->tries >= NUMBER_OF_TRIES)
 				{
-					ready->type = TraversalPacketConnectReady;
-					ready->connectReady.requestId = info->misc;
-					ready->connectReady.address = MakeInetAddress(info->dest);
+					if (info->packet.type == TraversalPacketPleaseSendPacket)
+					{
+						todoFailures.push_back(std::make_pair(info->packet.pleaseSendPacket.address, info->misc));
+					}
+					it = shard.packets.erase(it);
+					stats.pendingRequests--;
+					continue;
 				}
 				else
 				{
-					ready->type = TraversalPacketConnectFailed;
-					ready->connectFailed.requestId = info->misc;
-					ready->connectFailed.reason = TraversalConnectFailedClientFailure;
+					info->tries++;
+					info->sendTime = worker->now;
+					stats.resends++;
+					QueueSend(worker, info->packet, info->dest);
 				}
 			}
+			++it;
+		}
+	}
 
-		outgoingPackets.erase(it);
-		break;
+	for (const auto& p : todoFailures)
+	{
+		TraversalPacket fail = {};
+		fail.type = TraversalPacketConnectFailed;
+		fail.connectFailed.requestId = p.second;
+		fail.connectFailed.reason = TraversalConnectFailedClientDidntRespond;
+		SendReliable(worker, &fail, MakeSinAddr(p.first));
+		stats.connectsFailed++;
+	}
+}
+
+static void HandleAck(Worker* worker, TraversalPacket* packet)
+{
+	OutgoingPacketInfo info;
+	RequestShard& shard = GetRequestShard(packet->requestId);
+	{
+		std::lock_guard<std::mutex> lk(shard.lock);
+		auto it = shard.packets.find(packet->requestId);
+		if (it == shard.packets.end())
+			return;
+		info = it->second;
+		shard.packets.erase(it);
+	}
+	stats.pendingRequests--;
+	stats.acks++;
+	stats.ackLatencyUs += worker->now - info.firstSendTime;
+
+	if (info.packet.type == TraversalPacketPleaseSendPacket)
+	{
+		TraversalPacket ready = {};
+		if (packet->ack.ok)
+		{
+			ready.type = TraversalPacketConnectReady;
+			ready.connectReady.requestId = info.misc;
+			ready.connectReady.address = MakeInetAddress(info.dest);
+			stats.connectsReady++;
 		}
+		else
+		{
+			ready.type = TraversalPacketConnectFailed;
+			ready.connectFailed.requestId = info.misc;
+			ready.connectFailed.reason = TraversalConnectFailedClientFailure;
+			stats.connectsFailed++;
+		}
+		SendReliable(worker, &ready, MakeSinAddr(info.packet.pleaseSendPacket.address));
+	}
+}
+
+static void HandlePacket(Worker* worker, TraversalPacket* packet, sockaddr_in6* addr)
+{
+	if (verbose)
+		printf("<- %d %llu %s\n", packet->type, (long long) packet->requestId, SenderName(addr).c_str());
+	bool packetOk = true;
+	switch (packet->type)
+	{
+	case TraversalPacketAck:
+		HandleAck(worker, packet);
+		break;
 	case TraversalPacketPing:
 		{
-		auto r = EvictFind(connectedClients, packet->ping.hostId, true);
-		packetOk = r.found;
+		HostShard& shard = GetHostShard(packet->ping.hostId);
+		std::lock_guard<std::mutex> lk(shard.lock);
+		HostEntry* host = FindHost(shard, packet->ping.hostId, worker->now);
+		if (host)
+			host->updateTime = worker->now;
+		packetOk = host != nullptr;
 		break;
 		}
 	case TraversalPacketHelloFromClient:
 		{
 		u8 ok = packet->helloFromClient.protoVersion <= TraversalProtoVersion;
-		TraversalPacket* reply = AllocPacket(*addr);
-		reply->type = TraversalPacketHelloFromServer;
-		reply->helloFromServer.ok = ok;
+		TraversalPacket reply = {};
+		reply.type = TraversalPacketHelloFromServer;
+		reply.helloFromServer.ok = ok;
 		if (ok)
 		{
 			TraversalHostId hostId;
-			TraversalInetAddress* iaddr;
+			TraversalInetAddress iaddr = MakeInetAddress(*addr);
 			// not that there is any significant change of
 			// duplication, but...
-			GetRandomHostId(&hostId);
 			while (true)
 			{
-				auto r = EvictFind(connectedClients, hostId);
-				if (!r.found)
+				GetRandomHostId(worker, &hostId);
+				HostShard& shard = GetHostShard(hostId);
+				std::lock_guard<std::mutex> lk(shard.lock);
+				if (FindHost(shard, hostId, worker->now))
+					continue;
+
+				auto result = shard.hosts.emplace(hostId, HostEntry());
+				if (result.second)
 				{
-					iaddr = EvictSet(connectedClients, hostId);
-					break;
+					shard.wheel[((worker->now + HOST_EXPIRY_US) / 1000000) % WHEEL_SLOTS].push_back(hostId);
+					stats.activeHosts++;
 				}
+				result.first->second.address = iaddr;
+				result.first->second.updateTime = worker->now;
+				break;
 			}
 
-			*iaddr = MakeInetAddress(*addr);
-
-			reply->helloFromServer.yourAddress = *iaddr;
-			reply->helloFromServer.yourHostId = hostId;
+			reply.helloFromServer.yourAddress = iaddr;
+			reply.helloFromServer.yourHostId = hostId;
 		}
+		SendReliable(worker, &reply, *addr);
 		break;
 		}
 	case TraversalPacketConnectPlease:
 		{
 		TraversalHostId& hostId = packet->connectPlease.hostId;
-		auto r = EvictFind(connectedClients, hostId);
-		if (!r.found)
+		bool found;
+		TraversalInetAddress hostAddress;
 		{
-			TraversalPacket* reply = AllocPacket(*addr);
-			reply->type = TraversalPacketConnectFailed;
-			reply->connectFailed.requestId = packet->requestId;
-			reply->connectFailed.reason = TraversalConnectFailedNoSuchClient;
+			HostShard& shard = GetHostShard(hostId);
+			std::lock_guard<std::mutex> lk(shard.lock);
+			HostEntry* host = FindHost(shard, hostId, worker->now);
+			found = host != nullptr;
+			if (found)
+				hostAddress = host->address;
+		}
+		if (!found)
+		{
+			TraversalPacket reply = {};
+			reply.type = TraversalPacketConnectFailed;
+			reply.connectFailed.requestId = packet->requestId;
+			reply.connectFailed.reason = TraversalConnectFailedNoSuchClient;
+			SendReliable(worker, &reply, *addr);
+			stats.connectsFailed++;
 		}
 		else
 		{
-			TraversalPacket* please = AllocPacket(MakeSinAddr(*r.value), packet->requestId);
-			please->type = TraversalPacketPleaseSendPacket;
-			please->pleaseSendPacket.address = MakeInetAddress(*addr);
+			TraversalPacket please = {};
+			please.type = TraversalPacketPleaseSendPacket;
+			please.pleaseSendPacket.address = MakeInetAddress(*addr);
+			SendReliable(worker, &please, MakeSinAddr(hostAddress), packet->requestId);
 		}
 		break;
 		}
 	default:
-		fprintf(stderr, "received unknown packet type %d from %s\n", packet->type, SenderName(addr));
+		fprintf(stderr, "received unknown packet type %d from %s\n", packet->type,
+		        SenderName(addr).c_str());
+		stats.badPackets++;
 	}
 	if (packet->type != TraversalPacketAck)
 	{
@@ -368,92 +558,341 @@ static void HandlePacket(TraversalPacket* packet, sockaddr_in6* addr)
 		ack.type = TraversalPacketAck;
 		ack.requestId = packet->requestId;
 		ack.ack.ok = packetOk;
-		TrySend(&ack, sizeof(ack), addr);
+		QueueSend(worker, ack, *addr);
 	}
 }
 
-int main()
+// Returns the number of datagrams read, up to BATCH_SIZE
+static int ReceiveBatch(Worker* worker)
 {
-	int rv;
+	worker->incoming.resize(BATCH_SIZE);
+#ifdef __linux__
+	mmsghdr msgs[BATCH_SIZE];
+	iovec iovs[BATCH_SIZE];
+	for (int i = 0; i < BATCH_SIZE; i++)
+	{
+		Datagram& dgram = worker->incoming[i];
+		iovs[i].iov_base = &dgram.packet;
+		iovs[i].iov_len = sizeof(dgram.packet);
+		memset(&msgs[i], 0, sizeof(msgs[i]));
+		msgs[i].msg_hdr.msg_name = &dgram.addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(dgram.addr);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+	int rv = recvmmsg(worker->sock, msgs, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+	if (rv < 0)
+	{
+		if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			perror("recvmmsg");
+			exit(1);
+		}
+		return 0;
+	}
+	for (int i = 0; i < rv; i++)
+		worker->incoming[i].size = msgs[i].msg_len;
+	return rv;
+#else
+	int count = 0;
+	for (; count < BATCH_SIZE; count++)
+	{
+		Datagram& dgram = worker->incoming[count];
+		socklen_t addrLen = sizeof(dgram.addr);
+		ssize_t rv = recvfrom(worker->sock, &dgram.packet, sizeof(dgram.packet), MSG_DONTWAIT,
+		                      (sockaddr*) &dgram.addr, &addrLen);
+		if (rv < 0)
+		{
+			if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)
+			{
+				perror("recvfrom");
+				exit(1);
+			}
+			break;
+		}
+		dgram.size = rv;
+	}
+	return count;
+#endif
+}
 
-	urandomFd = open("/dev/urandom", O_RDONLY);
-	if (urandomFd < 0)
+static void UpdateRates(u64 now)
+{
+	if (now - rates.time < 1000000)
+		return;
+
+	double seconds = (now - rates.time) / 1000000.0;
+	u64 received = stats.packetsReceived;
+	u64 sent = stats.packetsSent;
+	u64 acks = stats.acks;
+	u64 ackLatency = stats.ackLatencyUs;
+	if (rates.time)
 	{
-		perror("open /dev/urandom");
-		return 1;
+		rates.packetsInPerSecond = (received - rates.packetsReceived) / seconds;
+		rates.packetsOutPerSecond = (sent - rates.packetsSent) / seconds;
+		rates.ackLatencyAvgUs = acks != rates.acks ?
+		                        (double) (ackLatency - rates.ackLatencyUs) / (acks - rates.acks) : 0;
+	}
+	rates.time = now;
+	rates.packetsReceived = received;
+	rates.packetsSent = sent;
+	rates.acks = acks;
+	rates.ackLatencyUs = ackLatency;
+}
+
+static void ServeStats(Worker* worker)
+{
+	int client = accept(worker->statsSock, nullptr, nullptr);
+	if (client < 0)
+		return;
+
+	// whatever request was sent doesn't matter
+	char request[1024];
+	recv(client, request, sizeof(request), MSG_DONTWAIT);
+
+	char body[1024];
+	snprintf(body, sizeof(body),
+	         "uptime_s %llu\n"
+	         "workers %d\n"
+	         "active_hosts %lld\n"
+	         "pending_requests %lld\n"
+	         "packets_in_per_s %.1f\n"
+	         "packets_out_per_s %.1f\n"
+	         "ack_latency_avg_us %.0f\n"
+	         "packets_in_total %llu\n"
+	         "packets_out_total %llu\n"
+	         "bad_packets_total %llu\n"
+	         "resends_total %llu\n"
+	         "connects_ready_total %llu\n"
+	         "connects_failed_total %llu\n",
+	         (unsigned long long) ((worker->now - startTime) / 1000000), numWorkers,
+	         (long long) stats.activeHosts.load(), (long long) stats.pendingRequests.load(),
+	         rates.packetsInPerSecond, rates.packetsOutPerSecond, rates.ackLatencyAvgUs,
+	         (unsigned long long) stats.packetsReceived.load(),
+	         (unsigned long long) stats.packetsSent.load(),
+	         (unsigned long long) stats.badPackets.load(), (unsigned long long) stats.resends.load(),
+	         (unsigned long long) stats.connectsReady.load(),
+	         (unsigned long long) stats.connectsFailed.load());
+
+	char response[1280];
+	int size = snprintf(response, sizeof(response),
+	                    "HTTP/1.0 200 OK\r\nContent-Type: text/plain\r\nContent-Length: %zu\r\n\r\n%s",
+	                    strlen(body), body);
+	if (send(client, response, size, 0) != size)
+		perror("send stats");
+	shutdown(client, SHUT_WR);
+	close(client);
+}
+
+static void Tick(Worker* worker)
+{
+	// every worker looks after its own part of the shards
+	for (int i = worker->index; i < NUMBER_OF_SHARDS; i += numWorkers)
+	{
+		ResendPackets(worker, requestShards[i]);
+		ExpireHosts(hostShards[i], worker->now);
+	}
+	if (worker->statsSock != -1)
+		UpdateRates(worker->now);
+}
+
+static void WorkerLoop(Worker* worker)
+{
+	while (true)
+	{
+		bool readable = false;
+		bool statsReadable = false;
+		int timeoutMs = TICK_US / 1000;
+#ifdef __linux__
+		epoll_event events[2];
+		int rv = epoll_wait(worker->epollFd, events, 2, timeoutMs);
+		if (rv < 0 && errno != EINTR)
+		{
+			perror("epoll_wait");
+			exit(1);
+		}
+		for (int i = 0; i < rv; i++)
+		{
+			if (events[i].data.fd == worker->sock)
+				readable = true;
+			else
+				statsReadable = true;
+		}
+#else
+		pollfd fds[2] = {{worker->sock, POLLIN, 0}, {worker->statsSock, POLLIN, 0}};
+		int rv = poll(fds, worker->statsSock != -1 ? 2 : 1, timeoutMs);
+		if (rv < 0 && errno != EINTR)
+		{
+			perror("poll");
+			exit(1);
+		}
+		readable = rv > 0 && (fds[0].revents & POLLIN);
+		statsReadable = rv > 0 && (fds[1].revents & POLLIN);
+#endif
+		worker->now = GetTime();
+
+		// don't let a flood of packets hold up resends for too long
+		for (int batch = 0; readable && batch < 16; batch++)
+		{
+			int count = ReceiveBatch(worker);
+			stats.packetsReceived += count;
+			for (int i = 0; i < count; i++)
+			{
+				Datagram& dgram = worker->incoming[i];
+				if (dgram.size < sizeof(dgram.packet))
+				{
+					fprintf(stderr, "received short packet from %s\n", SenderName(&dgram.addr).c_str());
+					stats.badPackets++;
+					continue;
+				}
+				HandlePacket(worker, &dgram.packet, &dgram.addr);
+			}
+			FlushSends(worker);
+			if (count < BATCH_SIZE)
+				break;
+		}
+
+		if (statsReadable)
+			ServeStats(worker);
+
+		if (worker->now >= worker->nextTick)
+		{
+			Tick(worker);
+			worker->nextTick = worker->now + TICK_US;
+		}
+		FlushSends(worker);
 	}
+}
 
-	sock = socket(PF_INET6, SOCK_DGRAM, 0);
+static int OpenSocket(int type, int port, bool reusePort)
+{
+	int sock = socket(PF_INET6, type, 0);
 	if (sock == -1)
 	{
 		perror("socket");
-		return 1;
+		return -1;
 	}
 	int no = 0;
-	rv = setsockopt(sock, IPPROTO_IPV6, IPV6_V6ONLY, &no, sizeof(no));
-	if (rv < 0)
+	if (setsockopt(sock, IPPROTO_IPV6, IPV6_V6ONLY, &no, sizeof(no)) < 0)
 	{
 		perror("setsockopt IPV6_V6ONLY");
-		return 1;
+		return -1;
+	}
+	int yes = 1;
+	if (reusePort && setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes)) < 0)
+	{
+		perror("setsockopt SO_REUSEPORT");
+		return -1;
 	}
+	if (type == SOCK_STREAM)
+		setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
 	in6_addr any = IN6ADDR_ANY_INIT;
 	sockaddr_in6 addr;
 #ifdef SIN6_LEN
 	addr.sin6_len = sizeof(addr);
 #endif
 	addr.sin6_family = AF_INET6;
-	addr.sin6_port = htons(6262);
+	addr.sin6_port = htons(port);
 	addr.sin6_flowinfo = 0;
 	addr.sin6_addr = any;
 	addr.sin6_scope_id = 0;
 
-	rv = bind(sock, (sockaddr*) &addr, sizeof(addr));
-	if (rv < 0)
+	if (bind(sock, (sockaddr*) &addr, sizeof(addr)) < 0)
 	{
 		perror("bind");
-		return 1;
+		return -1;
 	}
-
-	timeval tv;
-	tv.tv_sec = 0;
-	tv.tv_usec = 300000;
-	rv = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-	if (rv < 0)
+	if (type == SOCK_STREAM && listen(sock, 16) < 0)
 	{
-		perror("setsockopt SO_RCVTIMEO");
-		return 1;
+		perror("listen");
+		return -1;
 	}
+	fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) | O_NONBLOCK);
+	return sock;
+}
 
-	while (true)
+int main(int argc, char** argv)
+{
+	int port = 6262;
+	int statsPort = 6263;
+#ifdef __linux__
+	numWorkers = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int) NUMBER_OF_SHARDS));
+#else
+	// other systems don't balance SO_REUSEPORT sockets
+	numWorkers = 1;
+#endif
+
+	int opt;
+	while ((opt = getopt(argc, argv, "p:s:t:v")) != -1)
 	{
-		sockaddr_in6 raddr;
-		socklen_t addrLen = sizeof(raddr);
-		TraversalPacket packet;
-		// note: switch to recvmmsg (yes, mmsg) if this becomes
-		// expensive
-		rv = recvfrom(sock, &packet, sizeof(packet), 0, (sockaddr*) &raddr, &addrLen);
-		if (gettimeofday(&tv, nullptr) < 0)
+		switch (opt)
 		{
-			perror("gettimeofday");
-			exit(1);
+		case 'p':
+			port = atoi(optarg);
+			break;
+		case 's':
+			statsPort = atoi(optarg);
+			break;
+		case 't':
+			numWorkers = std::max(1, std::min(atoi(optarg), NUMBER_OF_SHARDS));
+			break;
+		case 'v':
+			verbose = true;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-p port] [-s stats_port (0 = off)] [-t threads] [-v]\n", argv[0]);
+			return 1;
 		}
-		currentTime = (u64) tv.tv_sec * 1000000 + tv.tv_usec;
-		if (rv < 0)
+	}
+
+	urandomFd = open("/dev/urandom", O_RDONLY);
+	if (urandomFd < 0)
+	{
+		perror("open /dev/urandom");
+		return 1;
+	}
+
+	startTime = GetTime();
+	std::vector<Worker> workers(numWorkers);
+	for (int i = 0; i < numWorkers; i++)
+	{
+		Worker& worker = workers[i];
+		worker.index = i;
+		worker.now = startTime;
+		worker.sock = OpenSocket(SOCK_DGRAM, port, numWorkers > 1);
+		if (worker.sock == -1)
+			return 1;
+		if (i == 0 && statsPort)
 		{
-			if (errno != EINTR && errno != EAGAIN)
-			{
-				perror("recvfrom");
+			worker.statsSock = OpenSocket(SOCK_STREAM, statsPort, false);
+			if (worker.statsSock == -1)
 				return 1;
-			}
 		}
-		else if ((size_t) rv < sizeof(packet))
+#ifdef __linux__
+		worker.epollFd = epoll_create1(0);
+		if (worker.epollFd < 0)
 		{
-			fprintf(stderr, "received short packet from %s\n", SenderName(&raddr));
+			perror("epoll_create1");
+			return 1;
 		}
-		else
+		for (int fd : {worker.sock, worker.statsSock})
 		{
-			HandlePacket(&packet, &raddr);
+			if (fd == -1)
+				continue;
+			epoll_event event = {};
+			event.events = EPOLLIN;
+			event.data.fd = fd;
+			if (epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+			{
+				perror("epoll_ctl");
+				return 1;
+			}
 		}
-		ResendPackets();
+#endif
 	}
+
+	for (int i = 1; i < numWorkers; i++)
+		workers[i].thread = std::thread(WorkerLoop, &workers[i]);
+	WorkerLoop(&workers[0]);
 }
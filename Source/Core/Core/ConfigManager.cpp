@@ -232,6 +232,7 @@ void SConfig::SaveCoreSettings(IniFile& ini)
 	core->Set("TimingVariance", iTimingVariance);
 	core->Set("CPUCore", iCPUCore);
 	core->Set("Fastmem", bFastmem);
+	core->Set("TextureWriteTracking", bTextureWriteTracking);
 	core->Set("CPUThread", bCPUThread);
 	core->Set("DSPHLE", bDSPHLE);
 	core->Set("SkipIdle", bSkipIdle);
@@ -510,6 +511,7 @@ void SConfig::LoadCoreSettings(IniFile& ini)
 	core->Get("CPUCore", &iCPUCore, PowerPC::CORE_INTERPRETER);
 #endif
 	core->Get("Fastmem", &bFastmem, true);
+	core->Get("TextureWriteTracking", &bTextureWriteTracking, false);
 	core->Get("DSPHLE", &bDSPHLE, true);
 	core->Get("TimingVariance", &iTimingVariance, 40);
 	core->Get("CPUThread", &bCPUThread, true);
@@ -651,6 +653,7 @@ void SConfig::LoadDefaults()
 	bRunCompareServer = false;
 	bDSPHLE = true;
 	bFastmem = true;
+	bTextureWriteTracking = false;
 	bFPRF = false;
 	bAccurateNaNs = false;
 	bMMU = false;
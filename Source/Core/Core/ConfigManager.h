@@ -81,6 +81,7 @@ struct SConfig : NonCopyable
 	bool bJITILOutputIR;
 
 	bool bFastmem;
+	bool bTextureWriteTracking;
 	bool bFPRF;
 	bool bAccurateNaNs;
 
@@ -296,9 +296,6 @@ void DoState(PointerWrap& p)
 
 static u32 ProcessDTKSamples(short* tempPCM, u32 num_samples)
 {
-	// TODO: Read audio data using the DVD thread instead of blocking on it?
-	DVDThread::WaitUntilIdle();
-
 	u32 samples_processed = 0;
 	do
 	{
@@ -325,7 +322,7 @@ static u32 ProcessDTKSamples(short* tempPCM, u32 num_samples)
 
 		u8 tempADPCM[StreamADPCM::ONE_BLOCK_SIZE];
 		// TODO: What if we can't read from s_audio_position?
-		s_inserted_volume->Read(s_audio_position, sizeof(tempADPCM), tempADPCM, false);
+		DVDThread::ReadImmediately(s_audio_position, sizeof(tempADPCM), tempADPCM, false);
 		s_audio_position += sizeof(tempADPCM);
 		StreamADPCM::DecodeBlock(tempPCM + samples_processed * 2, tempADPCM);
 		samples_processed += StreamADPCM::SAMPLES_PER_BLOCK;
@@ -0,0 +1,182 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#include "Core/HW/DVDReadAhead.h"
+
+const u32 DVDReadAhead::MIN_SIZE;
+const u32 DVDReadAhead::MAX_SIZE;
+const u32 DVDReadAhead::CHUNK_SIZE;
+
+DVDReadAhead::Sequence* DVDReadAhead::Find(u64 offset, bool decrypt)
+{
+	for (Sequence& sequence : m_sequences)
+	{
+		if (sequence.next_offset == offset && sequence.decrypt == decrypt)
+			return &sequence;
+	}
+	return nullptr;
+}
+
+u32 DVDReadAhead::Take(Sequence* sequence, u32 length, u8* buffer)
+{
+	const u32 taken = static_cast<u32>(std::min<size_t>(length, sequence->Available()));
+	std::memcpy(buffer, sequence->buffer.data() + sequence->start, taken);
+	sequence->start += taken;
+	sequence->next_offset += taken;
+	return taken;
+}
+
+bool DVDReadAhead::CallRead(const ReadFunction& read, u64 offset, u64 length, u8* buffer,
+	bool decrypt)
+{
+	const bool success = read(offset, length, buffer, decrypt);
+
+	std::lock_guard<std::mutex> lk(m_lock);
+	m_stats.disc_reads++;
+	m_stats.bytes_read += length;
+	return success;
+}
+
+bool DVDReadAhead::TryRead(u64 offset, u32 length, u8* buffer, bool decrypt)
+{
+	std::lock_guard<std::mutex> lk(m_lock);
+	Sequence* sequence = Find(offset, decrypt);
+	if (!sequence || sequence->Available() < length)
+		return false;
+
+	Take(sequence, length, buffer);
+	sequence->last_used = ++m_use_counter;
+	m_stats.hits++;
+	m_stats.bytes_requested += length;
+	return true;
+}
+
+bool DVDReadAhead::Read(u64 offset, u32 length, u8* buffer, bool decrypt, const ReadFunction& read)
+{
+	std::unique_lock<std::mutex> lk(m_lock);
+	m_stats.bytes_requested += length;
+
+	Sequence* sequence = Find(offset, decrypt);
+	if (sequence)
+	{
+		// The read continues the previous one, so the next one probably will as well
+		const u32 wanted = std::min(std::max(length * 4, MIN_SIZE), MAX_SIZE);
+		sequence->target = std::max(sequence->target, wanted);
+	}
+	else
+	{
+		// Replace the sequence that was used least recently
+		sequence = &*std::min_element(m_sequences.begin(), m_sequences.end(),
+			[](const Sequence& a, const Sequence& b) { return a.last_used < b.last_used; });
+		*sequence = Sequence();
+		sequence->decrypt = decrypt;
+		sequence->next_offset = offset;
+	}
+	sequence->last_used = ++m_use_counter;
+
+	const u32 taken = Take(sequence, length, buffer);
+	if (taken == length)
+	{
+		m_stats.hits++;
+		return true;
+	}
+	if (taken)
+		m_stats.partial_hits++;
+	else
+		m_stats.misses++;
+
+	const u64 miss_offset = offset + taken;
+	const u32 miss_length = length - taken;
+	const u32 ahead_length = sequence->at_end ? 0 : sequence->target;
+	// Nothing can continue the sequence until it has been read
+	sequence->next_offset = UINT64_MAX;
+	lk.unlock();
+
+	std::vector<u8> ahead;
+	bool success = false;
+	if (ahead_length)
+	{
+		ahead.resize(miss_length + ahead_length);
+		success = CallRead(read, miss_offset, ahead.size(), ahead.data(), decrypt);
+		if (success)
+			std::memcpy(buffer + taken, ahead.data(), miss_length);
+		else
+			ahead.clear();
+	}
+	const bool at_end = ahead_length && !success;
+	if (!success)
+		success = CallRead(read, miss_offset, miss_length, buffer + taken, decrypt);
+
+	lk.lock();
+	sequence->buffer = std::move(ahead);
+	sequence->start = sequence->buffer.empty() ? 0 : miss_length;
+	sequence->next_offset = success ? offset + length : UINT64_MAX;
+	sequence->at_end = sequence->at_end || at_end;
+	return success;
+}
+
+bool DVDReadAhead::ReadAhead(const ReadFunction& read)
+{
+	std::unique_lock<std::mutex> lk(m_lock);
+
+	// Fill up the sequence that has the least data ahead first
+	Sequence* sequence = nullptr;
+	for (Sequence& candidate : m_sequences)
+	{
+		if (candidate.CanReadAhead() && candidate.Available() < candidate.target &&
+			(!sequence || candidate.Available() < sequence->Available()))
+		{
+			sequence = &candidate;
+		}
+	}
+	if (!sequence)
+		return false;
+
+	const u64 offset = sequence->next_offset + sequence->Available();
+	const u32 length = std::min<u32>(CHUNK_SIZE, sequence->target - (u32)sequence->Available());
+	const bool decrypt = sequence->decrypt;
+	lk.unlock();
+
+	std::vector<u8> chunk(length);
+	const bool success = CallRead(read, offset, length, chunk.data(), decrypt);
+
+	lk.lock();
+	// TryRead may have used some of the data in the meantime, but it can't have moved the end
+	if (sequence->next_offset + sequence->Available() != offset)
+		return true;
+
+	if (!success)
+	{
+		sequence->at_end = true;
+		return true;
+	}
+
+	sequence->buffer.erase(sequence->buffer.begin(), sequence->buffer.begin() + sequence->start);
+	sequence->start = 0;
+	sequence->buffer.insert(sequence->buffer.end(), chunk.begin(), chunk.end());
+	return true;
+}
+
+bool DVDReadAhead::IsRunningLow() const
+{
+	std::lock_guard<std::mutex> lk(m_lock);
+	return std::any_of(m_sequences.begin(), m_sequences.end(), [](const Sequence& sequence) {
+		return sequence.CanReadAhead() && sequence.Available() < sequence.target / 2;
+	});
+}
+
+void DVDReadAhead::Clear()
+{
+	std::lock_guard<std::mutex> lk(m_lock);
+	m_sequences = {};
+}
+
+DVDReadAhead::Stats DVDReadAhead::GetStats() const
+{
+	std::lock_guard<std::mutex> lk(m_lock);
+	return m_stats;
+}
@@ -0,0 +1,81 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Keeps data from past the end of sequential disc reads, so that the next read in the sequence
+// doesn't have to wait for the blob reader. Disc data and streamed audio are tracked as separate
+// sequences. Read and ReadAhead must not run at the same time, but TryRead can run alongside them.
+class DVDReadAhead
+{
+public:
+	using ReadFunction = std::function<bool(u64 offset, u64 length, u8* buffer, bool decrypt)>;
+
+	struct Stats
+	{
+		// Reads served entirely from data that was read ahead
+		u64 hits = 0;
+		// Reads that found some of their data
+		u64 partial_hits = 0;
+		u64 misses = 0;
+		u64 bytes_requested = 0;
+		// Calls to the read function and the number of bytes they read
+		u64 disc_reads = 0;
+		u64 bytes_read = 0;
+	};
+
+	// Smallest and largest amount of data that is kept ahead of a sequence
+	static const u32 MIN_SIZE = 64 * 1024;
+	static const u32 MAX_SIZE = 2 * 1024 * 1024;
+	// Largest amount read by one call to ReadAhead
+	static const u32 CHUNK_SIZE = 256 * 1024;
+
+	// Copies the data and returns true if all of it has been read ahead
+	bool TryRead(u64 offset, u32 length, u8* buffer, bool decrypt);
+	// Reads the data, taking what has been read ahead. If the read continues a sequence, the missing
+	// part and the data ahead of it are fetched with a single call to read.
+	bool Read(u64 offset, u32 length, u8* buffer, bool decrypt, const ReadFunction& read);
+	// Reads up to one chunk more ahead of a sequence. Returns false if no sequence needs more.
+	bool ReadAhead(const ReadFunction& read);
+	// True if a sequence has used up more than half of the data that was read ahead for it
+	bool IsRunningLow() const;
+
+	void Clear();
+	Stats GetStats() const;
+
+private:
+	struct Sequence
+	{
+		bool decrypt = false;
+		// Where the next read starts if the sequence continues
+		u64 next_offset = UINT64_MAX;
+		// Data from next_offset on is in buffer, starting at start
+		std::vector<u8> buffer;
+		size_t start = 0;
+		// Amount of data to keep ahead, or 0 if the reads haven't been sequential
+		u32 target = 0;
+		// Reading further ahead failed, probably at the end of the disc
+		bool at_end = false;
+		u64 last_used = 0;
+
+		size_t Available() const { return buffer.size() - start; }
+		bool CanReadAhead() const { return target && !at_end && next_offset != UINT64_MAX; }
+	};
+
+	Sequence* Find(u64 offset, bool decrypt);
+	u32 Take(Sequence* sequence, u32 length, u8* buffer);
+	bool CallRead(const ReadFunction& read, u64 offset, u64 length, u8* buffer, bool decrypt);
+
+	mutable std::mutex m_lock;
+	std::array<Sequence, 2> m_sequences;
+	u64 m_use_counter = 0;
+	Stats m_stats;
+};
@@ -3,14 +3,13 @@
 // Refer to the license.txt file included.
 
 #include <cinttypes>
+#include <condition_variable>
 #include <mutex>
 #include <thread>
 #include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
-#include "Common/Event.h"
-#include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
@@ -19,6 +18,7 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DVDInterface.h"
+#include "Core/HW/DVDReadAhead.h"
 #include "Core/HW/DVDThread.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
@@ -33,9 +33,20 @@ static void FinishRead(u64 userdata, s64 cycles_late);
 static CoreTiming::EventType* s_finish_read;
 
 static std::thread s_dvd_thread;
-static Common::Event s_dvd_thread_start_working;
-static Common::Event s_dvd_thread_done_working;
-static Common::Flag s_dvd_thread_exiting(false);
+static std::mutex s_dvd_thread_lock;
+static std::condition_variable s_dvd_thread_wakeup;
+static std::condition_variable s_dvd_thread_done;
+static bool s_dvd_thread_exiting = false;
+// The DVD thread is working on a read, or reading ahead
+static bool s_dvd_thread_working = false;
+static bool s_read_pending = false;
+static bool s_read_ahead_pending = false;
+// The CPU thread is waiting for the DVD thread to stop, so it mustn't start reading ahead again
+static bool s_stop_requested = false;
+
+// Only the DVD thread reads from the volume while it's working. The CPU thread stops it first, see
+// ReadImmediately and AccessVolume.
+static DVDReadAhead s_read_ahead;
 
 static std::vector<u8> s_dvd_buffer;
 static u64 s_time_read_started;
@@ -54,6 +65,11 @@ static bool s_reply_to_ios;
 static u64 s_realtime_started_us;
 static u64 s_realtime_done_us;
 
+static bool ReadFromVolume(u64 offset, u64 length, u8* buffer, bool decrypt)
+{
+	return DVDInterface::GetVolume().Read(offset, length, buffer, decrypt);
+}
+
 void Start()
 {
 	s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -65,14 +81,24 @@ void Stop()
 {
 	_assert_(s_dvd_thread.joinable());
 
-	// The DVD thread will return if s_DVD_thread_exiting
-	// is set when it starts working
-	s_dvd_thread_exiting.Set();
-	s_dvd_thread_start_working.Set();
+	{
+		std::lock_guard<std::mutex> lk(s_dvd_thread_lock);
+		s_dvd_thread_exiting = true;
+	}
+	s_dvd_thread_wakeup.notify_one();
 
 	s_dvd_thread.join();
 
-	s_dvd_thread_exiting.Clear();
+	s_dvd_thread_exiting = false;
+	s_read_pending = false;
+	s_read_ahead_pending = false;
+
+	const DVDReadAhead::Stats stats = s_read_ahead.GetStats();
+	INFO_LOG(DVDINTERFACE, "Read-ahead: %" PRIu64 " hits, %" PRIu64 " partial hits, %" PRIu64
+		" misses. %" PRIu64 " bytes requested, %" PRIu64 " bytes read in %" PRIu64 " reads.",
+		stats.hits, stats.partial_hits, stats.misses, stats.bytes_requested, stats.bytes_read,
+		stats.disc_reads);
+	s_read_ahead.Clear();
 }
 
 void DoState(PointerWrap& p)
@@ -96,15 +122,68 @@ void DoState(PointerWrap& p)
 	// incorrect times to be logged once.
 }
 
-void WaitUntilIdle()
+// Waits until the DVD thread has finished the current read, and stops it from reading ahead
+static void StopWorking()
 {
 	_assert_(Core::IsCPUThread());
 
-	// Wait until DVD thread isn't working
-	s_dvd_thread_done_working.Wait();
+	std::unique_lock<std::mutex> lk(s_dvd_thread_lock);
+	s_read_ahead_pending = false;
+	s_stop_requested = true;
+	while (s_dvd_thread_working || s_read_pending)
+		s_dvd_thread_done.wait(lk);
+	s_stop_requested = false;
+}
+
+static void WaitForRead()
+{
+	std::unique_lock<std::mutex> lk(s_dvd_thread_lock);
+	while (s_read_pending)
+		s_dvd_thread_done.wait(lk);
+}
+
+void WaitUntilIdle()
+{
+	StopWorking();
+
+	// The volume may be changed after this
+	s_read_ahead.Clear();
+}
+
+static void ContinueReadingAhead()
+{
+	{
+		std::lock_guard<std::mutex> lk(s_dvd_thread_lock);
+		s_read_ahead_pending = true;
+	}
+	s_dvd_thread_wakeup.notify_one();
+}
+
+bool ReadImmediately(u64 dvd_offset, u32 length, u8* buffer, bool decrypt)
+{
+	if (s_read_ahead.TryRead(dvd_offset, length, buffer, decrypt))
+	{
+		if (s_read_ahead.IsRunningLow())
+			ContinueReadingAhead();
+		return true;
+	}
+
+	StopWorking();
+	const bool success = s_read_ahead.Read(dvd_offset, length, buffer, decrypt, ReadFromVolume);
+	ContinueReadingAhead();
+	return success;
+}
+
+void AccessVolume(const std::function<void(const DiscIO::IVolume&)>& function)
+{
+	StopWorking();
+	function(DVDInterface::GetVolume());
+	ContinueReadingAhead();
+}
 
-	// Set the event again so that we still know that the DVD thread isn't working
-	s_dvd_thread_done_working.Set();
+DVDReadAhead::Stats GetReadAheadStats()
+{
+	return s_read_ahead.GetStats();
 }
 
 void StartRead(u64 dvd_offset, u32 output_address, u32 length, bool decrypt, bool reply_to_ios,
@@ -112,7 +191,7 @@ void StartRead(u64 dvd_offset, u32 output_address, u32 length, bool decrypt, boo
 {
 	_assert_(Core::IsCPUThread());
 
-	s_dvd_thread_done_working.Wait();
+	WaitForRead();
 
 	s_dvd_offset = dvd_offset;
 	s_output_address = output_address;
@@ -123,14 +202,19 @@ void StartRead(u64 dvd_offset, u32 output_address, u32 length, bool decrypt, boo
 	s_time_read_started = CoreTiming::GetTicks();
 	s_realtime_started_us = Common::Timer::GetTimeUs();
 
-	s_dvd_thread_start_working.Set();
+	{
+		std::lock_guard<std::mutex> lk(s_dvd_thread_lock);
+		s_read_pending = true;
+	}
+	s_dvd_thread_wakeup.notify_one();
 
 	CoreTiming::ScheduleEvent(ticks_until_completion, s_finish_read);
 }
 
 static void FinishRead(u64 userdata, s64 cycles_late)
 {
-	WaitUntilIdle();
+	// Reading ahead can go on, the data it reads isn't visible to the emulated software
+	WaitForRead();
 
 	DEBUG_LOG(DVDINTERFACE, "Disc has been read. Real time: %" PRIu64 " us. "
 		"Real time including delay: %" PRIu64
@@ -159,21 +243,47 @@ static void DVDThread()
 {
 	Common::SetCurrentThreadName("DVD thread");
 
+	std::unique_lock<std::mutex> lk(s_dvd_thread_lock);
 	while (true)
 	{
-		s_dvd_thread_done_working.Set();
+		s_dvd_thread_working = false;
+		s_dvd_thread_done.notify_all();
 
-		s_dvd_thread_start_working.Wait();
+		while (!s_dvd_thread_exiting && !s_read_pending && !s_read_ahead_pending)
+			s_dvd_thread_wakeup.wait(lk);
 
-		if (s_dvd_thread_exiting.IsSet())
+		if (s_dvd_thread_exiting)
 			return;
 
-		s_dvd_buffer.resize(s_length);
-
-		s_dvd_success =
-			DVDInterface::GetVolume().Read(s_dvd_offset, s_length, s_dvd_buffer.data(), s_decrypt);
-
-		s_realtime_done_us = Common::Timer::GetTimeUs();
+		s_dvd_thread_working = true;
+		if (s_read_pending)
+		{
+			lk.unlock();
+
+			s_dvd_buffer.resize(s_length);
+
+			s_dvd_success =
+				s_read_ahead.Read(s_dvd_offset, s_length, s_dvd_buffer.data(), s_decrypt, ReadFromVolume);
+
+			s_realtime_done_us = Common::Timer::GetTimeUs();
+
+			lk.lock();
+			s_read_pending = false;
+			s_read_ahead_pending = !s_stop_requested;
+		}
+		else if (!s_stop_requested)
+		{
+			// Read ahead in chunks so that a new read doesn't have to wait long
+			lk.unlock();
+			const bool more = s_read_ahead.ReadAhead(ReadFromVolume);
+			lk.lock();
+			if (!more)
+				s_read_ahead_pending = false;
+		}
+		else
+		{
+			s_read_ahead_pending = false;
+		}
 	}
 }
 }
@@ -4,8 +4,16 @@
 
 #pragma once
 
+#include <functional>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Core/HW/DVDReadAhead.h"
+
+namespace DiscIO
+{
+class IVolume;
+}
 
 namespace DVDThread
 {
@@ -13,7 +21,17 @@ void Start();
 void Stop();
 void DoState(PointerWrap& p);
 
+// Also stops reading ahead and forgets the data, since the volume may change afterwards
 void WaitUntilIdle();
 void StartRead(u64 dvd_offset, u32 output_address, u32 length, bool decrypt, bool reply_to_ios,
 	int ticks_until_completion);
+
+// Reads on the CPU thread right away, for streamed audio. Data that was read ahead is used without
+// waiting for the DVD thread.
+bool ReadImmediately(u64 dvd_offset, u32 length, u8* buffer, bool decrypt);
+// Runs function with the volume while the DVD thread isn't using it. Reads from the CPU thread
+// that don't go through the DVD thread have to be done this way.
+void AccessVolume(const std::function<void(const DiscIO::IVolume&)>& function);
+
+DVDReadAhead::Stats GetReadAheadStats();
 }
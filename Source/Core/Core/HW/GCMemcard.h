@@ -303,6 +303,8 @@ public:
 	std::vector<u16> m_used_blocks;
 	int UsesBlock(u16 blocknum);
 	bool m_dirty;
+	// Blocks of m_save_data written since the last flush
+	std::vector<bool> m_dirty_blocks;
 	std::string m_filename;
 };
 
@@ -4,6 +4,7 @@
 
 #include <cinttypes>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -13,6 +14,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
@@ -23,6 +25,151 @@
 
 const int NO_INDEX = -1;
 static const char* MC_HDR = "MC_SYSTEM_AREA";
+static const char* MC_JOURNAL = "MC_JOURNAL";
+
+// Each journal record covers one save file and is laid out as
+//   JournalRecordHeader, file name, DEntry, changed_blocks * (u32 index, GCMBlock), u32 checksum
+// Records that are cut off or fail the checksum end the journal.
+struct JournalRecordHeader
+{
+	u32 magic;
+	u32 name_length;
+	u32 num_blocks;
+	u32 changed_blocks;
+};
+
+static const u32 JOURNAL_MAGIC = 0x4A434D47;  // "GMCJ"
+static const u64 JOURNAL_COMPACT_SIZE = 1024 * 1024;
+
+struct JournalRecord
+{
+	std::string filename;
+	DEntry header;
+	u32 num_blocks;
+	std::vector<u32> indices;
+	std::vector<GCMBlock> blocks;
+};
+
+static std::vector<u8> SerializeRecord(const JournalRecord& record)
+{
+	const size_t payload_size =
+		record.filename.size() + DENTRY_SIZE + record.indices.size() * (sizeof(u32) + BLOCK_SIZE);
+	std::vector<u8> data(sizeof(JournalRecordHeader) + payload_size + sizeof(u32));
+
+	JournalRecordHeader header = { JOURNAL_MAGIC, (u32)record.filename.size(), record.num_blocks,
+		(u32)record.indices.size() };
+	memcpy(data.data(), &header, sizeof(header));
+
+	u8* payload = data.data() + sizeof(header);
+	u8* out = payload;
+	memcpy(out, record.filename.data(), record.filename.size());
+	out += record.filename.size();
+	memcpy(out, &record.header, DENTRY_SIZE);
+	out += DENTRY_SIZE;
+	for (size_t i = 0; i < record.indices.size(); ++i)
+	{
+		memcpy(out, &record.indices[i], sizeof(u32));
+		memcpy(out + sizeof(u32), record.blocks[i].block, BLOCK_SIZE);
+		out += sizeof(u32) + BLOCK_SIZE;
+	}
+
+	const u32 checksum = HashAdler32(payload, payload_size);
+	memcpy(out, &checksum, sizeof(checksum));
+	return data;
+}
+
+struct JournaledFile
+{
+	DEntry header;
+	std::vector<GCMBlock> blocks;
+};
+
+// Merges the journal into the GCI files and deletes it. Every file is written next to the
+// original and renamed over it, so after a crash the journal can simply be applied again.
+static bool ApplyJournal(const std::string& journal_path)
+{
+	File::IOFile journal(journal_path, "rb");
+	if (!journal)
+		return true;
+
+	std::map<std::string, JournaledFile> files;
+	JournalRecordHeader header;
+	while (journal.ReadArray(&header, 1))
+	{
+		if (header.magic != JOURNAL_MAGIC || header.name_length == 0 || header.name_length > 4096 ||
+			header.num_blocks > 2043 || header.changed_blocks > header.num_blocks)
+		{
+			WARN_LOG(EXPANSIONINTERFACE, "Memcard journal %s ends in an invalid record",
+				journal_path.c_str());
+			break;
+		}
+
+		const size_t payload_size = header.name_length + DENTRY_SIZE +
+			header.changed_blocks * (sizeof(u32) + BLOCK_SIZE);
+		std::vector<u8> payload(payload_size);
+		u32 checksum;
+		if (!journal.ReadBytes(payload.data(), payload_size) || !journal.ReadArray(&checksum, 1) ||
+			checksum != HashAdler32(payload.data(), payload_size))
+		{
+			WARN_LOG(EXPANSIONINTERFACE, "Memcard journal %s ends in an incomplete record",
+				journal_path.c_str());
+			break;
+		}
+
+		const u8* in = payload.data();
+		const std::string filename((const char*)in, header.name_length);
+		in += header.name_length;
+
+		auto it = files.find(filename);
+		if (it == files.end())
+		{
+			it = files.emplace(filename, JournaledFile()).first;
+			File::IOFile gci(filename, "rb");
+			if (gci && gci.ReadBytes(&it->second.header, DENTRY_SIZE))
+			{
+				it->second.blocks.resize(BE16(it->second.header.BlockCount));
+				if (!gci.ReadBytes(it->second.blocks.data(), it->second.blocks.size() * BLOCK_SIZE))
+					it->second.blocks.clear();
+			}
+		}
+
+		JournaledFile& file = it->second;
+		memcpy(&file.header, in, DENTRY_SIZE);
+		in += DENTRY_SIZE;
+		file.blocks.resize(header.num_blocks);
+		for (u32 i = 0; i < header.changed_blocks; ++i)
+		{
+			u32 index;
+			memcpy(&index, in, sizeof(u32));
+			if (index < header.num_blocks)
+				memcpy(file.blocks[index].block, in + sizeof(u32), BLOCK_SIZE);
+			in += sizeof(u32) + BLOCK_SIZE;
+		}
+	}
+	journal.Close();
+
+	bool success = true;
+	for (const auto& file : files)
+	{
+		const std::string temp_path = file.first + ".tmp";
+		bool written;
+		{
+			File::IOFile gci(temp_path, "wb");
+			gci.WriteBytes(&file.second.header, DENTRY_SIZE);
+			gci.WriteBytes(file.second.blocks.data(), file.second.blocks.size() * BLOCK_SIZE);
+			written = gci.IsGood();
+		}
+		if (!written || !File::RenameSync(temp_path, file.first))
+		{
+			ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s", file.first.c_str());
+			success = false;
+		}
+	}
+
+	if (success)
+		File::Delete(journal_path);
+	return success;
+}
 
 int GCMemcardDirectory::LoadGCI(const std::string& fileName, DiscIO::Country card_region,
 	bool currentGameOnly)
@@ -147,9 +294,14 @@ int GCMemcardDirectory::LoadGCI(const std::string& fileName, DiscIO::Country car
 
 GCMemcardDirectory::GCMemcardDirectory(const std::string& directory, int slot, u16 sizeMb,
 	bool ascii, DiscIO::Country card_region, int gameId)
-	: MemoryCardBase(slot, sizeMb), m_GameId(gameId), m_LastBlock(-1), m_hdr(slot, sizeMb, ascii),
-	m_bat1(sizeMb), m_saves(0), m_SaveDirectory(directory), m_exiting(false)
+	: MemoryCardBase(slot, sizeMb), m_GameId(gameId), m_LastBlock(-1), m_LastBlockDirty(false),
+	m_hdr(slot, sizeMb, ascii), m_bat1(sizeMb), m_saves(0), m_SaveDirectory(directory),
+	m_exiting(false)
 {
+	// Finish writing out the changes of the last session if it didn't shut down cleanly
+	if (!ApplyJournal(m_SaveDirectory + MC_JOURNAL))
+		PanicAlertT("Failed to apply the memory card journal in\n%s", m_SaveDirectory.c_str());
+
 	// Use existing header data if available
 	if (File::Exists(m_SaveDirectory + MC_HDR))
 	{
@@ -229,6 +381,7 @@ GCMemcardDirectory::~GCMemcardDirectory()
 	m_flush_thread.join();
 
 	FlushToFile();
+	CompactJournal();
 }
 
 s32 GCMemcardDirectory::Read(u32 address, s32 length, u8* destaddress)
@@ -297,6 +450,10 @@ s32 GCMemcardDirectory::Write(u32 destaddress, s32 length, u8* srcaddress)
 	u32 offset = destaddress % BLOCK_SIZE;
 	s32 extra = 0;  // used for write calls that are across multiple blocks
 
+	// A block cached by Read or before the last flush still has to be marked dirty
+	if (block >= MC_FST_BLOCKS && !m_LastBlockDirty)
+		m_LastBlock = -1;
+
 	if (offset + length > BLOCK_SIZE)
 	{
 		extra = length + offset - BLOCK_SIZE;
@@ -436,7 +593,13 @@ inline void GCMemcardDirectory::SyncSaves()
 				{
 					INFO_LOG(EXPANSIONINTERFACE, "Save moved from 0x%x to 0x%x", old_start, new_start);
 					m_saves[i].m_used_blocks.clear();
-					m_saves[i].m_save_data.clear();
+					// The save data is in file order, so it doesn't have to be reloaded. The GCI file on
+					// disk may not have the latest journaled blocks yet anyway.
+					if (!m_saves[i].m_save_data.empty())
+					{
+						m_saves[i].m_save_data.resize(BE16(current->Dir[i].BlockCount));
+						m_saves[i].m_dirty_blocks.assign(m_saves[i].m_save_data.size(), true);
+					}
 				}
 				if (m_saves[i].m_used_blocks.size() == 0)
 				{
@@ -450,6 +613,7 @@ inline void GCMemcardDirectory::SyncSaves()
 				BE32(m_saves[i].m_gci_header.Gamecode));
 			*(u32*)&(m_saves[i].m_gci_header.Gamecode) = 0xFFFFFFFF;
 			m_saves[i].m_save_data.clear();
+			m_saves[i].m_dirty_blocks.clear();
 			m_saves[i].m_used_blocks.clear();
 			m_saves[i].m_dirty = true;
 		}
@@ -482,9 +646,12 @@ inline s32 GCMemcardDirectory::SaveAreaRW(u32 block, bool writing)
 				if (writing)
 				{
 					m_saves[i].m_dirty = true;
+					m_saves[i].m_dirty_blocks.resize(m_saves[i].m_save_data.size());
+					m_saves[i].m_dirty_blocks[idx] = true;
 				}
 
 				m_LastBlock = block;
+				m_LastBlockDirty = writing;
 				m_LastBlockAddress = m_saves[i].m_save_data[idx].block;
 				return m_LastBlock;
 			}
@@ -547,19 +714,24 @@ bool GCMemcardDirectory::SetUsedBlocks(int saveIndex)
 	return true;
 }
 
+// Only the changed blocks are copied out while holding m_write_mutex, so the CPU thread isn't
+// held up by disk writes. They are then appended to the journal.
 void GCMemcardDirectory::FlushToFile()
 {
+	std::vector<JournalRecord> records;
+	std::vector<std::string> deleted_files;
+	std::vector<u16> unload;
+
 	std::unique_lock<std::mutex> l(m_write_mutex);
-	int errors = 0;
-	DEntry invalid;
 	for (u16 i = 0; i < m_saves.size(); ++i)
 	{
-		if (m_saves[i].m_dirty)
+		GCIFile& save = m_saves[i];
+		if (save.m_dirty)
 		{
-			if (BE32(m_saves[i].m_gci_header.Gamecode) != 0xFFFFFFFF)
+			if (BE32(save.m_gci_header.Gamecode) != 0xFFFFFFFF)
 			{
-				m_saves[i].m_dirty = false;
-				if (m_saves[i].m_save_data.size() == 0)
+				save.m_dirty = false;
+				if (save.m_save_data.size() == 0)
 				{
 					// The save's header has been changed but the actual save blocks haven't been read/written
 					// to
@@ -568,9 +740,10 @@ void GCMemcardDirectory::FlushToFile()
 						"GCI header modified without corresponding save data changes");
 					continue;
 				}
-				if (m_saves[i].m_filename.empty())
+				bool new_file = false;
+				if (save.m_filename.empty())
 				{
-					std::string defaultSaveName = m_SaveDirectory + m_saves[i].m_gci_header.GCI_FileName();
+					std::string defaultSaveName = m_SaveDirectory + save.m_gci_header.GCI_FileName();
 
 					// Check to see if another file is using the same name
 					// This seems unlikely except in the case of file corruption
@@ -582,41 +755,34 @@ void GCMemcardDirectory::FlushToFile()
 					if (File::Exists(defaultSaveName))
 						PanicAlertT("Failed to find new filename.\n%s\n will be overwritten",
 							defaultSaveName.c_str());
-					m_saves[i].m_filename = defaultSaveName;
+					save.m_filename = defaultSaveName;
+					new_file = true;
 				}
-				File::IOFile GCI(m_saves[i].m_filename, "wb");
-				if (GCI)
-				{
-					GCI.WriteBytes(&m_saves[i].m_gci_header, DENTRY_SIZE);
-					GCI.WriteBytes(m_saves[i].m_save_data.data(), BLOCK_SIZE * m_saves[i].m_save_data.size());
 
-					if (GCI.IsGood())
-					{
-						Core::DisplayMessage(
-							StringFromFormat("Wrote save contents to %s", m_saves[i].m_filename.c_str()), 4000);
-					}
-					else
+				JournalRecord record;
+				record.filename = save.m_filename;
+				record.header = save.m_gci_header;
+				record.num_blocks = (u32)save.m_save_data.size();
+				save.m_dirty_blocks.resize(save.m_save_data.size());
+				for (u32 b = 0; b < save.m_save_data.size(); ++b)
+				{
+					if (new_file || save.m_dirty_blocks[b])
 					{
-						++errors;
-						Core::DisplayMessage(StringFromFormat("Failed to write save contents to %s",
-							m_saves[i].m_filename.c_str()),
-							4000);
-						ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s",
-							m_saves[i].m_filename.c_str());
+						record.indices.push_back(b);
+						record.blocks.push_back(save.m_save_data[b]);
 					}
 				}
+				save.m_dirty_blocks.assign(save.m_save_data.size(), false);
+				records.push_back(std::move(record));
 			}
-			else if (m_saves[i].m_filename.length() != 0)
+			else if (save.m_filename.length() != 0)
 			{
-				m_saves[i].m_dirty = false;
-				std::string& oldname = m_saves[i].m_filename;
-				std::string deletedname = oldname + ".deleted";
-				if (File::Exists(deletedname))
-					File::Delete(deletedname);
-				File::Rename(oldname, deletedname);
-				m_saves[i].m_filename.clear();
-				m_saves[i].m_save_data.clear();
-				m_saves[i].m_used_blocks.clear();
+				save.m_dirty = false;
+				deleted_files.push_back(save.m_filename);
+				save.m_filename.clear();
+				save.m_save_data.clear();
+				save.m_dirty_blocks.clear();
+				save.m_used_blocks.clear();
 			}
 		}
 
@@ -625,12 +791,69 @@ void GCMemcardDirectory::FlushToFile()
 		// simultaneously
 		// this ensures that the save data for all of the current games gci files are stored in the
 		// savestate
-		u32 gamecode = BE32(m_saves[i].m_gci_header.Gamecode);
-		if (gamecode != m_GameId && gamecode != 0xFFFFFFFF && m_saves[i].m_save_data.size())
+		u32 gamecode = BE32(save.m_gci_header.Gamecode);
+		if (gamecode != m_GameId && gamecode != 0xFFFFFFFF && save.m_save_data.size())
+			unload.push_back(i);
+	}
+	// Blocks written after this have to be marked dirty again
+	m_LastBlock = -1;
+	l.unlock();
+
+	bool compact = false;
+	if (!records.empty())
+	{
+		if (!m_journal.IsOpen())
+			m_journal.Open(m_SaveDirectory + MC_JOURNAL, "ab");
+
+		for (const JournalRecord& record : records)
 		{
-			INFO_LOG(EXPANSIONINTERFACE, "Flushing savedata to disk for %s",
-				m_saves[i].m_filename.c_str());
-			m_saves[i].m_save_data.clear();
+			const std::vector<u8> data = SerializeRecord(record);
+			if (m_journal.WriteBytes(data.data(), data.size()))
+			{
+				m_journal_size += data.size();
+				Core::DisplayMessage(
+					StringFromFormat("Wrote save contents to %s", record.filename.c_str()), 4000);
+			}
+			else
+			{
+				Core::DisplayMessage(
+					StringFromFormat("Failed to write save contents to %s", record.filename.c_str()), 4000);
+				ERROR_LOG(EXPANSIONINTERFACE, "Failed to save data to %s", record.filename.c_str());
+				// Don't append anything after a partial record
+				compact = true;
+				break;
+			}
+		}
+		m_journal.Flush();
+	}
+
+	// The GCI files have to be complete before save data is dropped or a file is renamed
+	if (m_journal_size >= JOURNAL_COMPACT_SIZE || !deleted_files.empty() || !unload.empty())
+		compact = true;
+	if (compact && m_journal_size)
+		CompactJournal();
+
+	for (const std::string& filename : deleted_files)
+	{
+		std::string deletedname = filename + ".deleted";
+		if (File::Exists(deletedname))
+			File::Delete(deletedname);
+		File::Rename(filename, deletedname);
+	}
+
+	if (!unload.empty())
+	{
+		l.lock();
+		for (u16 i : unload)
+		{
+			GCIFile& save = m_saves[i];
+			u32 gamecode = BE32(save.m_gci_header.Gamecode);
+			if (!save.m_dirty && gamecode != m_GameId && gamecode != 0xFFFFFFFF)
+			{
+				INFO_LOG(EXPANSIONINTERFACE, "Flushing savedata to disk for %s", save.m_filename.c_str());
+				save.m_save_data.clear();
+				save.m_dirty_blocks.clear();
+			}
 		}
 	}
 #if _WRITE_MC_HEADER
@@ -641,6 +864,13 @@ void GCMemcardDirectory::FlushToFile()
 #endif
 }
 
+bool GCMemcardDirectory::CompactJournal()
+{
+	m_journal.Close();
+	m_journal_size = 0;
+	return ApplyJournal(m_SaveDirectory + MC_JOURNAL);
+}
+
 void GCMemcardDirectory::DoState(PointerWrap& p)
 {
 	std::unique_lock<std::mutex> l(m_write_mutex);
@@ -658,6 +888,8 @@ void GCMemcardDirectory::DoState(PointerWrap& p)
 	for (auto itr = m_saves.begin(); itr != m_saves.end(); ++itr)
 	{
 		itr->DoState(p);
+		if (p.GetMode() == PointerWrap::MODE_READ)
+			itr->m_dirty_blocks.assign(itr->m_save_data.size(), itr->m_dirty);
 	}
 }
 
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "Common/Event.h"
+#include "Common/FileUtil.h"
 #include "Common/NonCopyable.h"
 #include "Core/HW/GCMemcard.h"
 #include "DiscIO/Enums.h"
@@ -41,10 +42,13 @@ private:
 	s32 DirectoryWrite(u32 destaddress, u32 length, u8* srcaddress);
 	inline void SyncSaves();
 	bool SetUsedBlocks(int saveIndex);
+	bool CompactJournal();
 
 	u32 m_GameId;
 	s32 m_LastBlock;
 	u8* m_LastBlockAddress;
+	// Whether m_LastBlock is a save block that has been marked dirty
+	bool m_LastBlockDirty;
 
 	Header m_hdr;
 	Directory m_dir1, m_dir2;
@@ -58,4 +62,9 @@ private:
 	std::mutex m_write_mutex;
 	Common::Flag m_exiting;
 	std::thread m_flush_thread;
+
+	// Changed blocks are appended here and only merged into the GCI files once it grows large.
+	// Only used by the flush thread.
+	File::IOFile m_journal;
+	u64 m_journal_size = 0;
 };
@@ -7,6 +7,7 @@
 #include "Common/ChunkFile.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Core/HW/GPFifo.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/ProcessorInterface.h"
@@ -54,6 +55,22 @@ void ResetGatherPipe()
 	m_gatherPipeCount = 0;
 }
 
+// The FIFO is consumed by the GPU thread, not by the CPU, so don't pull it into our cache
+static void CopyBurst(u8* dst, const u8* src)
+{
+#ifdef _M_X86
+	if (!((uintptr_t)dst & 15))
+	{
+		for (u32 i = 0; i < GATHER_PIPE_SIZE; i += 16)
+			_mm_stream_si128((__m128i*)(dst + i), _mm_load_si128((const __m128i*)(src + i)));
+		// Make the burst visible before the GPU side is told about it
+		_mm_sfence();
+		return;
+	}
+#endif
+	memcpy(dst, src, GATHER_PIPE_SIZE);
+}
+
 static void UpdateGatherPipe()
 {
 	u32 cnt;
@@ -61,7 +78,7 @@ static void UpdateGatherPipe()
 	for (cnt = 0; m_gatherPipeCount >= GATHER_PIPE_SIZE; cnt += GATHER_PIPE_SIZE)
 	{
 		// copy the GatherPipe
-		memcpy(curMem, m_gatherPipe + cnt, GATHER_PIPE_SIZE);
+		CopyBurst(curMem, m_gatherPipe + cnt);
 		m_gatherPipeCount -= GATHER_PIPE_SIZE;
 
 		// increase the CPUWritePointer
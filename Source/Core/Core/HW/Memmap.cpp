@@ -57,9 +57,18 @@ u8* m_pL1Cache;
 u8* m_pEXRAM;
 u8* m_pFakeVMEM;
 
+bool bWriteTracking = false;
+std::atomic<u8> written_pages[WRITE_TRACKING_NUM_PAGES];
+
 // MMIO mapping object.
 std::unique_ptr<MMIO::Mapping> mmio_mapping;
 
+static void MarkAllWritten()
+{
+	for (std::atomic<u8>& page : written_pages)
+		page.store(1, std::memory_order_relaxed);
+}
+
 static std::unique_ptr<MMIO::Mapping> InitMMIO()
 {
 	auto mmio = std::make_unique<MMIO::Mapping>();
@@ -176,6 +185,13 @@ void Init()
 	bFakeVMEM = !wii && !bMMU;
 #endif
 
+	// Fast stores only record the page they hit when the CPU core emits the tracking code, and
+	// pages are tracked by effective address, which is only the physical one without the MMU.
+	const int cpu_core = SConfig::GetInstance().iCPUCore;
+	bWriteTracking = SConfig::GetInstance().bTextureWriteTracking && !bMMU &&
+		(cpu_core == PowerPC::CORE_INTERPRETER || cpu_core == PowerPC::CORE_JIT64 ||
+			cpu_core == PowerPC::CORE_CACHEDINTERPRETER);
+
 	u32 flags = 0;
 	if (wii)
 		flags |= PhysicalMemoryRegion::WII_ONLY;
@@ -275,6 +291,9 @@ void DoState(PointerWrap& p)
 	if (wii)
 		p.DoArray(m_pEXRAM, EXRAM_SIZE);
 	p.DoMarker("Memory EXRAM");
+
+	if (p.GetMode() == PointerWrap::MODE_READ)
+		MarkAllWritten();
 }
 
 void Shutdown()
@@ -314,6 +333,7 @@ void Clear()
 		memset(m_pFakeVMEM, 0, FAKEVMEM_SIZE);
 	if (m_pEXRAM)
 		memset(m_pEXRAM, 0, EXRAM_SIZE);
+	MarkAllWritten();
 }
 
 static inline u8* GetPointerForRange(u32 address, size_t size)
@@ -356,6 +376,7 @@ void CopyToEmu(u32 address, const void* data, size_t size)
 		return;
 	}
 	memcpy(pointer, data, size);
+	MarkWritten(address, size);
 }
 
 void Memset(u32 address, u8 value, size_t size)
@@ -370,6 +391,7 @@ void Memset(u32 address, u8 value, size_t size)
 		return;
 	}
 	memset(pointer, value, size);
+	MarkWritten(address, size);
 }
 
 std::string GetString(u32 em_address, size_t size)
@@ -431,34 +453,40 @@ u64 Read_U64(u32 address)
 void Write_U8(u8 value, u32 address)
 {
 	*GetPointer(address) = value;
+	MarkWritten(address, sizeof(u8));
 }
 
 void Write_U16(u16 value, u32 address)
 {
 	u16 swapped_value = Common::swap16(value);
 	std::memcpy(GetPointer(address), &swapped_value, sizeof(u16));
+	MarkWritten(address, sizeof(u16));
 }
 
 void Write_U32(u32 value, u32 address)
 {
 	u32 swapped_value = Common::swap32(value);
 	std::memcpy(GetPointer(address), &swapped_value, sizeof(u32));
+	MarkWritten(address, sizeof(u32));
 }
 
 void Write_U64(u64 value, u32 address)
 {
 	u64 swapped_value = Common::swap64(value);
 	std::memcpy(GetPointer(address), &swapped_value, sizeof(u64));
+	MarkWritten(address, sizeof(u64));
 }
 
 void Write_U32_Swap(u32 value, u32 address)
 {
 	std::memcpy(GetPointer(address), &value, sizeof(u32));
+	MarkWritten(address, sizeof(u32));
 }
 
 void Write_U64_Swap(u64 value, u32 address)
 {
 	std::memcpy(GetPointer(address), &value, sizeof(u64));
+	MarkWritten(address, sizeof(u64));
 }
 
 }  // namespace
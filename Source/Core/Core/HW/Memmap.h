@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -58,6 +59,36 @@ enum
 // MMIO mapping object.
 extern std::unique_ptr<MMIO::Mapping> mmio_mapping;
 
+// Write tracking for the texture cache, enabled by the TextureWriteTracking hack.
+// Holds one byte per page of the physical address space (mirrors folded), set whenever the CPU
+// or a DMA writes to the page. Only the texture cache clears them. Writes through raw
+// GetPointer() accesses are not seen. The JIT sets them with plain byte stores from the CPU
+// thread while the GPU thread takes them, so they are atomic.
+enum
+{
+	WRITE_TRACKING_PAGE_SHIFT = 12,
+	WRITE_TRACKING_ADDRESS_MASK = 0x1FFFFFFF,
+	WRITE_TRACKING_NUM_PAGES = (WRITE_TRACKING_ADDRESS_MASK + 1) >> WRITE_TRACKING_PAGE_SHIFT,
+};
+extern bool bWriteTracking;
+extern std::atomic<u8> written_pages[WRITE_TRACKING_NUM_PAGES];
+static_assert(sizeof(std::atomic<u8>) == 1, "The JIT marks pages with byte stores");
+
+inline void MarkWritten(u32 address, size_t size)
+{
+	if (!bWriteTracking || size == 0)
+		return;
+
+	u32 page = (address & WRITE_TRACKING_ADDRESS_MASK) >> WRITE_TRACKING_PAGE_SHIFT;
+	u32 last = ((address + u32(size) - 1) & WRITE_TRACKING_ADDRESS_MASK) >> WRITE_TRACKING_PAGE_SHIFT;
+	for (;; page = (page + 1) % WRITE_TRACKING_NUM_PAGES)
+	{
+		written_pages[page].store(1, std::memory_order_relaxed);
+		if (page == last)
+			break;
+	}
+}
+
 // Init and Shutdown
 bool IsInitialized();
 void Init();
@@ -109,5 +140,7 @@ void CopyToEmuSwapped(u32 address, const T* data, size_t size)
 
 	for (size_t i = 0; i < size / sizeof(T); i++)
 		dest[i] = Common::FromBigEndian(data[i]);
+
+	MarkWritten(address, size);
 }
 }
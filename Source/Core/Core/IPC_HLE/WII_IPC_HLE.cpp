@@ -54,6 +54,7 @@ They will also generate a true or false return for UpdateInterrupts() in WII_IPC
 #include "Core/IPC_HLE/WII_IPC_HLE_WiiSpeak.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_usb_kbd.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_usb_ven.h"
+#include "Core/IPC_HLE/WII_IPC_HLE_FSThreads.h"
 
 #if defined(__LIBUSB__) || defined(_WIN32)
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_hid.h"
@@ -97,6 +98,10 @@ static void EnqueueEvent(u64 userdata, s64 cycles_late = 0)
 	}
 	else
 	{
+		// The host I/O for the command may still be running
+		s32 result;
+		if (FSThreads::WaitForResult((u32)userdata, &result))
+			Memory::Write_U32(result, (u32)userdata + 4);
 		reply_queue.push_back((u32)userdata);
 	}
 	Update();
@@ -170,6 +175,7 @@ void Reinit()
 void Init()
 {
 	Reinit();
+	FSThreads::Start();
 
 	event_enqueue = CoreTiming::RegisterEvent("IPCEvent", EnqueueEvent);
 	event_sdio_notify = CoreTiming::RegisterEvent("SDIO_EventNotify", SDIO_EventNotify_CPUThread);
@@ -178,6 +184,7 @@ void Init()
 void Reset(bool _bHard)
 {
 	CoreTiming::RemoveAllEvents(event_enqueue);
+	FSThreads::Reset();
 
 	for (auto& dev : g_FdMap)
 	{
@@ -217,6 +224,7 @@ void Reset(bool _bHard)
 void Shutdown()
 {
 	Reset(true);
+	FSThreads::Stop();
 }
 
 void SetDefaultContentFile(const std::string& _rFilename)
@@ -292,6 +300,7 @@ void DoState(PointerWrap& p)
 	p.Do(request_queue);
 	p.Do(reply_queue);
 	p.Do(last_reply_time);
+	FSThreads::DoState(p);
 
 	// We need to make sure all file handles are closed so WII_IPC_Devices_fs::DoState can
 	// successfully save or re-create /tmp
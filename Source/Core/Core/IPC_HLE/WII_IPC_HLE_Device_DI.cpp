@@ -11,6 +11,7 @@
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DVDInterface.h"
+#include "Core/HW/DVDThread.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IPC_HLE/WII_IPC_HLE.h"
@@ -150,7 +151,9 @@ IPCCommandResult CWII_IPC_HLE_Device_di::IOCtlV(u32 _CommandAddress)
 		INFO_LOG(WII_IPC_DVD, "DVDLowOpenPartition: partition_offset 0x%016" PRIx64, partition_offset);
 
 		// Read TMD to the buffer
-		std::vector<u8> tmd_buffer = DVDInterface::GetVolume().GetTMD();
+		std::vector<u8> tmd_buffer;
+		DVDThread::AccessVolume(
+			[&tmd_buffer](const DiscIO::IVolume& volume) { tmd_buffer = volume.GetTMD(); });
 		Memory::CopyToEmu(CommandBuffer.PayloadBuffer[0].m_Address, tmd_buffer.data(),
 			tmd_buffer.size());
 		WII_IPC_HLE_Interface::ES_DIVerify(tmd_buffer);
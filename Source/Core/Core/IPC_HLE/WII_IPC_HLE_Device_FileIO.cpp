@@ -12,9 +12,11 @@
 #include "Common/StringUtil.h"
 
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/IPC_HLE/WII_IPC_HLE.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_FileIO.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_fs.h"
+#include "Core/IPC_HLE/WII_IPC_HLE_FSThreads.h"
 
 static Common::replace_v replacements;
 
@@ -90,6 +92,9 @@ IPCCommandResult CWII_IPC_HLE_Device_FileIO::Close(u32 _CommandAddress, bool _bF
 	INFO_LOG(WII_IPC_FILEIO, "FileIO: Close %s (DeviceID=%08x)", m_Name.c_str(), m_DeviceID);
 	m_Mode = 0;
 
+	// Commands for this handle may still be using the file
+	FSThreads::WaitUntilIdle();
+
 	// Let go of our pointer to the file, it will automatically close if we are the last handle
 	// accessing it.
 	m_file.reset();
@@ -103,6 +108,9 @@ IPCCommandResult CWII_IPC_HLE_Device_FileIO::Close(u32 _CommandAddress, bool _bF
 
 IPCCommandResult CWII_IPC_HLE_Device_FileIO::Open(u32 _CommandAddress, u32 _Mode)
 {
+	// Earlier commands may still be creating, renaming or deleting the file
+	FSThreads::WaitUntilIdle();
+
 	m_Mode = _Mode;
 	u32 ReturnValue = 0;
 
@@ -177,10 +185,18 @@ void CWII_IPC_HLE_Device_FileIO::OpenFile()
 
 IPCCommandResult CWII_IPC_HLE_Device_FileIO::Seek(u32 _CommandAddress)
 {
-	u32 ReturnValue = FS_RESULT_FATAL;
 	const s32 SeekPosition = Memory::Read_U32(_CommandAddress + 0xC);
 	const s32 Mode = Memory::Read_U32(_CommandAddress + 0x10);
 
+	FSThreads::Post(_CommandAddress, m_Name,
+		[this, SeekPosition, Mode] { return SeekFile(SeekPosition, Mode); });
+	return GetDefaultReply();
+}
+
+s32 CWII_IPC_HLE_Device_FileIO::SeekFile(s32 SeekPosition, s32 Mode)
+{
+	u32 ReturnValue = FS_RESULT_FATAL;
+
 	if (m_file->IsOpen())
 	{
 		ReturnValue = FS_RESULT_FATAL;
@@ -235,17 +251,24 @@ IPCCommandResult CWII_IPC_HLE_Device_FileIO::Seek(u32 _CommandAddress)
 	{
 		ReturnValue = FS_FILE_NOT_EXIST;
 	}
-	Memory::Write_U32(ReturnValue, _CommandAddress + 0x4);
 
-	return GetDefaultReply();
+	return ReturnValue;
 }
 
 IPCCommandResult CWII_IPC_HLE_Device_FileIO::Read(u32 _CommandAddress)
 {
-	u32 ReturnValue = FS_EACCESS;
 	const u32 Address = Memory::Read_U32(_CommandAddress + 0xC);  // Read to this memory address
 	const u32 Size = Memory::Read_U32(_CommandAddress + 0x10);
 
+	FSThreads::Post(_CommandAddress, m_Name,
+		[this, Address, Size] { return ReadFile(Address, Size); });
+	return GetDefaultReply();
+}
+
+s32 CWII_IPC_HLE_Device_FileIO::ReadFile(u32 Address, u32 Size)
+{
+	u32 ReturnValue = FS_EACCESS;
+
 	if (m_file->IsOpen())
 	{
 		if (m_Mode == ISFS_OPEN_WRITE)
@@ -260,6 +283,7 @@ IPCCommandResult CWII_IPC_HLE_Device_FileIO::Read(u32 _CommandAddress)
 				m_Name.c_str());
 			m_file->Seek(m_SeekPos, SEEK_SET);  // File might be opened twice, need to seek before we read
 			ReturnValue = (u32)fread(Memory::GetPointer(Address), 1, Size, m_file->GetHandle());
+			Memory::MarkWritten(Address, Size);
 			if (ReturnValue != Size && ferror(m_file->GetHandle()))
 			{
 				ReturnValue = FS_EACCESS;
@@ -278,17 +302,24 @@ IPCCommandResult CWII_IPC_HLE_Device_FileIO::Read(u32 _CommandAddress)
 		ReturnValue = FS_FILE_NOT_EXIST;
 	}
 
-	Memory::Write_U32(ReturnValue, _CommandAddress + 0x4);
-	return GetDefaultReply();
+	return ReturnValue;
 }
 
 IPCCommandResult CWII_IPC_HLE_Device_FileIO::Write(u32 _CommandAddress)
 {
-	u32 ReturnValue = FS_EACCESS;
 	const u32 Address =
 		Memory::Read_U32(_CommandAddress + 0xC);  // Write data from this memory address
 	const u32 Size = Memory::Read_U32(_CommandAddress + 0x10);
 
+	FSThreads::Post(_CommandAddress, m_Name,
+		[this, Address, Size] { return WriteFile(Address, Size); });
+	return GetDefaultReply();
+}
+
+s32 CWII_IPC_HLE_Device_FileIO::WriteFile(u32 Address, u32 Size)
+{
+	u32 ReturnValue = FS_EACCESS;
+
 	if (m_file->IsOpen())
 	{
 		if (m_Mode == ISFS_OPEN_READ)
@@ -318,8 +349,7 @@ IPCCommandResult CWII_IPC_HLE_Device_FileIO::Write(u32 _CommandAddress)
 		ReturnValue = FS_FILE_NOT_EXIST;
 	}
 
-	Memory::Write_U32(ReturnValue, _CommandAddress + 0x4);
-	return GetDefaultReply();
+	return ReturnValue;
 }
 
 IPCCommandResult CWII_IPC_HLE_Device_FileIO::IOCtl(u32 _CommandAddress)
@@ -335,23 +365,11 @@ IPCCommandResult CWII_IPC_HLE_Device_FileIO::IOCtl(u32 _CommandAddress)
 	{
 	case ISFS_IOCTL_GETFILESTATS:
 	{
-		if (m_file->IsOpen())
-		{
-			u32 m_FileLength = (u32)m_file->GetSize();
-
-			const u32 BufferOut = Memory::Read_U32(_CommandAddress + 0x18);
-			INFO_LOG(WII_IPC_FILEIO, "  File: %s, Length: %i, Pos: %i", m_Name.c_str(), m_FileLength,
-				m_SeekPos);
-
-			Memory::Write_U32(m_FileLength, BufferOut);
-			Memory::Write_U32(m_SeekPos, BufferOut + 4);
-		}
-		else
-		{
-			ReturnValue = FS_FILE_NOT_EXIST;
-		}
+		// The length and position depend on the commands before this one
+		const u32 BufferOut = Memory::Read_U32(_CommandAddress + 0x18);
+		FSThreads::Post(_CommandAddress, m_Name, [this, BufferOut] { return GetFileStats(BufferOut); });
+		return GetDefaultReply();
 	}
-	break;
 
 	default:
 	{
@@ -365,6 +383,20 @@ IPCCommandResult CWII_IPC_HLE_Device_FileIO::IOCtl(u32 _CommandAddress)
 	return GetDefaultReply();
 }
 
+s32 CWII_IPC_HLE_Device_FileIO::GetFileStats(u32 BufferOut)
+{
+	if (!m_file->IsOpen())
+		return FS_FILE_NOT_EXIST;
+
+	u32 m_FileLength = (u32)m_file->GetSize();
+	INFO_LOG(WII_IPC_FILEIO, "  File: %s, Length: %i, Pos: %i", m_Name.c_str(), m_FileLength,
+		m_SeekPos);
+
+	Memory::Write_U32(m_FileLength, BufferOut);
+	Memory::Write_U32(m_SeekPos, BufferOut + 4);
+	return 0;
+}
+
 void CWII_IPC_HLE_Device_FileIO::PrepareForState(PointerWrap::Mode mode)
 {
 	// Temporally close the file, to prevent any issues with the savestating of /tmp
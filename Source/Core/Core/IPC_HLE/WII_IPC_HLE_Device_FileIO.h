@@ -75,7 +75,14 @@ private:
 		ISFS_IOCTL_SHUTDOWN = 13
 	};
 
+	// These run on an FS thread, after the earlier commands for the same file
+	s32 SeekFile(s32 SeekPosition, s32 Mode);
+	s32 ReadFile(u32 Address, u32 Size);
+	s32 WriteFile(u32 Address, u32 Size);
+	s32 GetFileStats(u32 BufferOut);
+
 	u32 m_Mode;
+	// Only used by the FS threads while the emulation is running
 	u32 m_SeekPos;
 
 	std::string m_filepath;
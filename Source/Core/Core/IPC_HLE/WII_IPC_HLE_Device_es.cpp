@@ -46,6 +46,7 @@
 #include "Core/Boot/Boot_DOL.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/DVDInterface.h"
+#include "Core/HW/DVDThread.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_es.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_usb.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_WiiMote.h"
@@ -117,7 +118,8 @@ void CWII_IPC_HLE_Device_es::OpenInternal()
 	{
 		// blindly grab the titleID from the disc - it's unencrypted at:
 		// offset 0x0F8001DC and 0x0F80044C
-		DVDInterface::GetVolume().GetTitleID(&m_TitleID);
+		DVDThread::AccessVolume(
+			[this](const DiscIO::IVolume& volume) { volume.GetTitleID(&m_TitleID); });
 	}
 	else
 	{
@@ -1143,7 +1145,8 @@ u32 CWII_IPC_HLE_Device_es::ES_DIVerify(const std::vector<u8>& tmd)
 	u64 title_id = 0xDEADBEEFDEADBEEFull;
 	u64 tmd_title_id = Common::swap64(&tmd[0x18C]);
 
-	DVDInterface::GetVolume().GetTitleID(&title_id);
+	DVDThread::AccessVolume(
+		[&title_id](const DiscIO::IVolume& volume) { volume.GetTitleID(&title_id); });
 	if (title_id != tmd_title_id)
 		return -1;
 
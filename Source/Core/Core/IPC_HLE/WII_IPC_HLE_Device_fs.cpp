@@ -15,6 +15,7 @@
 #include "Core/HW/SystemTimers.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_FileIO.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_fs.h"
+#include "Core/IPC_HLE/WII_IPC_HLE_FSThreads.h"
 
 static Common::replace_v replacements;
 
@@ -30,6 +31,8 @@ CWII_IPC_HLE_Device_fs::~CWII_IPC_HLE_Device_fs()
 
 IPCCommandResult CWII_IPC_HLE_Device_fs::Open(u32 _CommandAddress, u32 _Mode)
 {
+	FSThreads::WaitUntilIdle();
+
 	// clear tmp folder
 	{
 		std::string Path = HLE_IPC_BuildFilename("/tmp");
@@ -68,8 +71,15 @@ static u64 ComputeTotalFileSize(const File::FSTEntry& parentEntry)
 
 IPCCommandResult CWII_IPC_HLE_Device_fs::IOCtlV(u32 _CommandAddress)
 {
-	u32 ReturnValue = FS_RESULT_OK;
 	SIOCtlVBuffer CommandBuffer(_CommandAddress);
+	FSThreads::Post(_CommandAddress, FSThreads::BARRIER,
+		[this, CommandBuffer] { return ExecuteCommandV(CommandBuffer); });
+	return GetFSReply();
+}
+
+s32 CWII_IPC_HLE_Device_fs::ExecuteCommandV(const SIOCtlVBuffer& CommandBuffer)
+{
+	u32 ReturnValue = FS_RESULT_OK;
 
 	// Prepare the out buffer(s) with zeros as a safety precaution
 	// to avoid returning bad values
@@ -218,9 +228,7 @@ IPCCommandResult CWII_IPC_HLE_Device_fs::IOCtlV(u32 _CommandAddress)
 		break;
 	}
 
-	Memory::Write_U32(ReturnValue, _CommandAddress + 4);
-
-	return GetFSReply();
+	return ReturnValue;
 }
 
 IPCCommandResult CWII_IPC_HLE_Device_fs::IOCtl(u32 _CommandAddress)
@@ -233,13 +241,15 @@ IPCCommandResult CWII_IPC_HLE_Device_fs::IOCtl(u32 _CommandAddress)
 	u32 BufferOut = Memory::Read_U32(_CommandAddress + 0x18);
 	u32 BufferOutSize = Memory::Read_U32(_CommandAddress + 0x1C);
 
-	/* Prepare the out buffer(s) with zeroes as a safety precaution
-		 to avoid returning bad values. */
-		 // LOG(WII_IPC_FILEIO, "Cleared %u bytes of the out buffer", _BufferOutSize);
-	Memory::Memset(BufferOut, 0, BufferOutSize);
+	FSThreads::Post(_CommandAddress, FSThreads::BARRIER,
+		[this, Parameter, BufferIn, BufferInSize, BufferOut, BufferOutSize] {
+		/* Prepare the out buffer(s) with zeroes as a safety precaution
+			 to avoid returning bad values. */
+			 // LOG(WII_IPC_FILEIO, "Cleared %u bytes of the out buffer", _BufferOutSize);
+		Memory::Memset(BufferOut, 0, BufferOutSize);
 
-	u32 ReturnValue = ExecuteCommand(Parameter, BufferIn, BufferInSize, BufferOut, BufferOutSize);
-	Memory::Write_U32(ReturnValue, _CommandAddress + 4);
+		return ExecuteCommand(Parameter, BufferIn, BufferInSize, BufferOut, BufferOutSize);
+	});
 
 	return GetFSReply();
 }
@@ -63,6 +63,8 @@ private:
 	// ~1/1000th of a second is too short and causes hangs in Wii Party
 	// Play it safe at 1/500th
 	IPCCommandResult GetFSReply() const { return{ true, SystemTimers::GetTicksPerSecond() / 500 }; }
+	// These run on an FS thread, after all earlier FS commands
 	s32 ExecuteCommand(u32 Parameter, u32 _BufferIn, u32 _BufferInSize, u32 _BufferOut,
 		u32 _BufferOutSize);
+	s32 ExecuteCommandV(const SIOCtlVBuffer& CommandBuffer);
 };
@@ -0,0 +1,176 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+
+#include "Core/IPC_HLE/WII_IPC_HLE_FSThreads.h"
+
+namespace FSThreads
+{
+const std::string BARRIER;
+
+namespace
+{
+struct Job
+{
+	u32 address;
+	std::string key;
+	std::function<s32()> function;
+};
+
+const int NUM_THREADS = 2;
+}
+
+static std::vector<std::thread> s_threads;
+static bool s_exiting = false;
+
+static std::mutex s_lock;
+static std::condition_variable s_work_available;
+static std::condition_variable s_job_done;
+static std::deque<Job> s_queue;
+static std::multiset<std::string> s_running;
+// Commands that were posted and whose results weren't taken yet
+static std::set<u32> s_posted;
+static std::map<u32, s32> s_results;
+
+// Index of the oldest queued job that may start now, or the queue size if there is none
+static size_t FindRunnableJob()
+{
+	if (s_running.count(BARRIER))
+		return s_queue.size();
+
+	for (size_t i = 0; i < s_queue.size(); ++i)
+	{
+		const std::string& key = s_queue[i].key;
+		if (key == BARRIER)
+			return i == 0 && s_running.empty() ? i : s_queue.size();
+
+		const bool waiting =
+			s_running.count(key) || std::any_of(s_queue.begin(), s_queue.begin() + i,
+				[&key](const Job& job) { return job.key == key; });
+		if (!waiting)
+			return i;
+	}
+	return s_queue.size();
+}
+
+static void ThreadFunc()
+{
+	Common::SetCurrentThreadName("FS thread");
+
+	std::unique_lock<std::mutex> lk(s_lock);
+	while (true)
+	{
+		size_t index;
+		while (!s_exiting && (index = FindRunnableJob()) == s_queue.size())
+			s_work_available.wait(lk);
+		if (s_exiting)
+			break;
+
+		Job job = std::move(s_queue[index]);
+		s_queue.erase(s_queue.begin() + index);
+		s_running.insert(job.key);
+		lk.unlock();
+
+		const s32 result = job.function();
+		// Let go of whatever the job holds on to before anyone can see it finished
+		job.function = nullptr;
+
+		lk.lock();
+		s_running.erase(s_running.find(job.key));
+		s_results[job.address] = result;
+		s_job_done.notify_all();
+		// Jobs with the same key, or a barrier, may be able to start now
+		s_work_available.notify_all();
+	}
+}
+
+void Start()
+{
+	s_exiting = false;
+	for (int i = 0; i < NUM_THREADS; ++i)
+		s_threads.emplace_back(ThreadFunc);
+}
+
+void Stop()
+{
+	WaitUntilIdle();
+	{
+		std::lock_guard<std::mutex> lk(s_lock);
+		s_exiting = true;
+		s_posted.clear();
+		s_results.clear();
+	}
+	s_work_available.notify_all();
+	for (std::thread& thread : s_threads)
+		thread.join();
+	s_threads.clear();
+}
+
+void Reset()
+{
+	WaitUntilIdle();
+	std::lock_guard<std::mutex> lk(s_lock);
+	s_posted.clear();
+	s_results.clear();
+}
+
+void DoState(PointerWrap& p)
+{
+	WaitUntilIdle();
+	std::lock_guard<std::mutex> lk(s_lock);
+	// Every posted job has finished by now
+	p.Do(s_results);
+	if (p.GetMode() == PointerWrap::MODE_READ)
+	{
+		s_posted.clear();
+		for (const auto& result : s_results)
+			s_posted.insert(result.first);
+	}
+}
+
+void Post(u32 command_address, const std::string& key, std::function<s32()> job)
+{
+	std::lock_guard<std::mutex> lk(s_lock);
+	s_posted.insert(command_address);
+	s_queue.push_back({command_address, key, std::move(job)});
+	s_work_available.notify_one();
+}
+
+bool WaitForResult(u32 command_address, s32* result)
+{
+	std::unique_lock<std::mutex> lk(s_lock);
+	if (!s_posted.count(command_address))
+		return false;
+
+	auto it = s_results.find(command_address);
+	while (it == s_results.end())
+	{
+		s_job_done.wait(lk);
+		it = s_results.find(command_address);
+	}
+	*result = it->second;
+	s_results.erase(it);
+	s_posted.erase(command_address);
+	return true;
+}
+
+void WaitUntilIdle()
+{
+	std::unique_lock<std::mutex> lk(s_lock);
+	while (!s_queue.empty() || !s_running.empty())
+		s_job_done.wait(lk);
+}
+}
@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+class PointerWrap;
+
+// Host file I/O for the FS devices, done on a pool of threads so that the CPU thread only has to
+// wait for it if it takes longer than the emulated reply delay.
+//
+// A command that is posted here still gets its reply scheduled by ExecuteCommand at the usual
+// time. When that reply is enqueued, the CPU thread waits for the job and writes its result, so
+// emulation stays deterministic. Until then the job owns the command's buffers, like IOS does.
+namespace FSThreads
+{
+// Jobs with this key run alone, after every job posted before them and before any posted after
+// them. Used for operations on the file system as a whole.
+extern const std::string BARRIER;
+
+void Start();
+void Stop();
+// Waits for all jobs and forgets the results nobody asked for
+void Reset();
+void DoState(PointerWrap& p);
+
+// Runs job on an I/O thread after all earlier jobs with the same key, which should name what the
+// job touches (e.g. the file). Its return value is the result of the command at command_address.
+void Post(u32 command_address, const std::string& key, std::function<s32()> job);
+
+// If a job was posted for command_address, waits for it and takes its result
+bool WaitForResult(u32 command_address, s32* result);
+
+void WaitUntilIdle();
+}
@@ -32,6 +32,7 @@
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_usb.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_WiiMote.h"
 #include "Core/Movie.h"
+#include "Core/MovieInput.h"
 #include "Core/NetPlayProto.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/State.h"
@@ -41,9 +42,6 @@
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
-// The chunk to allocate movie data in multiples of.
-#define DTM_BASE_LENGTH (1024)
-
 static std::mutex cs_frameSkip;
 
 namespace Movie
@@ -58,8 +56,7 @@ static u32 s_framesToSkip = 0, s_frameSkipCounter = 0;
 static u8 s_numPads = 0;
 static ControllerState s_padState;
 static DTMHeader tmpHeader;
-static u8* tmpInput = nullptr;
-static size_t tmpInputAllocated = 0;
+static InputStore s_input;
 static u64 s_currentByte = 0, s_totalBytes = 0;
 static u64 s_currentFrame = 0, s_totalFrames = 0;  // VI
 static u64 s_currentLagCount = 0;
@@ -96,27 +93,7 @@ static std::string s_InputDisplay[8];
 static GCManipFunction gcmfunc = nullptr;
 static WiiManipFunction wiimfunc = nullptr;
 
-// NOTE: Host / CPU Thread
-static void EnsureTmpInputSize(size_t bound)
-{
-	if (tmpInputAllocated >= bound)
-		return;
-	// The buffer expands in powers of two of DTM_BASE_LENGTH
-	// (standard exponential buffer growth).
-	size_t newAlloc = DTM_BASE_LENGTH;
-	while (newAlloc < bound)
-		newAlloc *= 2;
-
-	u8* newTmpInput = new u8[newAlloc];
-	tmpInputAllocated = newAlloc;
-	if (tmpInput != nullptr)
-	{
-		if (s_totalBytes > 0)
-			memcpy(newTmpInput, tmpInput, (size_t)s_totalBytes);
-		delete[] tmpInput;
-	}
-	tmpInput = newTmpInput;
-}
+static DTMHeader CreateHeader();
 
 static bool IsMovieHeader(u8 magic[4])
 {
@@ -641,11 +618,20 @@ bool BeginRecordingInput(int controllers)
 		Wiimote::ResetAllWiimotes();
 	}
 
+	if (!s_input.OpenForRecording())
+	{
+		PanicAlertT("Failed to create the movie journal in %s",
+			File::GetUserPath(D_CACHE_IDX).c_str());
+		s_bRecordingFromSaveState = false;
+		Core::PauseAndLock(false, was_unpaused);
+		return false;
+	}
+
 	s_playMode = MODE_RECORDING;
 	s_author = SConfig::GetInstance().m_strMovieAuthor;
-	EnsureTmpInputSize(1);
 
 	s_currentByte = s_totalBytes = 0;
+	s_input.SetHeader(CreateHeader());
 
 	Core::UpdateWantDeterminism();
 
@@ -911,10 +897,11 @@ void RecordInput(GCPadStatus* PadStatus, int controllerID)
 
 	CheckPadStatus(PadStatus, controllerID);
 
-	EnsureTmpInputSize((size_t)(s_currentByte + 8));
-	memcpy(&(tmpInput[s_currentByte]), &s_padState, 8);
+	s_input.Write(s_currentByte, &s_padState, 8);
 	s_currentByte += 8;
 	s_totalBytes = s_currentByte;
+	if (s_input.WantsHeader())
+		s_input.SetHeader(CreateHeader());
 }
 
 // NOTE: CPU Thread
@@ -933,11 +920,14 @@ void RecordWiimote(int wiimote, u8* data, u8 size)
 		return;
 
 	InputUpdate();
-	EnsureTmpInputSize((size_t)(s_currentByte + size + 1));
-	tmpInput[s_currentByte++] = size;
-	memcpy(&(tmpInput[s_currentByte]), data, size);
-	s_currentByte += size;
+	std::array<u8, 256> entry;
+	entry[0] = size;
+	std::copy(data, data + size, entry.begin() + 1);
+	s_input.Write(s_currentByte, entry.data(), size + 1);
+	s_currentByte += size + 1;
 	s_totalBytes = s_currentByte;
+	if (s_input.WantsHeader())
+		s_input.SetHeader(CreateHeader());
 }
 
 // NOTE: EmuThread / Host Thread
@@ -1018,11 +1008,10 @@ bool PlayInput(const std::string& filename)
 
 	Core::UpdateWantDeterminism();
 
-	s_totalBytes = g_recordfd.GetSize() - 256;
-	EnsureTmpInputSize((size_t)s_totalBytes);
-	g_recordfd.ReadArray(tmpInput, (size_t)s_totalBytes);
-	s_currentByte = 0;
 	g_recordfd.Close();
+	s_input.OpenForPlayback(filename);
+	s_totalBytes = s_input.GetSize();
+	s_currentByte = 0;
 
 	// Load savestate (and skip to frame data)
 	if (tmpHeader.bFromSaveState)
@@ -1095,16 +1084,16 @@ void LoadInput(const std::string& filename)
 		afterEnd = true;
 	}
 
-	if (!s_bReadOnly || tmpInput == nullptr)
+	if (!s_bReadOnly || !s_input.IsOpen())
 	{
 		s_totalFrames = tmpHeader.frameCount;
 		s_totalLagCount = tmpHeader.lagCount;
 		s_totalInputCount = tmpHeader.inputCount;
 		s_totalTickCount = s_tickCountAtLastInput = tmpHeader.tickCount;
 
-		EnsureTmpInputSize((size_t)totalSavedBytes);
-		s_totalBytes = totalSavedBytes;
-		t_record.ReadArray(tmpInput, (size_t)s_totalBytes);
+		s_input.LoadFrom(t_record, totalSavedBytes);
+		s_totalBytes = s_input.GetSize();
+		s_input.SetHeader(CreateHeader());
 	}
 	else if (s_currentByte > 0)
 	{
@@ -1122,15 +1111,25 @@ void LoadInput(const std::string& filename)
 		}
 		else if (s_currentByte > 0 && s_totalBytes > 0)
 		{
-			// verify identical from movie start to the save's current frame
-			std::vector<u8> movInput(s_currentByte);
-			t_record.ReadArray(movInput.data(), movInput.size());
-
-			const auto result = std::mismatch(movInput.begin(), movInput.end(), tmpInput);
+			// verify identical from movie start to the save's current frame, a piece at a time
+			const u64 compare_size = std::min(s_currentByte, s_totalBytes);
+			std::vector<u8> movInput(std::min<u64>(compare_size, 64 * 1024));
+			std::vector<u8> curInput(movInput.size());
+			u64 mismatch_index = compare_size;
+			for (u64 offset = 0; offset < compare_size && mismatch_index == compare_size;
+				offset += movInput.size())
+			{
+				const size_t piece = (size_t)std::min<u64>(compare_size - offset, movInput.size());
+				t_record.ReadBytes(movInput.data(), piece);
+				s_input.Read(offset, curInput.data(), piece);
+				const auto result =
+					std::mismatch(movInput.begin(), movInput.begin() + piece, curInput.begin());
+				if (result.first != movInput.begin() + piece)
+					mismatch_index = offset + std::distance(movInput.begin(), result.first);
+			}
 
-			if (result.first != movInput.end())
+			if (mismatch_index != compare_size)
 			{
-				const ptrdiff_t mismatch_index = std::distance(movInput.begin(), result.first);
 
 				// this is a "you did something wrong" alert for the user's benefit.
 				// we'll try to say what's going on in excruciating detail, otherwise the user might not
@@ -1145,15 +1144,23 @@ void LoadInput(const std::string& filename)
 						"read-only mode off. Otherwise you'll probably get a desync.",
 						byte_offset, byte_offset);
 
-					std::copy(movInput.begin(), movInput.end(), tmpInput);
+					// take over the savestate's input up to the current byte
+					t_record.Seek(sizeof(DTMHeader) + mismatch_index, SEEK_SET);
+					for (u64 offset = mismatch_index; offset < compare_size; offset += movInput.size())
+					{
+						const size_t piece = (size_t)std::min<u64>(compare_size - offset, movInput.size());
+						t_record.ReadBytes(movInput.data(), piece);
+						s_input.Overwrite(offset, movInput.data(), piece);
+					}
 				}
 				else
 				{
-					const ptrdiff_t frame = mismatch_index / 8;
+					const ptrdiff_t frame = (ptrdiff_t)(mismatch_index / 8);
 					ControllerState curPadState;
-					memcpy(&curPadState, &tmpInput[frame * 8], 8);
+					s_input.Read(frame * 8, &curPadState, 8);
 					ControllerState movPadState;
-					memcpy(&movPadState, &movInput[frame * 8], 8);
+					t_record.Seek(sizeof(DTMHeader) + frame * 8, SEEK_SET);
+					t_record.ReadArray(&movPadState, 1);
 					PanicAlertT(
 						"Warning: You loaded a save whose movie mismatches on frame %td. You should load "
 						"another save before continuing, or load this state with read-only mode off. "
@@ -1228,7 +1235,7 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 {
 	// Correct playback is entirely dependent on the emulator polling the controllers
 	// in the same order done during recording
-	if (!IsPlayingInput() || !IsUsingPad(controllerID) || tmpInput == nullptr)
+	if (!IsPlayingInput() || !IsUsingPad(controllerID) || !s_input.IsOpen())
 		return;
 
 	if (s_currentByte + 8 > s_totalBytes)
@@ -1245,7 +1252,12 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 	memset(PadStatus, 0, sizeof(GCPadStatus));
 	PadStatus->err = e;
 
-	memcpy(&s_padState, &(tmpInput[s_currentByte]), 8);
+	if (!s_input.Read(s_currentByte, &s_padState, 8))
+	{
+		PanicAlertT("Failed to read the movie input at byte %u", (u32)s_currentByte);
+		EndPlayInput(false);
+		return;
+	}
 	s_currentByte += 8;
 
 	PadStatus->triggerLeft = s_padState.TriggerL;
@@ -1329,7 +1341,7 @@ void PlayController(GCPadStatus* PadStatus, int controllerID)
 bool PlayWiimote(int wiimote, u8* data, const WiimoteEmu::ReportFeatures& rptf, int ext,
 	const wiimote_key key)
 {
-	if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || tmpInput == nullptr)
+	if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || !s_input.IsOpen())
 		return false;
 
 	if (s_currentByte > s_totalBytes)
@@ -1342,7 +1354,8 @@ bool PlayWiimote(int wiimote, u8* data, const WiimoteEmu::ReportFeatures& rptf,
 
 	u8 size = rptf.size;
 
-	u8 sizeInMovie = tmpInput[s_currentByte];
+	u8 sizeInMovie = 0;
+	s_input.Read(s_currentByte, &sizeInMovie, 1);
 
 	if (size != sizeInMovie)
 	{
@@ -1365,7 +1378,12 @@ bool PlayWiimote(int wiimote, u8* data, const WiimoteEmu::ReportFeatures& rptf,
 		return false;
 	}
 
-	memcpy(data, &(tmpInput[s_currentByte]), size);
+	if (!s_input.Read(s_currentByte, data, size))
+	{
+		PanicAlertT("Failed to read the movie input at byte %u", (u32)s_currentByte);
+		EndPlayInput(false);
+		return false;
+	}
 	s_currentByte += size;
 
 	s_currentInputCount++;
@@ -1396,8 +1414,7 @@ void EndPlayInput(bool cont)
 		// we don't clear these things because otherwise we can't resume playback if we load a movie
 		// state later
 		// s_totalFrames = s_totalBytes = 0;
-		// delete tmpInput;
-		// tmpInput = nullptr;
+		// s_input.Close();
 
 		Core::QueueHostJob([=] {
 			Core::UpdateWantDeterminism();
@@ -1407,11 +1424,9 @@ void EndPlayInput(bool cont)
 	}
 }
 
-// NOTE: Save State + Host Thread
-void SaveRecording(const std::string& filename)
+// NOTE: Host / CPU / Save State Thread
+static DTMHeader CreateHeader()
 {
-	File::IOFile save_record(filename, "wb");
-	// Create the real header now and write it
 	DTMHeader header;
 	memset(&header, 0, sizeof(DTMHeader));
 
@@ -1464,9 +1479,13 @@ void SaveRecording(const std::string& filename)
 	header.uniqueID = 0;
 	// header.audioEmulator;
 
-	save_record.WriteArray(&header, 1);
+	return header;
+}
 
-	bool success = save_record.WriteArray(tmpInput, (size_t)s_totalBytes);
+// NOTE: Save State + Host Thread
+void SaveRecording(const std::string& filename)
+{
+	bool success = s_input.SaveAs(filename, CreateHeader());
 
 	if (success && s_bRecordingFromSaveState)
 	{
@@ -1614,8 +1633,6 @@ void Shutdown()
 {
 	s_currentInputCount = s_totalInputCount = s_totalFrames = s_totalBytes = s_tickCountAtLastInput =
 		0;
-	delete[] tmpInput;
-	tmpInput = nullptr;
-	tmpInputAllocated = 0;
+	s_input.Close();
 }
 };
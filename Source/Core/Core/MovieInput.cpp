@@ -0,0 +1,411 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+#include "Core/MovieInput.h"
+
+namespace Movie
+{
+// Input is handed to the writer thread in chunks of this size
+static const size_t CHUNK_SIZE = 4 * 1024;
+static const size_t WINDOW_SIZE = 64 * 1024;
+static const size_t COPY_SIZE = 1024 * 1024;
+
+// Each journal gets its own name, so that several instances of Dolphin can record at once
+static std::string NewJournalPath()
+{
+	return File::GetUserPath(D_CACHE_IDX) +
+		StringFromFormat("movie_%" PRIu64 "_%" PRIu64 ".dtm", Common::Timer::GetTimeSinceJan1970(),
+			Common::Timer::GetTimeUs());
+}
+
+static bool CopyBytes(File::IOFile& src, File::IOFile& dst, u64 size)
+{
+	std::vector<u8> buffer((size_t)std::min<u64>(size, COPY_SIZE));
+	while (size > 0)
+	{
+		const size_t piece = (size_t)std::min<u64>(size, COPY_SIZE);
+		if (!src.ReadBytes(buffer.data(), piece) || !dst.WriteBytes(buffer.data(), piece))
+			return false;
+		size -= piece;
+	}
+	return true;
+}
+
+InputStore::InputStore()
+{
+	memset(&m_header, 0, sizeof(m_header));
+}
+
+InputStore::~InputStore()
+{
+	Close();
+}
+
+bool InputStore::OpenForPlayback(const std::string& path)
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	Close();
+	if (!m_file.Open(path, "rb"))
+		return false;
+
+	m_path = path;
+	const u64 file_size = m_file.GetSize();
+	m_size = file_size > sizeof(DTMHeader) ? file_size - sizeof(DTMHeader) : 0;
+	return true;
+}
+
+bool InputStore::OpenForRecording()
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	Close();
+	return CreateJournal(nullptr, 0);
+}
+
+bool InputStore::LoadFrom(File::IOFile& src, u64 size)
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	if (!m_journal)
+	{
+		Close();
+		return CreateJournal(&src, size);
+	}
+
+	// Loading a state while recording mostly goes back in the same movie, so only the part after
+	// where the two differ has to be written
+	Flush();
+	m_window.clear();
+	std::lock_guard<std::mutex> file_lk(m_file_lock);
+	const u64 src_start = src.Tell();
+	const u64 compare_size = std::min(size, m_size);
+	std::vector<u8> src_piece((size_t)std::min<u64>(compare_size, COPY_SIZE));
+	std::vector<u8> journal_piece(src_piece.size());
+	u64 common = 0;
+	m_file.Clear();
+	m_file.Seek(sizeof(DTMHeader), SEEK_SET);
+	while (common < compare_size)
+	{
+		const size_t piece = (size_t)std::min<u64>(compare_size - common, src_piece.size());
+		if (!src.ReadBytes(src_piece.data(), piece) || !m_file.ReadBytes(journal_piece.data(), piece))
+			break;
+		const auto result =
+			std::mismatch(src_piece.begin(), src_piece.begin() + piece, journal_piece.begin());
+		common += std::distance(src_piece.begin(), result.first);
+		if (result.first != src_piece.begin() + piece)
+			break;
+	}
+
+	m_file.Clear();
+	src.Seek(src_start + common, SEEK_SET);
+	const bool success = m_file.Resize(sizeof(DTMHeader) + common) &&
+		m_file.Seek(sizeof(DTMHeader) + common, SEEK_SET) &&
+		CopyBytes(src, m_file, size - common);
+	if (!success)
+		ERROR_LOG(COMMON, "Failed to update movie journal %s", m_path.c_str());
+
+	m_size = success ? size : common;
+	m_pending_offset = m_size;
+	m_pending.clear();
+	return success;
+}
+
+// The journal is built next to its final name and renamed over it, so an existing journal is
+// never left half written.
+bool InputStore::CreateJournal(File::IOFile* src, u64 size)
+{
+	const std::string path = NewJournalPath();
+	const std::string temp_path = path + ".tmp";
+	File::CreateFullPath(path);
+
+	{
+		File::IOFile journal(temp_path, "wb");
+		if (!journal.WriteArray(&m_header, 1) || (src && !CopyBytes(*src, journal, size)))
+		{
+			ERROR_LOG(COMMON, "Failed to create movie journal %s", temp_path.c_str());
+			journal.Close();
+			File::Delete(temp_path);
+			m_file.Close();
+			return false;
+		}
+	}
+
+	// src may be the playback file, which can't be renamed over while open on Windows
+	m_file.Close();
+	if (!File::RenameSync(temp_path, path) || !m_file.Open(path, "r+b"))
+	{
+		ERROR_LOG(COMMON, "Failed to open movie journal %s", path.c_str());
+		return false;
+	}
+
+	m_path = path;
+	m_journal = true;
+	m_size = size;
+	m_pending.clear();
+	m_pending_offset = size;
+	m_window.clear();
+	m_exit = false;
+	m_thread = std::thread(&InputStore::WriterThread, this);
+	return true;
+}
+
+// Recording can take over from playback at any point, which needs a writable copy of the input
+void InputStore::EnsureJournal()
+{
+	// Without any input there is nothing to take over, and a journal that failed to open stays shut
+	if (m_journal || !m_file.IsOpen())
+		return;
+
+	m_file.Seek(0, SEEK_SET);
+	m_file.ReadArray(&m_header, 1);
+	CreateJournal(&m_file, m_size);
+}
+
+void InputStore::Close()
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	if (m_journal)
+	{
+		Flush();
+		StopWriter();
+	}
+
+	m_file.Close();
+	// Only a crash leaves the journal behind
+	if (m_journal)
+		File::Delete(m_path);
+	m_path.clear();
+	m_journal = false;
+	m_size = 0;
+	m_pending.clear();
+	m_pending_offset = 0;
+	m_header_wanted = false;
+	m_window.clear();
+}
+
+bool InputStore::IsOpen()
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	return m_file.IsOpen();
+}
+
+u64 InputStore::GetSize()
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	return m_size;
+}
+
+bool InputStore::WantsHeader()
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	return m_header_wanted;
+}
+
+void InputStore::Write(u64 offset, const void* data, size_t size)
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	EnsureJournal();
+	if (!m_journal)
+		return;
+
+	m_window.clear();
+	if (offset < m_pending_offset)
+	{
+		// Rewinding, e.g. after loading a state while recording
+		Flush();
+		std::lock_guard<std::mutex> file_lk(m_file_lock);
+		m_file.Resize(sizeof(DTMHeader) + offset);
+		m_pending_offset = offset;
+	}
+
+	const u8* bytes = static_cast<const u8*>(data);
+	m_pending.resize((size_t)(offset - m_pending_offset));
+	m_pending.insert(m_pending.end(), bytes, bytes + size);
+	m_size = offset + size;
+
+	if (m_pending.size() >= CHUNK_SIZE)
+		QueueChunk();
+}
+
+void InputStore::Overwrite(u64 offset, const void* data, size_t size)
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	if (offset + size >= m_size)
+	{
+		Write(offset, data, size);
+		return;
+	}
+
+	EnsureJournal();
+	if (!m_journal)
+		return;
+
+	Flush();
+	m_window.clear();
+	std::lock_guard<std::mutex> file_lk(m_file_lock);
+	m_file.Seek(sizeof(DTMHeader) + offset, SEEK_SET);
+	m_file.WriteBytes(data, size);
+}
+
+bool InputStore::Read(u64 offset, void* data, size_t size)
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	if (!IsOpen() || offset + size > m_size)
+		return false;
+
+	u8* out = static_cast<u8*>(data);
+	if (offset >= m_window_offset && offset + size <= m_window_offset + m_window.size())
+	{
+		memcpy(out, &m_window[(size_t)(offset - m_window_offset)], size);
+		return true;
+	}
+
+	Flush();
+	std::lock_guard<std::mutex> file_lk(m_file_lock);
+	m_file.Clear();
+	if (!m_file.Seek(sizeof(DTMHeader) + offset, SEEK_SET))
+		return false;
+
+	if (size > WINDOW_SIZE)
+		return m_file.ReadBytes(out, size);
+
+	m_window.resize((size_t)std::min<u64>(WINDOW_SIZE, m_size - offset));
+	m_window_offset = offset;
+	if (!m_file.ReadBytes(m_window.data(), m_window.size()))
+	{
+		m_window.clear();
+		return false;
+	}
+
+	memcpy(out, m_window.data(), size);
+	return true;
+}
+
+void InputStore::QueueChunk()
+{
+	if (m_pending.empty())
+		return;
+
+	const u64 size = m_pending.size();
+	{
+		std::lock_guard<std::mutex> queue_lk(m_queue_lock);
+		m_queue.push_back({m_pending_offset, std::move(m_pending)});
+	}
+	m_queue_cv.notify_one();
+
+	m_pending_offset += size;
+	m_pending = std::vector<u8>();
+	m_pending.reserve(CHUNK_SIZE);
+	m_header_wanted = true;
+}
+
+void InputStore::SetHeader(const DTMHeader& header)
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	m_header_wanted = false;
+	{
+		std::lock_guard<std::mutex> queue_lk(m_queue_lock);
+		m_header = header;
+		m_header_dirty = m_journal;
+	}
+	if (m_journal)
+		m_queue_cv.notify_one();
+}
+
+void InputStore::Flush()
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	if (!m_journal)
+		return;
+
+	QueueChunk();
+	std::unique_lock<std::mutex> queue_lk(m_queue_lock);
+	m_idle_cv.wait(queue_lk, [this] { return m_queue.empty() && !m_header_dirty && !m_busy; });
+}
+
+void InputStore::WriterThread()
+{
+	std::unique_lock<std::mutex> lk(m_queue_lock);
+	while (true)
+	{
+		m_queue_cv.wait(lk, [this] { return m_exit || !m_queue.empty() || m_header_dirty; });
+		if (m_queue.empty() && !m_header_dirty)
+			break;
+
+		std::deque<Chunk> chunks;
+		chunks.swap(m_queue);
+		const bool write_header = m_header_dirty;
+		const DTMHeader header = m_header;
+		m_header_dirty = false;
+		m_busy = true;
+		lk.unlock();
+
+		{
+			std::lock_guard<std::mutex> file_lk(m_file_lock);
+			for (const Chunk& chunk : chunks)
+			{
+				m_file.Seek(sizeof(DTMHeader) + chunk.offset, SEEK_SET);
+				m_file.WriteBytes(chunk.data.data(), chunk.data.size());
+			}
+			// The header goes last so it never describes input that isn't in the file yet
+			if (write_header)
+			{
+				m_file.Seek(0, SEEK_SET);
+				m_file.WriteArray(&header, 1);
+			}
+			m_file.Flush();
+		}
+
+		lk.lock();
+		m_busy = false;
+		m_idle_cv.notify_all();
+	}
+}
+
+void InputStore::StopWriter()
+{
+	if (!m_thread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lk(m_queue_lock);
+		m_exit = true;
+	}
+	m_queue_cv.notify_one();
+	m_thread.join();
+	m_exit = false;
+}
+
+bool InputStore::CopyInput(File::IOFile& dst)
+{
+	std::lock_guard<std::mutex> lk(m_file_lock);
+	m_file.Clear();
+	return m_file.Seek(sizeof(DTMHeader), SEEK_SET) && CopyBytes(m_file, dst, m_size);
+}
+
+bool InputStore::SaveAs(const std::string& path, const DTMHeader& header)
+{
+	std::lock_guard<std::recursive_mutex> lk(m_lock);
+	// Writing over the file that is being played back would truncate it under our feet
+	if (IsOpen() && !m_journal && path == m_path)
+		EnsureJournal();
+
+	SetHeader(header);
+	Flush();
+	if (m_journal && path == m_path)
+		return m_file.IsGood();
+
+	File::IOFile out(path, "wb");
+	if (!out.WriteArray(&header, 1))
+		return false;
+	return !IsOpen() || CopyInput(out);
+}
+}
@@ -0,0 +1,102 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/Movie.h"
+
+namespace Movie
+{
+// Input data of the current movie, without ever holding all of it in memory.
+//
+// While recording, input is appended to a journal DTM in the cache directory. Small chunks
+// are written out by a worker thread together with an up to date header, so the journal stays
+// playable if Dolphin crashes. Playback reads the movie file through a small window.
+// All public functions can be called from any thread.
+class InputStore
+{
+public:
+	InputStore();
+	~InputStore();
+
+	// Reads the input of the DTM at path straight from that file
+	bool OpenForPlayback(const std::string& path);
+	// Starts an empty journal
+	bool OpenForRecording();
+	// Replaces the input with the next size bytes of src, which must be positioned after the header.
+	// A journal that is already open keeps the part it has in common with src.
+	bool LoadFrom(File::IOFile& src, u64 size);
+	void Close();
+
+	bool IsOpen();
+	u64 GetSize();
+
+	// Writes at offset, which must not be past the end, and drops everything after the new data
+	void Write(u64 offset, const void* data, size_t size);
+	// Like Write, but keeps the data after the overwritten range
+	void Overwrite(u64 offset, const void* data, size_t size);
+	bool Read(u64 offset, void* data, size_t size);
+
+	// True once a chunk went out with an outdated header
+	bool WantsHeader();
+	// Written to the journal along with the next chunk
+	void SetHeader(const DTMHeader& header);
+	// Waits until everything written so far is on disk
+	void Flush();
+	// Writes a complete DTM with the given header to path
+	bool SaveAs(const std::string& path, const DTMHeader& header);
+
+private:
+	struct Chunk
+	{
+		u64 offset;
+		std::vector<u8> data;
+	};
+
+	bool CreateJournal(File::IOFile* src, u64 size);
+	void EnsureJournal();
+	void QueueChunk();
+	void WriterThread();
+	void StopWriter();
+	bool CopyInput(File::IOFile& dst);
+
+	// Held by every public function, as the save state thread saves the movie while the CPU
+	// thread keeps adding input
+	std::recursive_mutex m_lock;
+
+	File::IOFile m_file;
+	std::string m_path;
+	bool m_journal = false;
+	u64 m_size = 0;
+
+	// Input not handed to the writer yet, starting at m_pending_offset
+	std::vector<u8> m_pending;
+	u64 m_pending_offset = 0;
+	bool m_header_wanted = false;
+
+	// Most recently read part of the file
+	std::vector<u8> m_window;
+	u64 m_window_offset = 0;
+
+	std::mutex m_file_lock;
+	std::mutex m_queue_lock;
+	std::condition_variable m_queue_cv;
+	std::condition_variable m_idle_cv;
+	std::deque<Chunk> m_queue;
+	DTMHeader m_header;
+	bool m_header_dirty = false;
+	bool m_busy = false;
+	bool m_exit = false;
+	std::thread m_thread;
+};
+}
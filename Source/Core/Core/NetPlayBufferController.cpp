@@ -0,0 +1,69 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "Core/NetPlayBufferController.h"
+
+namespace NetPlay
+{
+// Games poll the pads about once per field
+static const float POLLS_PER_SECOND = 60.0f;
+static const float JITTER_FACTOR = 2.0f;
+// Updates the size has to be too large for before it goes down by one
+static const u32 DECREASE_INTERVAL = 3;
+
+const u32 PadBufferController::MIN_SIZE;
+const u32 PadBufferController::MAX_SIZE;
+
+void PadBufferController::Reset(u32 size)
+{
+	m_size = std::min(std::max(size, MIN_SIZE), MAX_SIZE);
+	m_updates_too_large = 0;
+}
+
+u32 PadBufferController::TargetSize(const std::vector<PeerSample>& peers)
+{
+	std::vector<float> delays;
+	for (const PeerSample& peer : peers)
+		delays.push_back(peer.rtt_ms / 2.0f + JITTER_FACTOR * peer.jitter_ms);
+	std::sort(delays.begin(), delays.end(), std::greater<float>());
+
+	float delay_ms = 0;
+	for (size_t i = 0; i < std::min<size_t>(delays.size(), 2); ++i)
+		delay_ms += delays[i];
+
+	// One extra poll for the time between polling and sending
+	const u32 size = static_cast<u32>(std::ceil(delay_ms * POLLS_PER_SECOND / 1000.0f)) + 1;
+	return std::min(std::max(size, MIN_SIZE), MAX_SIZE);
+}
+
+u32 PadBufferController::Update(const std::vector<PeerSample>& peers)
+{
+	u32 target = TargetSize(peers);
+	if (std::any_of(peers.begin(), peers.end(), [](const PeerSample& peer) { return peer.stalled; }))
+		target = std::max(target, std::min(m_size + 1, MAX_SIZE));
+
+	if (target > m_size)
+	{
+		m_size = target;
+		m_updates_too_large = 0;
+	}
+	else if (target < m_size)
+	{
+		if (++m_updates_too_large >= DECREASE_INTERVAL)
+		{
+			--m_size;
+			m_updates_too_large = 0;
+		}
+	}
+	else
+	{
+		m_updates_too_large = 0;
+	}
+	return m_size;
+}
+}
@@ -0,0 +1,43 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+#include "Common/CommonTypes.h"
+
+namespace NetPlay
+{
+// Picks the pad buffer size from the measured connection quality of the players.
+//
+// Pad data travels from its owner through the server to everyone else, so the buffer has to cover
+// the two slowest one way trips plus a margin for their jitter. The size goes up as soon as that
+// needs more frames or a player stalled, but only comes down slowly once it's larger than needed.
+class PadBufferController
+{
+public:
+	struct PeerSample
+	{
+		u32 rtt_ms;
+		float jitter_ms;
+		// The player had to wait for pad data since the last update
+		bool stalled;
+	};
+
+	static const u32 MIN_SIZE = 1;
+	static const u32 MAX_SIZE = 200;
+
+	void Reset(u32 size);
+	u32 GetSize() const { return m_size; }
+	// Called about once a second, returns the new size
+	u32 Update(const std::vector<PeerSample>& peers);
+
+	// Smallest size that shouldn't stall with these players
+	static u32 TargetSize(const std::vector<PeerSample>& peers);
+
+private:
+	u32 m_size = 5;
+	u32 m_updates_too_large = 0;
+};
+}
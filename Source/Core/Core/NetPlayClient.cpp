@@ -5,6 +5,7 @@
 #include "Core/NetPlayClient.h"
 #include <algorithm>
 #include <fstream>
+#include <iomanip>
 #include <mbedtls/md5.h>
 #include <memory>
 #include <thread>
@@ -12,7 +13,6 @@
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/ENetUtil.h"
-#include "Common/MD5.h"
 #include "Common/MsgHandler.h"
 #include "Common/Timer.h"
 #include "Core/ConfigManager.h"
@@ -24,6 +24,7 @@
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 #include "Core/IPC_HLE/WII_IPC_HLE_Device_usb.h"
 #include "Core/Movie.h"
+#include "DiscIO/DiscHash.h"
 #include "InputCommon/GCAdapter.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
@@ -77,7 +78,7 @@ NetPlayClient::NetPlayClient(const std::string& address, const u16 port, NetPlay
 	if (!traversal)
 	{
 		// Direct Connection
-		m_client = enet_host_create(nullptr, 1, 3, 0, 0);
+		m_client = enet_host_create(nullptr, 1, CHANNEL_COUNT, 0, 0);
 
 		if (m_client == nullptr)
 		{
@@ -88,7 +89,7 @@ NetPlayClient::NetPlayClient(const std::string& address, const u16 port, NetPlay
 		enet_address_set_host(&addr, address.c_str());
 		addr.port = port;
 
-		m_server = enet_host_connect(m_client, &addr, 3, 0);
+		m_server = enet_host_connect(m_client, &addr, CHANNEL_COUNT, 0);
 
 		if (m_server == nullptr)
 		{
@@ -315,16 +316,27 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
 	break;
 
 	case NP_MSG_PAD_DATA:
+		OnPadData(packet);
+		break;
+
+	case NP_MSG_PAD_ACK:
 	{
-		PadMapping map = 0;
-		GCPadStatus pad;
-		packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-			pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight;
+		u32 game;
+		u8 count = 0;
+		packet >> game >> count;
+		if (game != m_current_game)
+			break;
 
-		// Trusting server for good map value (>=0 && <4)
-		// add to pad buffer
-		m_pad_buffer.at(map).Push(pad);
-		m_gc_pad_event.Set();
+		std::lock_guard<std::mutex> lk(m_pad_send_lock);
+		for (u8 i = 0; i < count; ++i)
+		{
+			PadMapping map = 0;
+			u32 next_seq = 0;
+			packet >> map >> next_seq;
+			if (!packet || map < 0 || map >= 4)
+				break;
+			m_pad_send_queues[map].Ack(next_seq);
+		}
 	}
 	break;
 
@@ -426,6 +438,9 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
 			g_netplay_initial_gctime = time_low | ((u64)time_high << 32);
 		}
 
+		// Pad data of the new game can arrive before the GUI gets around to starting it
+		ClearBuffers();
+
 		m_dialog->OnMsgStartGame();
 	}
 	break;
@@ -443,9 +458,17 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
 		u32 ping_key = 0;
 		packet >> ping_key;
 
+		// don't need lock to read in this thread
+		float max_jitter = 0;
+		for (const auto& entry : m_players)
+			max_jitter = std::max(max_jitter, entry.second.jitter);
+
+		// The stalls and jitter feed the server's automatic pad buffer
 		sf::Packet spac;
 		spac << (MessageId)NP_MSG_PONG;
 		spac << ping_key;
+		spac << GetPadStallCount();
+		spac << max_jitter;
 
 		Send(spac);
 	}
@@ -558,11 +581,116 @@ unsigned int NetPlayClient::OnData(sf::Packet& packet)
 	return 0;
 }
 
-void NetPlayClient::Send(sf::Packet& packet)
+void NetPlayClient::Send(sf::Packet& packet, const u8 channel_id)
 {
 	ENetPacket* epac =
-		enet_packet_create(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE);
-	enet_peer_send(m_server, 0, epac);
+		enet_packet_create(packet.getData(), packet.getDataSize(),
+			channel_id == PAD_DATA_CHANNEL ? 0 : ENET_PACKET_FLAG_RELIABLE);
+	enet_peer_send(m_server, channel_id, epac);
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayClient::OnPadData(sf::Packet& packet)
+{
+	u32 game;
+	u8 count = 0;
+	packet >> game >> count;
+	// Stale data of the last game, or data that overtook the start of this one. It's sent again
+	// until we acknowledge it.
+	if (game != m_current_game)
+		return;
+
+	sf::Packet ack;
+	ack << static_cast<MessageId>(NP_MSG_PAD_ACK) << game << count;
+
+	std::vector<PlayerId> owners;
+	NetPlay::PadStates data;
+	for (u8 i = 0; i < count; ++i)
+	{
+		// Trusting server for good map values
+		if (!NetPlay::ReadPadStates(packet, &data))
+			return;
+
+		u32& next_seq = m_pad_next_seq[data.map];
+		const size_t first_new = data.FirstNew(next_seq);
+		for (size_t j = first_new; j < data.states.size(); ++j)
+			m_pad_buffer[data.map].Push(data.states[j]);
+		next_seq += static_cast<u32>(data.states.size() - first_new);
+		ack << data.map << next_seq;
+
+		const PlayerId owner = m_pad_map[data.map];
+		if (first_new < data.states.size() && std::find(owners.begin(), owners.end(), owner) == owners.end())
+			owners.push_back(owner);
+	}
+
+	if (!owners.empty())
+	{
+		m_gc_pad_event.Set();
+		for (PlayerId owner : owners)
+			UpdatePadJitter(owner);
+	}
+
+	Send(ack, PAD_DATA_CHANNEL);
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayClient::UpdatePadJitter(PlayerId pid)
+{
+	// Smoothed difference between consecutive arrival intervals, like RTP's interarrival jitter
+	const u64 now = Common::Timer::GetTimeUs() / 1000;
+	PadArrival& arrival = m_pad_arrivals[pid];
+	if (arrival.last_ms)
+	{
+		const s64 interval = static_cast<s64>(now - arrival.last_ms);
+		if (arrival.last_interval >= 0)
+		{
+			const float deviation = static_cast<float>(std::abs(interval - arrival.last_interval));
+			arrival.jitter += (deviation - arrival.jitter) / 16;
+		}
+		arrival.last_interval = interval;
+	}
+	arrival.last_ms = now;
+
+	std::lock_guard<std::recursive_mutex> lkp(m_crit.players);
+	auto it = m_players.find(pid);
+	if (it != m_players.end())
+		it->second.jitter = arrival.jitter;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayClient::SendPadData()
+{
+	const u64 now = Common::Timer::GetTimeUs() / 1000;
+	sf::Packet spac;
+	spac << static_cast<MessageId>(NP_MSG_PAD_DATA) << m_current_game;
+
+	// All local pads go out in one packet
+	u8 count = 0;
+	sf::Packet entries;
+	{
+		std::lock_guard<std::mutex> lk(m_pad_send_lock);
+		for (PadMapping map = 0; map < 4; ++map)
+		{
+			if (!m_pad_send_queues[map].ShouldSend(now))
+				continue;
+			m_pad_send_queues[map].Write(entries, map, now);
+			++count;
+		}
+	}
+	if (!count)
+		return;
+
+	spac << count;
+	spac.append(entries.getData(), entries.getDataSize());
+	Send(spac, PAD_DATA_CHANNEL);
+}
+
+// called from ---NETPLAY--- thread
+bool NetPlayClient::HasUnackedPadData()
+{
+	std::lock_guard<std::mutex> lk(m_pad_send_lock);
+	return std::any_of(m_pad_send_queues.begin(), m_pad_send_queues.end(),
+		[](const NetPlay::PadSendQueue& queue) { return queue.HasUnacked(); });
 }
 
 void NetPlayClient::DisplayPlayersPing()
@@ -571,8 +699,8 @@ void NetPlayClient::DisplayPlayersPing()
 		return;
 
 	OSD::AddTypedMessage(OSD::MessageType::NetPlayPing,
-		StringFromFormat("Ping: %u", GetPlayersMaxPing()), OSD::Duration::SHORT,
-		OSD::Color::CYAN);
+		StringFromFormat("Ping: %u | Stalls: %u", GetPlayersMaxPing(), GetPadStallCount()),
+		OSD::Duration::SHORT, OSD::Color::CYAN);
 }
 
 u32 NetPlayClient::GetPlayersMaxPing() const
@@ -630,12 +758,15 @@ void NetPlayClient::ThreadFunc()
 		int net;
 		if (m_traversal_client)
 			m_traversal_client->HandleResends();
-		net = enet_host_service(m_client, &netEvent, 250);
+		// Unacknowledged pad data is sent again even if there is no new input
+		net = enet_host_service(m_client, &netEvent,
+			HasUnackedPadData() ? NetPlay::PAD_RESEND_INTERVAL_MS : 250);
 		while (!m_async_queue.Empty())
 		{
 			Send(*(m_async_queue.Front().get()));
 			m_async_queue.Pop();
 		}
+		SendPadData();
 		if (net > 0)
 		{
 			sf::Packet rpac;
@@ -690,7 +821,10 @@ void NetPlayClient::GetPlayerList(std::string& list, std::vector<int>& pid_list)
 		enumerate_player_controller_mappings(m_pad_map, player);
 		enumerate_player_controller_mappings(m_wiimote_map, player);
 
-		ss << " |\nPing: " << player.ping << "ms\n";
+		ss << " |\nPing: " << player.ping << "ms";
+		if (player.pid != m_pid)
+			ss << " | Jitter: " << std::fixed << std::setprecision(1) << player.jitter << "ms";
+		ss << "\n";
 		ss << "Status: ";
 
 		switch (player.game_status)
@@ -741,13 +875,9 @@ void NetPlayClient::SendChatMessage(const std::string& msg)
 // called from ---CPU--- thread
 void NetPlayClient::SendPadState(const PadMapping in_game_pad, const GCPadStatus& pad)
 {
-	auto spac = std::make_unique<sf::Packet>();
-	*spac << static_cast<MessageId>(NP_MSG_PAD_DATA);
-	*spac << in_game_pad;
-	*spac << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
-		<< pad.substickY << pad.triggerLeft << pad.triggerRight;
-
-	SendAsync(std::move(spac));
+	// Sent by the ---NETPLAY--- thread, together with the other local pads
+	std::lock_guard<std::mutex> lk(m_pad_send_lock);
+	m_pad_send_queues[in_game_pad].Push(pad);
 }
 
 // called from ---CPU--- thread
@@ -801,8 +931,6 @@ bool NetPlayClient::StartGame(const std::string& path)
 	m_is_running.Set();
 	NetPlay_Enable(this);
 
-	ClearBuffers();
-
 	if (m_dialog->IsRecording())
 	{
 		if (Movie::IsReadOnly())
@@ -888,6 +1016,15 @@ void NetPlayClient::ClearBuffers()
 		while (m_wiimote_buffer[i].Size())
 			m_wiimote_buffer[i].Pop();
 	}
+
+	{
+		std::lock_guard<std::mutex> lk(m_pad_send_lock);
+		for (NetPlay::PadSendQueue& queue : m_pad_send_queues)
+			queue.Clear();
+	}
+	m_pad_next_seq.fill(0);
+	m_pad_arrivals.clear();
+	m_pad_stalls = 0;
 }
 
 // called from ---NETPLAY--- thread
@@ -913,7 +1050,7 @@ void NetPlayClient::OnConnectReady(ENetAddress addr)
 	if (m_connection_state == ConnectionState::WaitingForTraversalClientConnectReady)
 	{
 		m_connection_state = ConnectionState::Connecting;
-		enet_host_connect(m_client, &addr, 0, 0);
+		enet_host_connect(m_client, &addr, CHANNEL_COUNT, 0);
 	}
 }
 
@@ -965,6 +1102,7 @@ bool NetPlayClient::GetNetPads(const u8 pad_nb, GCPadStatus* pad_status)
 	// clients.
 	if (IsFirstInGamePad(pad_nb))
 	{
+		bool sent = false;
 		const u8 num_local_pads = NumLocalPads();
 		for (u8 local_pad = 0; local_pad < num_local_pads; local_pad++)
 		{
@@ -990,12 +1128,18 @@ bool NetPlayClient::GetNetPads(const u8 pad_nb, GCPadStatus* pad_status)
 
 				// send
 				SendPadState(ingame_pad, *pad_status);
+				sent = true;
 			}
 		}
+
+		if (sent)
+			ENetUtil::WakeupThread(m_client);
 	}
 
 	// Now, we either use the data pushed earlier, or wait for the
 	// other clients to send it to us
+	if (m_pad_buffer[pad_nb].Size() == 0)
+		++m_pad_stalls;
 	while (m_pad_buffer[pad_nb].Size() == 0)
 	{
 		if (!m_is_running.IsSet())
@@ -1237,7 +1381,7 @@ void NetPlayClient::ComputeMD5(const std::string& file_identifier)
 	}
 
 	m_MD5_thread = std::thread([this, file]() {
-		std::string sum = MD5::MD5Sum(file, [&](int progress) {
+		std::string sum = DiscIO::ComputeDiscHash(file, [&](int progress) {
 			sf::Packet spac;
 			spac << static_cast<MessageId>(NP_MSG_MD5_PROGRESS);
 			spac << progress;
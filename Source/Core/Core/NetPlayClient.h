@@ -6,6 +6,7 @@
 
 #include <SFML/Network/Packet.hpp>
 #include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -16,6 +17,7 @@
 #include "Common/Event.h"
 #include "Common/FifoQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayPadQueue.h"
 #include "Core/NetPlayProto.h"
 #include "InputCommon/GCPadStatus.h"
 
@@ -58,6 +60,8 @@ public:
 	std::string name;
 	std::string revision;
 	u32 ping;
+	// Variation in the arrival times of the player's pad data, in ms
+	float jitter = 0;
 	PlayerGameStatus game_status;
 };
 
@@ -100,6 +104,9 @@ public:
 	static void SendTimeBase();
 	bool DoAllPlayersHaveGame();
 
+	// Number of times the game had to wait for pad data since it was started
+	u32 GetPadStallCount() const { return m_pad_stalls; }
+
 protected:
 	void ClearBuffers();
 
@@ -155,9 +162,13 @@ private:
 
 	void UpdateDevices();
 	void SendPadState(const PadMapping in_game_pad, const GCPadStatus& np);
+	void SendPadData();
+	bool HasUnackedPadData();
+	void OnPadData(sf::Packet& packet);
+	void UpdatePadJitter(PlayerId pid);
 	void SendWiimoteState(const PadMapping in_game_pad, const NetWiimote& nw);
 	unsigned int OnData(sf::Packet& packet);
-	void Send(sf::Packet& packet);
+	void Send(sf::Packet& packet, const u8 channel_id = DEFAULT_CHANNEL);
 	void Disconnect();
 	bool Connect();
 	void ComputeMD5(const std::string& file_identifier);
@@ -178,6 +189,20 @@ private:
 	Common::Event m_gc_pad_event;
 	Common::Event m_wii_pad_event;
 
+	// Local pad states are queued by the ---CPU--- thread and sent by the ---NETPLAY--- thread
+	std::mutex m_pad_send_lock;
+	std::array<NetPlay::PadSendQueue, 4> m_pad_send_queues;
+	// Sequence number of the next state expected for every in-game pad
+	std::array<u32, 4> m_pad_next_seq{};
+	struct PadArrival
+	{
+		u64 last_ms = 0;
+		s64 last_interval = -1;
+		float jitter = 0;
+	};
+	std::map<PlayerId, PadArrival> m_pad_arrivals;
+	std::atomic<u32> m_pad_stalls{0};
+
 	u32 m_timebase_frame = 0;
 };
 
@@ -0,0 +1,89 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+
+#include "Core/NetPlayPadQueue.h"
+
+namespace NetPlay
+{
+static void WritePad(sf::Packet& packet, const GCPadStatus& pad)
+{
+	packet << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY << pad.substickX
+		<< pad.substickY << pad.triggerLeft << pad.triggerRight;
+}
+
+static void ReadPad(sf::Packet& packet, GCPadStatus* pad)
+{
+	packet >> pad->button >> pad->analogA >> pad->analogB >> pad->stickX >> pad->stickY >>
+		pad->substickX >> pad->substickY >> pad->triggerLeft >> pad->triggerRight;
+}
+
+void PadSendQueue::Clear()
+{
+	m_states.clear();
+	m_first_seq = 0;
+	m_sent_end = 0;
+	m_last_send_ms = 0;
+}
+
+void PadSendQueue::Push(const GCPadStatus& pad)
+{
+	m_states.push_back(pad);
+}
+
+void PadSendQueue::Ack(u32 next_seq)
+{
+	if (next_seq <= m_first_seq)
+		return;
+
+	const size_t count = std::min<size_t>(next_seq - m_first_seq, m_states.size());
+	m_states.erase(m_states.begin(), m_states.begin() + count);
+	m_first_seq += static_cast<u32>(count);
+	m_sent_end = std::max(m_sent_end, m_first_seq);
+}
+
+size_t PadSendQueue::SendableCount() const
+{
+	return std::min(m_states.size(), MAX_PAD_STATES_PER_PACKET);
+}
+
+bool PadSendQueue::ShouldSend(u64 now_ms) const
+{
+	if (m_sent_end < m_first_seq + SendableCount())
+		return true;
+	return !m_states.empty() && now_ms - m_last_send_ms >= PAD_RESEND_INTERVAL_MS;
+}
+
+void PadSendQueue::Write(sf::Packet& packet, PadMapping map, u64 now_ms)
+{
+	const size_t count = SendableCount();
+	packet << map << m_first_seq << static_cast<u8>(count);
+	for (size_t i = 0; i < count; ++i)
+		WritePad(packet, m_states[i]);
+
+	m_sent_end = m_first_seq + static_cast<u32>(count);
+	m_last_send_ms = now_ms;
+}
+
+size_t PadStates::FirstNew(u32 next_seq) const
+{
+	if (first_seq > next_seq)
+		return states.size();
+	return std::min<size_t>(next_seq - first_seq, states.size());
+}
+
+bool ReadPadStates(sf::Packet& packet, PadStates* out)
+{
+	u8 count = 0;
+	packet >> out->map >> out->first_seq >> count;
+	if (!packet || out->map < 0 || out->map >= 4 || count > MAX_PAD_STATES_PER_PACKET)
+		return false;
+
+	out->states.resize(count);
+	for (GCPadStatus& pad : out->states)
+		ReadPad(packet, &pad);
+	return !!packet;
+}
+}
@@ -0,0 +1,60 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <SFML/Network/Packet.hpp>
+#include <deque>
+#include <vector>
+#include "Common/CommonTypes.h"
+#include "Core/NetPlayProto.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// Upper limit of states repeated in one packet
+const size_t MAX_PAD_STATES_PER_PACKET = 32;
+// Unacknowledged states are sent again after this long without new input
+const u32 PAD_RESEND_INTERVAL_MS = 16;
+
+// States of one in-game pad that still have to reach a peer, numbered from the start of the game.
+//
+// Pad data is sent unreliably. Every packet repeats all states the peer hasn't acknowledged yet,
+// so a lost packet only costs latency if the next one is lost as well.
+class PadSendQueue
+{
+public:
+	void Clear();
+	void Push(const GCPadStatus& pad);
+	// The peer has received everything before next_seq
+	void Ack(u32 next_seq);
+
+	bool HasUnacked() const { return !m_states.empty(); }
+	// True for states that were never sent, or unacknowledged ones that weren't sent for a while
+	bool ShouldSend(u64 now_ms) const;
+	// Appends the oldest unacknowledged states to packet, to be read with ReadPadStates
+	void Write(sf::Packet& packet, PadMapping map, u64 now_ms);
+
+private:
+	size_t SendableCount() const;
+
+	std::deque<GCPadStatus> m_states;
+	u32 m_first_seq = 0;
+	u32 m_sent_end = 0;
+	u64 m_last_send_ms = 0;
+};
+
+struct PadStates
+{
+	PadMapping map;
+	u32 first_seq;
+	std::vector<GCPadStatus> states;
+
+	// Index of the first state at or after next_seq, or states.size() if there is none. The states
+	// can't be used if they start after next_seq, since the ones in between are missing.
+	size_t FirstNew(u32 next_seq) const;
+};
+
+bool ReadPadStates(sf::Packet& packet, PadStates* out);
+}
@@ -45,6 +45,7 @@ enum
 	NP_MSG_PAD_DATA = 0x60,
 	NP_MSG_PAD_MAPPING = 0x61,
 	NP_MSG_PAD_BUFFER = 0x62,
+	NP_MSG_PAD_ACK = 0x63,
 
 	NP_MSG_WIIMOTE_DATA = 0x70,
 	NP_MSG_WIIMOTE_MAPPING = 0x71,
@@ -81,6 +82,14 @@ enum
 	CON_ERR_VERSION_MISMATCH = 3
 };
 
+enum
+{
+	DEFAULT_CHANNEL = 0,
+	// Pad data and its acknowledgements, sent unreliably
+	PAD_DATA_CHANNEL = 1,
+	CHANNEL_COUNT = 3
+};
+
 using NetWiimote = std::vector<u8>;
 using MessageId = u8;
 using PlayerId = u8;
@@ -3,6 +3,8 @@
 // Refer to the license.txt file included.
 
 #include "Core/NetPlayServer.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
@@ -86,7 +88,7 @@ NetPlayServer::NetPlayServer(const u16 port, bool traversal, const std::string&
 		ENetAddress serverAddr;
 		serverAddr.host = ENET_HOST_ANY;
 		serverAddr.port = port;
-		m_server = enet_host_create(&serverAddr, 10, 3, 0, 0);
+		m_server = enet_host_create(&serverAddr, 10, CHANNEL_COUNT, 0, 0);
 		if (m_server != nullptr)
 			m_server->intercept = ENetUtil::InterceptCallback;
 	}
@@ -107,6 +109,10 @@ void NetPlayServer::ThreadFunc()
 		// update pings every so many seconds
 		if ((m_ping_timer.GetTimeElapsed() > 1000) || m_update_pings)
 		{
+			// based on the answers to the last round
+			if (m_auto_pad_buffer)
+				UpdateAutoPadBuffer();
+
 			m_ping_key = Common::Timer::GetTimeMs();
 
 			sf::Packet spac;
@@ -122,7 +128,9 @@ void NetPlayServer::ThreadFunc()
 		int net;
 		if (m_traversal_client)
 			m_traversal_client->HandleResends();
-		net = enet_host_service(m_server, &netEvent, 1000);
+		// Unacknowledged pad data is sent again even if there is no new input
+		net = enet_host_service(m_server, &netEvent,
+			HasUnackedPadData() ? NetPlay::PAD_RESEND_INTERVAL_MS : 1000);
 		while (!m_async_queue.Empty())
 		{
 			{
@@ -204,6 +212,8 @@ void NetPlayServer::ThreadFunc()
 				break;
 			}
 		}
+
+		SendPadData();
 	}
 
 	// close listening socket and client sockets
@@ -461,6 +471,40 @@ void NetPlayServer::AdjustPadBufferSize(unsigned int size)
 	SendAsyncToClients(std::move(spac));
 }
 
+// called from ---GUI--- thread
+void NetPlayServer::SetAutoPadBuffer(bool enabled)
+{
+	std::lock_guard<std::recursive_mutex> lkg(m_crit.game);
+	m_auto_pad_buffer = enabled;
+	m_pad_buffer_controller.Reset(m_target_buffer_size);
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::UpdateAutoPadBuffer()
+{
+	std::lock_guard<std::recursive_mutex> lkg(m_crit.game);
+
+	// Everyone waits for the others while the game boots, which says nothing about the connection
+	const bool booting = !m_is_running || Common::Timer::GetTimeMs() - m_current_game < 10000;
+
+	std::vector<NetPlay::PadBufferController::PeerSample> peers;
+	for (auto& p : m_players)
+	{
+		Client& client = p.second;
+		if (!client.pid || !client.has_ping)
+			continue;
+		peers.push_back({client.ping, std::max(client.ping_jitter, client.pad_jitter),
+			client.stalled && !booting});
+		client.stalled = false;
+	}
+	if (peers.empty())
+		return;
+
+	const u32 size = m_pad_buffer_controller.Update(peers);
+	if (size != m_target_buffer_size)
+		AdjustPadBufferSize(size);
+}
+
 void NetPlayServer::SendAsyncToClients(std::unique_ptr<sf::Packet> packet)
 {
 	{
@@ -497,32 +541,10 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 	break;
 
 	case NP_MSG_PAD_DATA:
-	{
-		// if this is pad data from the last game still being received, ignore it
-		if (player.current_game != m_current_game)
-			break;
-
-		PadMapping map = 0;
-		GCPadStatus pad;
-		packet >> map >> pad.button >> pad.analogA >> pad.analogB >> pad.stickX >> pad.stickY >>
-			pad.substickX >> pad.substickY >> pad.triggerLeft >> pad.triggerRight;
+		return OnPadData(packet, player);
 
-		// If the data is not from the correct player,
-		// then disconnect them.
-		if (m_pad_map.at(map) != player.pid)
-		{
-			return 1;
-		}
-
-		// Relay to clients
-		sf::Packet spac;
-		spac << (MessageId)NP_MSG_PAD_DATA;
-		spac << map << pad.button << pad.analogA << pad.analogB << pad.stickX << pad.stickY
-			<< pad.substickX << pad.substickY << pad.triggerLeft << pad.triggerRight;
-
-		SendToClients(spac, player.pid);
-	}
-	break;
+	case NP_MSG_PAD_ACK:
+		return OnPadAck(packet, player);
 
 	case NP_MSG_WIIMOTE_DATA:
 	{
@@ -560,13 +582,24 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
 	{
 		const u32 ping = (u32)m_ping_timer.GetTimeElapsed();
 		u32 ping_key = 0;
-		packet >> ping_key;
+		u32 pad_stalls = 0;
+		packet >> ping_key >> pad_stalls >> player.pad_jitter;
 
 		if (m_ping_key == ping_key)
 		{
+			if (player.has_ping)
+			{
+				const float deviation = std::abs(static_cast<float>(ping) - static_cast<float>(player.ping));
+				player.ping_jitter += (deviation - player.ping_jitter) / 8;
+			}
 			player.ping = ping;
+			player.has_ping = true;
 		}
 
+		// any change counts, since the client's count starts over with every game
+		player.stalled |= pad_stalls != player.pad_stalls;
+		player.pad_stalls = pad_stalls;
+
 		sf::Packet spac;
 		spac << (MessageId)NP_MSG_PLAYER_PING_DATA;
 		spac << player.pid;
@@ -831,11 +864,131 @@ void NetPlayServer::SendToClients(sf::Packet& packet, const PlayerId skip_pid)
 	}
 }
 
-void NetPlayServer::Send(ENetPeer* socket, sf::Packet& packet)
+void NetPlayServer::Send(ENetPeer* socket, sf::Packet& packet, const u8 channel_id)
 {
 	ENetPacket* epac =
-		enet_packet_create(packet.getData(), packet.getDataSize(), ENET_PACKET_FLAG_RELIABLE);
-	enet_peer_send(socket, 0, epac);
+		enet_packet_create(packet.getData(), packet.getDataSize(),
+			channel_id == PAD_DATA_CHANNEL ? 0 : ENET_PACKET_FLAG_RELIABLE);
+	enet_peer_send(socket, channel_id, epac);
+}
+
+// called from ---NETPLAY--- thread
+unsigned int NetPlayServer::OnPadData(sf::Packet& packet, Client& player)
+{
+	u32 game;
+	u8 count = 0;
+	packet >> game >> count;
+
+	// if this is pad data from the last game still being received, ignore it. Data of the current
+	// game is sent again until it is acknowledged.
+	if (player.current_game != m_current_game || game != m_current_game)
+		return 0;
+	if (m_pad_game != m_current_game)
+		ResetPadData();
+
+	sf::Packet ack;
+	ack << static_cast<MessageId>(NP_MSG_PAD_ACK) << game << count;
+
+	NetPlay::PadStates data;
+	for (u8 i = 0; i < count; ++i)
+	{
+		// If the data is not from the correct player,
+		// then disconnect them.
+		if (!NetPlay::ReadPadStates(packet, &data) || m_pad_map[data.map] != player.pid)
+			return 1;
+
+		// Queue the new states for everyone else
+		u32& next_seq = m_pad_next_seq[data.map];
+		const size_t first_new = data.FirstNew(next_seq);
+		for (auto& p : m_players)
+		{
+			if (!p.second.pid || p.second.pid == player.pid)
+				continue;
+			for (size_t j = first_new; j < data.states.size(); ++j)
+				p.second.pad_queues[data.map].Push(data.states[j]);
+		}
+		next_seq += static_cast<u32>(data.states.size() - first_new);
+		ack << data.map << next_seq;
+	}
+
+	Send(player.socket, ack, PAD_DATA_CHANNEL);
+	return 0;
+}
+
+// called from ---NETPLAY--- thread
+unsigned int NetPlayServer::OnPadAck(sf::Packet& packet, Client& player)
+{
+	u32 game;
+	u8 count = 0;
+	packet >> game >> count;
+	if (game != m_pad_game)
+		return 0;
+
+	for (u8 i = 0; i < count; ++i)
+	{
+		PadMapping map = 0;
+		u32 next_seq = 0;
+		packet >> map >> next_seq;
+		if (!packet || map < 0 || map >= 4)
+			return 1;
+		player.pad_queues[map].Ack(next_seq);
+	}
+	return 0;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::ResetPadData()
+{
+	m_pad_game = m_current_game;
+	m_pad_next_seq.fill(0);
+	for (auto& p : m_players)
+	{
+		for (NetPlay::PadSendQueue& queue : p.second.pad_queues)
+			queue.Clear();
+	}
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::SendPadData()
+{
+	if (m_pad_game != m_current_game)
+		ResetPadData();
+
+	// All pads a client is missing go out in one packet
+	const u64 now = Common::Timer::GetTimeUs() / 1000;
+	for (auto& p : m_players)
+	{
+		u8 count = 0;
+		sf::Packet entries;
+		for (PadMapping map = 0; map < 4; ++map)
+		{
+			if (!p.second.pad_queues[map].ShouldSend(now))
+				continue;
+			p.second.pad_queues[map].Write(entries, map, now);
+			++count;
+		}
+		if (!count)
+			continue;
+
+		sf::Packet spac;
+		spac << static_cast<MessageId>(NP_MSG_PAD_DATA) << m_pad_game << count;
+		spac.append(entries.getData(), entries.getDataSize());
+		Send(p.second.socket, spac, PAD_DATA_CHANNEL);
+	}
+}
+
+// called from ---NETPLAY--- thread
+bool NetPlayServer::HasUnackedPadData() const
+{
+	for (const auto& p : m_players)
+	{
+		for (const NetPlay::PadSendQueue& queue : p.second.pad_queues)
+		{
+			if (queue.HasUnacked())
+				return true;
+		}
+	}
+	return false;
 }
 
 void NetPlayServer::KickPlayer(PlayerId player)
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <SFML/Network/Packet.hpp>
+#include <array>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -15,6 +16,8 @@
 #include "Common/FifoQueue.h"
 #include "Common/Timer.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayBufferController.h"
+#include "Core/NetPlayPadQueue.h"
 #include "Core/NetPlayProto.h"
 
 enum class PlayerGameStatus;
@@ -47,6 +50,8 @@ public:
 	void SetWiimoteMapping(const PadMappingArray& mappings);
 
 	void AdjustPadBufferSize(unsigned int size);
+	// Lets the server pick the pad buffer size from the players' ping and jitter
+	void SetAutoPadBuffer(bool enabled);
 
 	void KickPlayer(PlayerId player);
 
@@ -75,11 +80,27 @@ private:
 		u32 ping;
 		u32 current_game;
 
+		// Pad data of the other players that this client hasn't acknowledged yet
+		std::array<NetPlay::PadSendQueue, 4> pad_queues;
+
+		// Connection quality for the automatic pad buffer
+		bool has_ping = false;
+		float ping_jitter = 0;
+		float pad_jitter = 0;
+		u32 pad_stalls = 0;
+		bool stalled = false;
+
 		bool operator==(const Client& other) const { return this == &other; }
 	};
 
 	void SendToClients(sf::Packet& packet, const PlayerId skip_pid = 0);
-	void Send(ENetPeer* socket, sf::Packet& packet);
+	void Send(ENetPeer* socket, sf::Packet& packet, const u8 channel_id = DEFAULT_CHANNEL);
+	unsigned int OnPadData(sf::Packet& packet, Client& player);
+	unsigned int OnPadAck(sf::Packet& packet, Client& player);
+	void ResetPadData();
+	void UpdateAutoPadBuffer();
+	void SendPadData();
+	bool HasUnackedPadData() const;
 	unsigned int OnConnect(ENetPeer* socket);
 	unsigned int OnDisconnect(Client& player);
 	unsigned int OnData(sf::Packet& packet, Client& player);
@@ -100,8 +121,13 @@ private:
 	bool m_update_pings = false;
 	u32 m_current_game = 0;
 	unsigned int m_target_buffer_size = 0;
+	bool m_auto_pad_buffer = false;
+	NetPlay::PadBufferController m_pad_buffer_controller;
 	PadMappingArray m_pad_map;
 	PadMappingArray m_wiimote_map;
+	// Game the relayed pad data belongs to, and the next state expected of every in-game pad
+	u32 m_pad_game = 0;
+	std::array<u32, 4> m_pad_next_seq{};
 
 	std::map<PlayerId, Client> m_players;
 
@@ -42,6 +42,7 @@ const char* PatchTypeStrings[] = {
 
 static std::vector<Patch> onFrame;
 static std::map<u32, int> speedHacks;
+static std::set<u32> idleSkipExclusions;
 
 void LoadPatchSection(const std::string& section, std::vector<Patch>& patches, IniFile& globalIni,
 	IniFile& localIni)
@@ -147,6 +148,23 @@ static void LoadSpeedhacks(const std::string& section, IniFile& ini)
 	}
 }
 
+static void LoadIdleSkipExclusions(const std::string& section, IniFile& ini)
+{
+	std::vector<std::string> lines;
+	ini.GetLines(section, &lines);
+	for (const std::string& line : lines)
+	{
+		u32 address;
+		if (TryParse(line, &address))
+			idleSkipExclusions.insert(address);
+	}
+}
+
+bool IsIdleSkipExcluded(const u32 addr)
+{
+	return idleSkipExclusions.count(addr) != 0;
+}
+
 int GetSpeedhackCycles(const u32 addr)
 {
 	std::map<u32, int>::const_iterator iter = speedHacks.find(addr);
@@ -171,6 +189,7 @@ void LoadPatches()
 	Gecko::SetActiveCodes(gcodes);
 
 	LoadSpeedhacks("Speedhacks", merged);
+	LoadIdleSkipExclusions("IdleSkipExclusions", merged);
 }
 
 static void ApplyPatches(const std::vector<Patch>& patches)
@@ -232,6 +251,7 @@ void Shutdown()
 {
 	onFrame.clear();
 	speedHacks.clear();
+	idleSkipExclusions.clear();
 	ActionReplay::ApplyCodes({});
 	Gecko::SetActiveCodes({});
 }
@@ -43,6 +43,9 @@ struct Patch
 };
 
 int GetSpeedhackCycles(const u32 addr);
+// Start addresses of polling loops which must not be skipped by the JIT, listed
+// one per line in the [IdleSkipExclusions] section of the game INI.
+bool IsIdleSkipExcluded(const u32 addr);
 void LoadPatchSection(const std::string& section, std::vector<Patch> &patches,
 	IniFile &globalIni, IniFile &localIni);
 void LoadPatches();
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include "Core/PowerPC/CachedInterpreter.h"
+#include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -10,6 +11,7 @@
 #include "Core/HLE/HLE.h"
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -17,7 +19,7 @@ void CachedInterpreter::Init()
 {
 	m_code.reserve(CODE_SIZE / sizeof(Instruction));
 
-	jo.enableBlocklink = false;
+	jo.enableBlocklink = !SConfig::GetInstance().bJITNoBlockLinking;
 
 	JitBaseBlockCache::Init();
 	UpdateMemoryOptions();
@@ -32,12 +34,12 @@ void CachedInterpreter::Shutdown()
 	JitBaseBlockCache::Shutdown();
 }
 
-void CachedInterpreter::ExecuteOneBlock()
+void CachedInterpreter::ExecuteOneBlock(bool allow_chaining)
 {
 	const u8* normal_entry = JitBaseBlockCache::Dispatch();
 	const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
 
-	for (; code->type != Instruction::INSTRUCTION_ABORT; ++code)
+	while (code->type != Instruction::INSTRUCTION_ABORT)
 	{
 		switch (code->type)
 		{
@@ -50,10 +52,27 @@ void CachedInterpreter::ExecuteOneBlock()
 				return;
 			break;
 
+		case Instruction::INSTRUCTION_TYPE_PREDECODED:
+			code->predecoded_callback(code->operands);
+			break;
+
+		case Instruction::INSTRUCTION_TYPE_LINK:
+			// Continue straight into the linked block instead of going back through the
+			// dispatcher, as long as the timeslice hasn't run out.
+			if (allow_chaining && code->link.destination && PC == code->link.address &&
+				(MSR & JitBlock::JIT_CACHE_MSR_MASK) == code->link.msr_bits &&
+				PowerPC::ppcState.downcount > 0)
+			{
+				code = code->link.destination;
+				continue;
+			}
+			break;
+
 		default:
 			ERROR_LOG(POWERPC, "Unknown CachedInterpreter Instruction: %d", code->type);
 			break;
 		}
+		++code;
 	}
 }
 
@@ -67,7 +86,7 @@ void CachedInterpreter::Run()
 
 		do
 		{
-			ExecuteOneBlock();
+			ExecuteOneBlock(true);
 		} while (PowerPC::ppcState.downcount > 0);
 	}
 }
@@ -76,7 +95,7 @@ void CachedInterpreter::SingleStep()
 {
 	// Enter new timing slice
 	CoreTiming::Advance();
-	ExecuteOneBlock();
+	ExecuteOneBlock(false);
 }
 
 static void EndBlock(UGeckoInstruction data)
@@ -120,6 +139,188 @@ static bool CheckDSI(u32 data)
 	return false;
 }
 
+static void Addi(const CachedInterpreter::Operands& op)
+{
+	rGPR[op.rd] = (op.ra ? rGPR[op.ra] : 0) + op.imm;
+}
+
+static void Ori(const CachedInterpreter::Operands& op)
+{
+	rGPR[op.rd] = rGPR[op.ra] | op.imm;
+}
+
+static void Rlwinm(const CachedInterpreter::Operands& op)
+{
+	rGPR[op.rd] = _rotl(rGPR[op.ra], op.sh) & op.imm2;
+}
+
+static void Cmpi(const CachedInterpreter::Operands& op)
+{
+	Interpreter::Helper_UpdateCRx(op.rd2, rGPR[op.ra] - op.imm);
+}
+
+static void Cmpli(const CachedInterpreter::Operands& op)
+{
+	u32 a = rGPR[op.ra];
+	int f;
+	if (a < op.imm)
+		f = 0x8;
+	else if (a > op.imm)
+		f = 0x4;
+	else
+		f = 0x2;
+	if (GetXER_SO())
+		f |= 0x1;
+	SetCRField(op.rd2, f);
+}
+
+static void RlwinmCmpi(const CachedInterpreter::Operands& op)
+{
+	u32 result = _rotl(rGPR[op.ra], op.sh) & op.imm2;
+	rGPR[op.rd] = result;
+	Interpreter::Helper_UpdateCRx(op.rd2, result - op.imm);
+}
+
+static void RlwinmCmpli(const CachedInterpreter::Operands& op)
+{
+	u32 result = _rotl(rGPR[op.ra], op.sh) & op.imm2;
+	rGPR[op.rd] = result;
+	int f;
+	if (result < op.imm)
+		f = 0x8;
+	else if (result > op.imm)
+		f = 0x4;
+	else
+		f = 0x2;
+	if (GetXER_SO())
+		f |= 0x1;
+	SetCRField(op.rd2, f);
+}
+
+static void Lwz(const CachedInterpreter::Operands& op)
+{
+	u32 temp = PowerPC::Read_U32((op.ra ? rGPR[op.ra] : 0) + op.imm);
+	if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+		rGPR[op.rd] = temp;
+}
+
+static void LwzPair(const CachedInterpreter::Operands& op)
+{
+	u32 base = op.ra ? rGPR[op.ra] : 0;
+	u32 temp = PowerPC::Read_U32(base + op.imm);
+	if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+		rGPR[op.rd] = temp;
+	temp = PowerPC::Read_U32(base + op.imm2);
+	if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+		rGPR[op.rd2] = temp;
+}
+
+static void Stw(const CachedInterpreter::Operands& op)
+{
+	PowerPC::Write_U32(rGPR[op.rd], (op.ra ? rGPR[op.ra] : 0) + op.imm);
+}
+
+// Emits a handler with pre-decoded operands for ops[index] if it is one of the
+// common integer instructions, possibly fused with the instruction following it.
+// Returns the number of instructions consumed, or 0 if the generic interpreter
+// handler has to be used.
+u32 CachedInterpreter::EmitPredecoded(const PPCAnalyst::CodeOp* ops, u32 index)
+{
+	const UGeckoInstruction inst = ops[index].inst;
+	Operands op = {};
+
+	// Only fuse with the next instruction if nothing can observe the state in between.
+	const PPCAnalyst::CodeOp* next = nullptr;
+	if (index + 1 < code_block.m_num_instructions && !ops[index + 1].skip &&
+		!(ops[index + 1].opinfo->flags & FL_ENDBLOCK) && !jo.memcheck &&
+		HLE::GetFunctionIndex(ops[index + 1].address) == 0)
+	{
+		next = &ops[index + 1];
+	}
+
+	switch (inst.OPCD)
+	{
+	case 14:  // addi
+	case 15:  // addis
+		op.rd = inst.RD;
+		op.ra = inst.RA;
+		op.imm = inst.OPCD == 15 ? (u32)inst.SIMM_16 << 16 : (u32)(s32)inst.SIMM_16;
+		m_code.emplace_back(Addi, op);
+		return 1;
+
+	case 24:  // ori
+	case 25:  // oris
+		op.rd = inst.RA;
+		op.ra = inst.RS;
+		op.imm = inst.OPCD == 25 ? inst.UIMM << 16 : inst.UIMM;
+		m_code.emplace_back(Ori, op);
+		return 1;
+
+	case 10:  // cmpli
+	case 11:  // cmpi
+		op.ra = inst.RA;
+		op.rd2 = inst.CRFD;
+		op.imm = inst.OPCD == 11 ? (u32)(s32)inst.SIMM_16 : inst.UIMM;
+		m_code.emplace_back(inst.OPCD == 11 ? Cmpi : Cmpli, op);
+		return 1;
+
+	case 21:  // rlwinmx
+		if (inst.Rc)
+			return 0;
+		op.rd = inst.RA;
+		op.ra = inst.RS;
+		op.sh = inst.SH;
+		op.imm2 = Interpreter::Helper_Mask(inst.MB, inst.ME);
+		if (next && (next->inst.OPCD == 10 || next->inst.OPCD == 11) && next->inst.RA == inst.RA)
+		{
+			op.rd2 = next->inst.CRFD;
+			op.imm = next->inst.OPCD == 11 ? (u32)(s32)next->inst.SIMM_16 : next->inst.UIMM;
+			m_code.emplace_back(next->inst.OPCD == 11 ? RlwinmCmpi : RlwinmCmpli, op);
+			return 2;
+		}
+		m_code.emplace_back(Rlwinm, op);
+		return 1;
+
+	case 32:  // lwz
+		op.rd = inst.RD;
+		op.ra = inst.RA;
+		op.imm = (u32)(s32)inst.SIMM_16;
+		// Loads off the same base register, as in structure member accesses. The first load
+		// must not overwrite the base, and both must land in different registers.
+		if (next && next->inst.OPCD == 32 && next->inst.RA == inst.RA && inst.RD != inst.RA &&
+			next->inst.RD != inst.RD)
+		{
+			op.rd2 = next->inst.RD;
+			op.imm2 = (u32)(s32)next->inst.SIMM_16;
+			m_code.emplace_back(LwzPair, op);
+			return 2;
+		}
+		m_code.emplace_back(Lwz, op);
+		return 1;
+
+	case 36:  // stw
+		op.rd = inst.RS;
+		op.ra = inst.RA;
+		op.imm = (u32)(s32)inst.SIMM_16;
+		m_code.emplace_back(Stw, op);
+		return 1;
+
+	default:
+		return 0;
+	}
+}
+
+void CachedInterpreter::EmitLink(u32 exit_address)
+{
+	m_code.emplace_back(exit_address);
+
+	JitBlock::LinkData linkData;
+	linkData.exitAddress = exit_address;
+	linkData.exitPtrs = reinterpret_cast<u8*>(&m_code.back());
+	linkData.linkStatus = false;
+	js.curBlock->linkData.push_back(linkData);
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
 	if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 || IsFull() ||
@@ -149,6 +350,7 @@ void CachedInterpreter::Jit(u32 address)
 	js.curBlock = b;
 
 	PPCAnalyst::CodeOp* ops = code_buffer.codebuffer;
+	bool hle_replaced = false;
 
 	b->checkedEntry = GetCodePtr();
 	b->normalEntry = GetCodePtr();
@@ -173,6 +375,7 @@ void CachedInterpreter::Jit(u32 address)
 					{
 						m_code.emplace_back(EndBlock, js.downcountAmount);
 						m_code.emplace_back();
+						hle_replaced = true;
 						break;
 					}
 				}
@@ -194,7 +397,14 @@ void CachedInterpreter::Jit(u32 address)
 
 			if (endblock || memcheck)
 				m_code.emplace_back(WritePC, ops[i].address);
-			m_code.emplace_back(GetInterpreterOp(ops[i].inst), ops[i].inst);
+
+			u32 consumed = endblock ? 0 : EmitPredecoded(ops, i);
+			if (consumed == 0)
+				m_code.emplace_back(GetInterpreterOp(ops[i].inst), ops[i].inst);
+
+			// The fused instruction still counts towards the block's cycles.
+			for (u32 j = 1; j < consumed; j++)
+				js.downcountAmount += ops[++i].opinfo->numCycles;
 			if (memcheck)
 				m_code.emplace_back(CheckDSI, js.downcountAmount);
 			if (endblock)
@@ -206,6 +416,25 @@ void CachedInterpreter::Jit(u32 address)
 		m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
 		m_code.emplace_back(EndBlock, js.downcountAmount);
 	}
+
+	if (jo.enableBlocklink && !hle_replaced && code_block.m_num_instructions > 0)
+	{
+		const PPCAnalyst::CodeOp& last = ops[code_block.m_num_instructions - 1];
+		const UGeckoInstruction inst = last.inst;
+		if (code_block.m_broken)
+		{
+			EmitLink(nextPC);
+		}
+		else if (inst.OPCD == 18)  // bx
+		{
+			EmitLink(inst.AA ? SignExt26(inst.LI << 2) : last.address + SignExt26(inst.LI << 2));
+		}
+		else if (inst.OPCD == 16)  // bcx, taken and fall-through paths
+		{
+			EmitLink(inst.AA ? SignExt16(inst.BD << 2) : last.address + SignExt16(inst.BD << 2));
+			EmitLink(last.address + 4);
+		}
+	}
 	m_code.emplace_back();
 
 	b->codeSize = (u32)(GetCodePtr() - b->checkedEntry);
@@ -214,6 +443,13 @@ void CachedInterpreter::Jit(u32 address)
 	FinalizeBlock(block_num, jo.enableBlocklink, b->checkedEntry);
 }
 
+void CachedInterpreter::WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest)
+{
+	Instruction* link = reinterpret_cast<Instruction*>(source.exitPtrs);
+	link->link.destination = dest ? reinterpret_cast<const Instruction*>(dest->normalEntry) : nullptr;
+	link->link.msr_bits = dest ? dest->msrBits : 0;
+}
+
 void CachedInterpreter::ClearCache()
 {
 	m_code.clear();
@@ -28,35 +28,74 @@ public:
 
 	JitBaseBlockCache* GetBlockCache() override { return this; }
 	const char* GetName() override { return "Cached Interpreter"; }
-	void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override {}
+	void WriteLinkBlock(const JitBlock::LinkData& source, const JitBlock* dest) override;
 	const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
+
+	// Operands of an instruction decoded at block compile time, so that hot
+	// handlers don't need to pick apart the instruction word on every execution.
+	// Fused handlers use the second set of fields for the following instruction.
+	struct Operands
+	{
+		u8 rd;
+		u8 ra;
+		u8 sh;
+		u8 rd2;  // second destination register or CR field for fused handlers
+		u32 imm;
+		u32 imm2;  // rotation mask or immediate of the fused instruction
+	};
+
 private:
 	struct Instruction
 	{
 		typedef void(*CommonCallback)(UGeckoInstruction);
 		typedef bool(*ConditionalCallback)(u32 data);
+		typedef void(*PredecodedCallback)(const Operands& operands);
 
 		Instruction() : type(INSTRUCTION_ABORT){};
 		Instruction(const CommonCallback c, UGeckoInstruction i)
 			: common_callback(c), data(i.hex), type(INSTRUCTION_TYPE_COMMON){};
 		Instruction(const ConditionalCallback c, u32 d)
 			: conditional_callback(c), data(d), type(INSTRUCTION_TYPE_CONDITIONAL){};
+		Instruction(const PredecodedCallback c, const Operands& o)
+			: predecoded_callback(c), operands(o), type(INSTRUCTION_TYPE_PREDECODED){};
+		explicit Instruction(u32 exit_address) : common_callback(nullptr), type(INSTRUCTION_TYPE_LINK)
+		{
+			link.destination = nullptr;
+			link.address = exit_address;
+			link.msr_bits = 0;
+		};
 
 		union {
 			const CommonCallback common_callback;
 			const ConditionalCallback conditional_callback;
+			const PredecodedCallback predecoded_callback;
+		};
+		union {
+			u32 data;
+			Operands operands;
+			// Block exit which jumps straight into the next block if it has
+			// been compiled. Written by WriteLinkBlock.
+			struct
+			{
+				const Instruction* destination;
+				u32 address;
+				u32 msr_bits;
+			} link;
 		};
-		u32 data;
 		enum
 		{
 			INSTRUCTION_ABORT,
 			INSTRUCTION_TYPE_COMMON,
 			INSTRUCTION_TYPE_CONDITIONAL,
+			INSTRUCTION_TYPE_PREDECODED,
+			INSTRUCTION_TYPE_LINK,
 		} type;
 	};
 
 	const u8* GetCodePtr() { return (u8*)(m_code.data() + m_code.size()); }
-	void ExecuteOneBlock();
+	void ExecuteOneBlock(bool allow_chaining);
+	u32 EmitPredecoded(const PPCAnalyst::CodeOp* ops, u32 index);
+	void EmitLink(u32 exit_address);
 
 	std::vector<Instruction> m_code;
 	PPCAnalyst::CodeBuffer code_buffer;
@@ -280,12 +280,13 @@ public:
 	static void RunTable63(UGeckoInstruction _instCode);
 
 	static u32 Helper_Carry(u32 _uValue1, u32 _uValue2);
+	static u32 Helper_Mask(int mb, int me);
+	static void Helper_UpdateCRx(int _x, u32 _uValue);
 
 private:
 	// flag helper
 	static void Helper_UpdateCR0(u32 _uValue);
 	static void Helper_UpdateCR1();
-	static void Helper_UpdateCRx(int _x, u32 _uValue);
 
 	// address helper
 	static u32 Helper_Get_EA(const UGeckoInstruction _inst);
@@ -298,8 +299,6 @@ private:
 	static void Helper_Quantize(u32 addr, u32 instI, u32 instRS, u32 instW);
 
 	// other helper
-	static u32 Helper_Mask(int mb, int me);
-
 	static void Helper_FloatCompareOrdered(UGeckoInstruction _inst, double a, double b);
 	static void Helper_FloatCompareUnordered(UGeckoInstruction _inst, double a, double b);
 
@@ -15,6 +15,7 @@
 #include "Common/MemoryUtil.h"
 #include "Common/StringUtil.h"
 #include "Common/x64ABI.h"
+#include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -247,6 +248,9 @@ void Jit64::Init()
 	farcode.Init(jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE);
 	Clear();
 
+	m_code_segment = 0;
+	m_num_recycled_segments = 0;
+
 	code_block.m_stats = &js.st;
 	code_block.m_gpa = &js.gpa;
 	code_block.m_fpa = &js.fpa;
@@ -261,6 +265,65 @@ void Jit64::ClearCache()
 	ClearCodeSpace();
 	Clear();
 	UpdateMemoryOptions();
+	m_code_segment = 0;
+}
+
+bool Jit64::IsCodeSegmentFull() const
+{
+	const size_t near_size = GetRegionSize() / NUM_CODE_SEGMENTS;
+	const size_t far_size = farcode.GetRegionSize() / NUM_CODE_SEGMENTS;
+	const u8* near_end = GetRegion() + near_size * (m_code_segment + 1);
+	const u8* far_end = farcode.GetRegion() + far_size * (m_code_segment + 1);
+
+	// Same margin as CodeBlock::IsAlmostFull; this should be bigger than the biggest block ever.
+	return near_end - GetCodePtr() < 0x10000 || far_end - farcode.GetCodePtr() < 0x10000;
+}
+
+void Jit64::RecycleNextCodeSegment()
+{
+	m_code_segment = (m_code_segment + 1) % NUM_CODE_SEGMENTS;
+
+	const size_t near_size = GetRegionSize() / NUM_CODE_SEGMENTS;
+	const size_t far_size = farcode.GetRegionSize() / NUM_CODE_SEGMENTS;
+	u8* near_begin = GetRegion() + near_size * m_code_segment;
+	u8* far_begin = farcode.GetRegion() + far_size * m_code_segment;
+
+	// Far code is only ever emitted alongside its block's near code, so it lives in the segment
+	// with the same index and goes away together with the blocks.
+	int num_evicted = blocks.EvictCode(near_begin, near_begin + near_size);
+
+	// Backpatch info is keyed by code location. Drop the entries of the evicted code, so that a
+	// fault in new code emitted there can't be patched with another block's info.
+	auto in_segment = [&](const u8* location) {
+		return (location >= near_begin && location < near_begin + near_size) ||
+			(location >= far_begin && location < far_begin + far_size);
+	};
+	for (auto it = backPatchInfo.begin(); it != backPatchInfo.end();)
+	{
+		if (in_segment(it->first))
+			it = backPatchInfo.erase(it);
+		else
+			++it;
+	}
+	for (auto it = exceptionHandlerAtLoc.begin(); it != exceptionHandlerAtLoc.end();)
+	{
+		if (in_segment(it->first))
+			it = exceptionHandlerAtLoc.erase(it);
+		else
+			++it;
+	}
+
+	// Poison the space like ClearCodeSpace does, so stray jumps into it trap.
+	memset(near_begin, 0xCC, near_size);
+	memset(far_begin, 0xCC, far_size);
+	SetCodePtr(near_begin);
+	farcode.SetCodePtr(far_begin);
+
+	m_num_recycled_segments++;
+	INFO_LOG(DYNA_REC, "Recycled JIT code segment %d: %d blocks evicted (%u segments recycled, "
+		"%zu/%zu bytes of trampolines used)",
+		m_code_segment, num_evicted, m_num_recycled_segments,
+		trampolines.GetRegionSize() - trampolines.GetSpaceLeft(), trampolines.GetRegionSize());
 }
 
 void Jit64::Shutdown()
@@ -274,8 +337,36 @@ void Jit64::Shutdown()
 	farcode.Shutdown();
 }
 
+bool Jit64::IsGatherPipeStore(const PPCAnalyst::CodeOp& op)
+{
+	// The D-form stores which take the WriteToConstAddress path with the current register state
+	switch (op.inst.OPCD)
+	{
+	case 36:  // stw
+	case 37:  // stwu
+	case 38:  // stb
+	case 39:  // stbu
+	case 44:  // sth
+	case 45:  // sthu
+	case 52:  // stfs
+	case 53:  // stfsu
+	case 54:  // stfd
+	case 55:  // stfdu
+		break;
+	default:
+		return false;
+	}
+
+	int a = op.inst.RA;
+	if (a && !gpr.R(a).IsImm())
+		return false;
+	u32 address = (a ? gpr.R(a).Imm32() : 0) + (s32)(s16)op.inst.SIMM_16;
+	return jo.optimizeGatherPipe && PowerPC::IsOptimizableGatherPipeWrite(address);
+}
+
 void Jit64::FallBackToInterpreter(UGeckoInstruction inst)
 {
+	FlushGatherPipeWrites();
 	gpr.Flush();
 	fpr.Flush();
 	if (js.op->opinfo->flags & FL_ENDBLOCK)
@@ -349,6 +440,9 @@ bool Jit64::Cleanup()
 {
 	bool did_something = false;
 
+	// Exits can be taken in the middle of a run of gather pipe writes
+	FlushGatherPipeWrites(true);
+
 	if (jo.optimizeGatherPipe && js.fifoBytesThisBlock > 0)
 	{
 		ABI_PushRegistersAndAdjustStack({}, 0);
@@ -480,6 +574,23 @@ void Jit64::WriteExceptionExit()
 	JMP(asm_routines.dispatcher, true);
 }
 
+bool Jit64::IsIdleLoopBranch()
+{
+	return js.op->branchIsIdleLoop && SConfig::GetInstance().bSkipIdle &&
+		CPU::GetState() != CPU::CPU_STEPPING && !PatchEngine::IsIdleSkipExcluded(js.blockStart);
+}
+
+// Exit for the branch closing a polling loop (see PPCAnalyzer::DetectIdleLoop). Nothing in
+// the loop can change what it is waiting on, so skip ahead to the next event instead of spinning.
+void Jit64::WriteIdleExit(u32 destination)
+{
+	ABI_PushRegistersAndAdjustStack({}, 0);
+	ABI_CallFunction(CoreTiming::Idle);
+	ABI_PopRegistersAndAdjustStack({}, 0);
+	MOV(32, PPCSTATE(pc), Imm32(destination));
+	WriteExceptionExit();
+}
+
 void Jit64::WriteExternalExceptionExit()
 {
 	Cleanup();
@@ -540,11 +651,17 @@ void Jit64::Jit(u32 em_address)
 #endif
 	}
 
-	if (IsAlmostFull() || farcode.IsAlmostFull() || trampolines.IsAlmostFull() || blocks.IsFull() ||
-		SConfig::GetInstance().bJITNoBlockCache)
+	// Trampolines aren't tracked per block, so running out of them still needs a full clear.
+	if (trampolines.IsAlmostFull() || blocks.IsFull() || SConfig::GetInstance().bJITNoBlockCache)
 	{
 		ClearCache();
 	}
+	else if (IsCodeSegmentFull())
+	{
+		// Jit() is only reached from the dispatcher after it has reset the stack, so no BLR
+		// return addresses into the evicted code can be left behind.
+		RecycleNextCodeSegment();
+	}
 
 	int blockSize = code_buffer.GetSize();
 
@@ -598,6 +715,7 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
 	js.isLastInstruction = false;
 	js.blockStart = em_address;
 	js.fifoBytesThisBlock = 0;
+	js.fifoBytesPending = 0;
 	js.mustCheckFifo = false;
 	js.curBlock = b;
 	js.numLoadStoreInst = 0;
@@ -723,6 +841,15 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
 		bool gatherPipeIntCheck =
 			js.fifoWriteAddresses.find(ops[i].address) != js.fifoWriteAddresses.end();
 
+		// Consecutive immediate-address gather pipe stores only update the pipe counter once,
+		// at the end of the run. Breakpoint checks flush the register cache and so break runs.
+		if (js.fifoBytesPending && (js.fifoBytesThisBlock >= 32 || js.mustCheckFifo || ops[i].skip ||
+			SConfig::GetInstance().bEnableDebugging ||
+			!IsGatherPipeStore(ops[i])))
+		{
+			FlushGatherPipeWrites();
+		}
+
 		// Gather pipe writes using an immediate address are explicitly tracked.
 		if (jo.optimizeGatherPipe && (js.fifoBytesThisBlock >= 32 || js.mustCheckFifo))
 		{
@@ -894,6 +1021,15 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
 				SwitchToNearCode();
 			}
 
+			// Values that are overwritten later in the block without being read don't need to be
+			// written back. The breakpoint checks above can exit anywhere, so keep everything then.
+			if (!SConfig::GetInstance().bEnableDebugging)
+			{
+				const PPCAnalyst::CodeOp& last_op = ops[i + js.skipInstructions];
+				gpr.Discard(last_op.gprDiscardable);
+				fpr.Discard(last_op.fprDiscardable);
+			}
+
 			// If we have a register that will never be used again, flush it.
 			for (int j : ~ops[i].gprInUse)
 				gpr.StoreFromRegister(j);
@@ -918,6 +1054,8 @@ const u8* Jit64::DoJit(u32 em_address, PPCAnalyst::CodeBuffer* code_buf, JitBloc
 		js.skipInstructions = 0;
 	}
 
+	FlushGatherPipeWrites();
+
 	if (code_block.m_broken)
 	{
 		gpr.Flush();
@@ -45,6 +45,15 @@ private:
 	bool m_cleanup_after_stackfault;
 	u8* m_stack;
 
+	// The near and far code spaces are split into segments that are filled in turn. Once the
+	// current one is full, the oldest segment is evicted and reused instead of clearing the cache.
+	static constexpr int NUM_CODE_SEGMENTS = 8;
+	int m_code_segment;
+	u32 m_num_recycled_segments;
+
+	bool IsCodeSegmentFull() const;
+	void RecycleNextCodeSegment();
+
 public:
 	Jit64() : code_buffer(32000) {}
 	~Jit64() {}
@@ -87,8 +96,11 @@ public:
 	void WriteBLRExit();
 	void WriteExceptionExit();
 	void WriteExternalExceptionExit();
+	bool IsIdleLoopBranch();
+	void WriteIdleExit(u32 destination);
 	void WriteRfiExitDestInRSCRATCH();
 	bool Cleanup();
+	bool IsGatherPipeStore(const PPCAnalyst::CodeOp& op);
 
 	void GenerateConstantOverflow(bool overflow);
 	void GenerateConstantOverflow(s64 val);
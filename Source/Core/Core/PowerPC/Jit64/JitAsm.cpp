@@ -199,14 +199,6 @@ void Jit64AsmRoutineManager::ResetStack(X64CodeBlock& emitter)
 
 void Jit64AsmRoutineManager::GenerateCommon()
 {
-	fifoDirectWrite8 = AlignCode4();
-	GenFifoWrite(8);
-	fifoDirectWrite16 = AlignCode4();
-	GenFifoWrite(16);
-	fifoDirectWrite32 = AlignCode4();
-	GenFifoWrite(32);
-	fifoDirectWrite64 = AlignCode4();
-	GenFifoWrite(64);
 	frsqrte = AlignCode4();
 	GenFrsqrte();
 	fres = AlignCode4();
@@ -71,12 +71,12 @@ void RegCache::UnlockAllX()
 
 BitSet32 GPRRegCache::GetRegUtilization()
 {
-	return jit->js.op->gprInReg;
+	return jit->js.op->gprInReg & ~jit->js.op->gprDiscardable;
 }
 
 BitSet32 FPURegCache::GetRegUtilization()
 {
-	return jit->js.op->gprInReg;
+	return jit->js.op->fprInXmm & ~jit->js.op->fprDiscardable;
 }
 
 BitSet32 GPRRegCache::CountRegsIn(size_t preg, u32 lookahead)
@@ -227,6 +227,23 @@ void RegCache::DiscardRegContentsIfCached(size_t preg)
 	}
 }
 
+void RegCache::Discard(BitSet32 pregs)
+{
+	for (unsigned int i : pregs)
+	{
+		if (regs[i].locked)
+			PanicAlert("Someone forgot to unlock PPC reg %u.", i);
+
+		if (regs[i].away)
+		{
+			if (regs[i].location.IsSimpleReg())
+				DiscardRegContentsIfCached(i);
+			regs[i].away = false;
+			regs[i].location = GetDefaultLocation(i);
+		}
+	}
+}
+
 void GPRRegCache::SetImmediate32(size_t preg, u32 immValue)
 {
 	DiscardRegContentsIfCached(preg);
@@ -57,6 +57,8 @@ public:
 	void Start();
 
 	void DiscardRegContentsIfCached(size_t preg);
+	// Drops the cached values of dead registers without writing them back.
+	void Discard(BitSet32 pregs);
 	void SetEmitter(Gen::XEmitter* emitter) { emit = emitter; }
 	void FlushR(Gen::X64Reg reg);
 	void FlushR(Gen::X64Reg reg, Gen::X64Reg reg2)
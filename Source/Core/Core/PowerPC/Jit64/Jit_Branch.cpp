@@ -88,6 +88,11 @@ void Jit64::bx(UGeckoInstruction inst)
 	if (inst.LK)
 		AND(32, PPCSTATE(cr), Imm32(~(0xFF000000)));
 #endif
+	if (IsIdleLoopBranch())
+	{
+		WriteIdleExit(destination);
+		return;
+	}
 	if (destination == js.compilerPC)
 	{
 		// PanicAlert("Idle loop detected at %08x", destination);
@@ -137,7 +142,10 @@ void Jit64::bcx(UGeckoInstruction inst)
 
 	gpr.Flush(FLUSH_MAINTAIN_STATE);
 	fpr.Flush(FLUSH_MAINTAIN_STATE);
-	WriteExit(destination, inst.LK, js.compilerPC + 4);
+	if (IsIdleLoopBranch())
+		WriteIdleExit(destination);
+	else
+		WriteExit(destination, inst.LK, js.compilerPC + 4);
 
 	if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
 		SetJumpTarget(pConditionDontBranch);
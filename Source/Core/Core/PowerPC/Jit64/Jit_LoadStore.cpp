@@ -365,6 +365,7 @@ void Jit64::dcbz(UGeckoInstruction inst)
 		PXOR(XMM0, R(XMM0));
 		MOVAPS(MComplex(RMEM, RSCRATCH, SCALE_1, 0), XMM0);
 		MOVAPS(MComplex(RMEM, RSCRATCH, SCALE_1, 16), XMM0);
+		MarkPageWritten(RSCRATCH, 0, R(RSCRATCH), CallerSavedRegistersInUse());
 
 		// Slow path: call the general-case code.
 		SwitchToFarCode();
@@ -298,8 +298,8 @@ static GekkoOPTemplate table31[] = {
     {83, &JitArm64::mfmsr},                   // mfmsr
     {144, &JitArm64::mtcrf},                  // mtcrf
     {146, &JitArm64::mtmsr},                  // mtmsr
-    {210, &JitArm64::mtsr},                   // mtsr
-    {242, &JitArm64::mtsrin},                 // mtsrin
+    {210, &JitArm64::FallBackToInterpreter},  // mtsr
+    {242, &JitArm64::FallBackToInterpreter},  // mtsrin
     {339, &JitArm64::mfspr},                  // mfspr
     {467, &JitArm64::mtspr},                  // mtspr
     {371, &JitArm64::mftb},                   // mftb
@@ -105,6 +105,8 @@ protected:
 
 		bool mustCheckFifo;
 		int fifoBytesThisBlock;
+		// Bytes written to the gather pipe but not yet added to m_gatherPipeCount
+		int fifoBytesPending;
 
 		PPCAnalyst::BlockStats st;
 		PPCAnalyst::BlockRegStats gpa;
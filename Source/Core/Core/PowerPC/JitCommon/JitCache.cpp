@@ -37,7 +37,7 @@ static void ClearCacheThreadSafe(u64 userdata, s64 cyclesdata)
 
 bool JitBaseBlockCache::IsFull() const
 {
-	return GetNumBlocks() >= MAX_NUM_BLOCKS - 1;
+	return GetNumBlocks() >= MAX_NUM_BLOCKS - 1 && free_block_numbers.empty();
 }
 
 void JitBaseBlockCache::Init()
@@ -78,6 +78,7 @@ void JitBaseBlockCache::Clear()
 	valid_block.ClearAll();
 
 	num_blocks = 1;
+	free_block_numbers.clear();
 	blocks[0].msrBits = 0xFFFFFFFF;
 	blocks[0].invalid = true;
 }
@@ -105,14 +106,50 @@ int JitBaseBlockCache::GetNumBlocks() const
 
 int JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
-	JitBlock& b = blocks[num_blocks];
+	int block_num;
+	if (!free_block_numbers.empty())
+	{
+		block_num = free_block_numbers.back();
+		free_block_numbers.pop_back();
+	}
+	else
+	{
+		block_num = num_blocks++;  // commit the current block
+	}
+
+	JitBlock& b = blocks[block_num];
 	b.invalid = false;
 	b.effectiveAddress = em_address;
 	b.physicalAddress = PowerPC::JitCache_TranslateAddress(em_address).address;
 	b.msrBits = MSR & JitBlock::JIT_CACHE_MSR_MASK;
 	b.linkData.clear();
-	num_blocks++;  // commit the current block
-	return num_blocks - 1;
+	return block_num;
+}
+
+int JitBaseBlockCache::EvictCode(const u8* begin, const u8* end)
+{
+	int num_evicted = 0;
+	for (int i = 1; i < num_blocks; i++)
+	{
+		JitBlock& b = blocks[i];
+		if (b.checkedEntry < begin || b.checkedEntry >= end)
+			continue;
+
+		if (!b.invalid)
+		{
+			block_map.erase(
+				std::make_pair(b.physicalAddress + 4 * b.originalSize - 1, b.physicalAddress));
+			DestroyBlock(i, false);
+			num_evicted++;
+		}
+
+		// Blocks that were only invalidated may still have been running until now; once their
+		// code is gone, nothing refers to them anymore.
+		b.checkedEntry = nullptr;
+		b.normalEntry = nullptr;
+		free_block_numbers.push_back(i);
+	}
+	return num_evicted;
 }
 
 void JitBaseBlockCache::FinalizeBlock(int block_num, bool block_link, const u8* code_ptr)
@@ -295,14 +332,24 @@ void JitBaseBlockCache::DestroyBlock(int block_num, bool invalidate)
 
 	UnlinkBlock(block_num);
 
-	// Delete linking adresses
-	auto it = links_to.equal_range(b.effectiveAddress);
-	while (it.first != it.second)
+	// Delete linking adresses, and point our own exits back at the dispatcher: the blocks they
+	// jump to may be evicted while this block's code is still around.
+	for (auto& e : b.linkData)
 	{
-		if (it.first->second == block_num)
-			it.first = links_to.erase(it.first);
-		else
-			it.first++;
+		auto it = links_to.equal_range(e.exitAddress);
+		while (it.first != it.second)
+		{
+			if (it.first->second == block_num)
+				it.first = links_to.erase(it.first);
+			else
+				it.first++;
+		}
+
+		if (e.linkStatus)
+		{
+			WriteLinkBlock(e, nullptr);
+			e.linkStatus = false;
+		}
 	}
 
 	// Raise an signal if we are going to call this block again
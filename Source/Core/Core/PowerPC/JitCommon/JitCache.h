@@ -118,6 +118,9 @@ private:
 	std::array<JitBlock, MAX_NUM_BLOCKS> blocks;  // number -> JitBlock
 	int num_blocks;
 
+	// Block numbers below num_blocks whose code has been evicted and which can be handed out again.
+	std::vector<int> free_block_numbers;
+
 	// links_to hold all exit points of all valid blocks in a reverse way.
 	// It is used to query all blocks which links to an address.
 	std::multimap<u32, int> links_to;  // destination_PC -> number
@@ -159,6 +162,9 @@ public:
 	void FinalizeBlock(int block_num, bool block_link, const u8* code_ptr);
 
 	void Clear();
+	// Destroys all blocks whose code starts in [begin, end) and frees their numbers, so that the
+	// code space can be reused. Returns the number of valid blocks that were destroyed.
+	int EvictCode(const u8* begin, const u8* end);
 	void SchedulateClearCacheThreadSafe();
 	void Init();
 	void Shutdown();
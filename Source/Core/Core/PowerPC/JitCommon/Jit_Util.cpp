@@ -9,6 +9,7 @@
 #include "Common/MathUtil.h"
 #include "Common/x64ABI.h"
 #include "Common/x64Emitter.h"
+#include "Core/HW/GPFifo.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/Memmap.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -445,26 +446,25 @@ static OpArg FixImmediate(int accessSize, OpArg arg)
 
 void EmuCodeBlock::UnsafeWriteGatherPipe(int accessSize)
 {
-	// No need to protect these, they don't touch any state
-	// question - should we inline them instead? Pro: Lose a CALL   Con: Code bloat
-	switch (accessSize)
-	{
-	case 8:
-		CALL(jit->GetAsmRoutines()->fifoDirectWrite8);
-		break;
-	case 16:
-		CALL(jit->GetAsmRoutines()->fifoDirectWrite16);
-		break;
-	case 32:
-		CALL(jit->GetAsmRoutines()->fifoDirectWrite32);
-		break;
-	case 64:
-		CALL(jit->GetAsmRoutines()->fifoDirectWrite64);
-		break;
-	}
+	// Inlined so that a run of stores only bumps the counter once, see FlushGatherPipeWrites.
+	// Value is in RSCRATCH; the offset of this store within the run is folded into the displacement.
+	u32 gather_pipe = (u32)(u64)GPFifo::m_gatherPipe;
+	_assert_msg_(DYNA_REC, gather_pipe <= 0x7FFFFFFF, "Gather pipe not in low 2GB of memory!");
+	MOV(32, R(RSCRATCH2), M(&GPFifo::m_gatherPipeCount));
+	SwapAndStore(accessSize, MDisp(RSCRATCH2, gather_pipe + jit->js.fifoBytesPending), RSCRATCH);
+	jit->js.fifoBytesPending += accessSize >> 3;
 	jit->js.fifoBytesThisBlock += accessSize >> 3;
 }
 
+void EmuCodeBlock::FlushGatherPipeWrites(bool keep_pending)
+{
+	if (!jit->js.fifoBytesPending)
+		return;
+	ADD(32, M(&GPFifo::m_gatherPipeCount), Imm8(jit->js.fifoBytesPending));
+	if (!keep_pending)
+		jit->js.fifoBytesPending = 0;
+}
+
 bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
 	BitSet32 registersInUse)
 {
@@ -480,7 +480,9 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
 		UnsafeWriteGatherPipe(accessSize);
 		return false;
 	}
-	else if (PowerPC::IsOptimizableRAMAddress(address))
+
+	FlushGatherPipeWrites();
+	if (PowerPC::IsOptimizableRAMAddress(address))
 	{
 		WriteToConstRamAddress(accessSize, arg, address);
 		return false;
@@ -544,6 +546,10 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 		}
 		info.len = static_cast<u32>(GetCodePtr() - info.start);
 
+		// Outside of the backpatched range. After a trampoline the address register may be gone,
+		// but the slow path has already recorded the write, so a stray mark here is harmless.
+		MarkPageWritten(reg_addr, offset, reg_value, registersInUse);
+
 		jit->js.fastmemLoadStore = mov.address;
 
 		return;
@@ -569,6 +575,7 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 	{
 		FixupBranch slow = CheckIfSafeAddress(reg_value, reg_addr, registersInUse);
 		UnsafeWriteRegToReg(reg_value, reg_addr, accessSize, 0, swap);
+		MarkPageWritten(reg_addr, 0, reg_value, registersInUse);
 		if (farcode.Enabled())
 			SwitchToFarCode();
 		else
@@ -624,14 +631,60 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 	}
 }
 
+void EmuCodeBlock::MarkPageWritten(X64Reg reg_addr, s32 offset, const OpArg& reg_value,
+	BitSet32 registersInUse)
+{
+	if (!Memory::bWriteTracking)
+		return;
+
+	// Use a caller-saved register that the caller isn't using, or borrow one.
+	static const X64Reg candidates[] = { RSI, RDI, R8, R9, R10, R11 };
+	X64Reg scratch = INVALID_REG;
+	for (X64Reg reg : candidates)
+	{
+		if (ABI_ALL_CALLER_SAVED[reg] && !registersInUse[reg] && reg != reg_addr &&
+			!reg_value.IsSimpleReg(reg))
+		{
+			scratch = reg;
+			break;
+		}
+	}
+	bool borrowed = false;
+	if (scratch == INVALID_REG)
+	{
+		for (X64Reg reg : candidates)
+		{
+			if (reg != reg_addr && !reg_value.IsSimpleReg(reg))
+			{
+				scratch = reg;
+				break;
+			}
+		}
+		borrowed = true;
+		PUSH(scratch);
+	}
+
+	LEA(32, scratch, MDisp(reg_addr, offset));
+	SHR(32, R(scratch), Imm8(Memory::WRITE_TRACKING_PAGE_SHIFT));
+	AND(32, R(scratch), Imm32(Memory::WRITE_TRACKING_NUM_PAGES - 1));
+	MOV(8, MDisp(scratch, (u32)(u64)Memory::written_pages), Imm8(1));
+
+	if (borrowed)
+		POP(scratch);
+}
+
 void EmuCodeBlock::WriteToConstRamAddress(int accessSize, OpArg arg, u32 address, bool swap)
 {
+	const u32 page =
+		(address & Memory::WRITE_TRACKING_ADDRESS_MASK) >> Memory::WRITE_TRACKING_PAGE_SHIFT;
 	X64Reg reg;
 	if (arg.IsImm())
 	{
 		arg = SwapImmediate(accessSize, arg);
 		MOV(32, R(RSCRATCH), Imm32(address));
 		MOV(accessSize, MRegSum(RMEM, RSCRATCH), arg);
+		if (Memory::bWriteTracking)
+			MOV(8, M(&Memory::written_pages[page]), Imm8(1));
 		return;
 	}
 
@@ -650,6 +703,8 @@ void EmuCodeBlock::WriteToConstRamAddress(int accessSize, OpArg arg, u32 address
 		SwapAndStore(accessSize, MRegSum(RMEM, RSCRATCH2), reg);
 	else
 		MOV(accessSize, MRegSum(RMEM, RSCRATCH2), R(reg));
+	if (Memory::bWriteTracking)
+		MOV(8, M(&Memory::written_pages[page]), Imm8(1));
 }
 
 void EmuCodeBlock::ForceSinglePrecision(X64Reg output, const OpArg& input, bool packed,
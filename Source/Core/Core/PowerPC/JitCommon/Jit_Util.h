@@ -139,6 +139,9 @@ public:
 	bool UnsafeLoadToReg(Gen::X64Reg reg_value, Gen::OpArg opAddress, int accessSize, s32 offset,
 		bool signExtend, Gen::MovInfo* info = nullptr);
 	void UnsafeWriteGatherPipe(int accessSize);
+	// Adds the bytes of a run of inlined gather pipe writes to the pipe counter. Side exits
+	// pass keep_pending so the fall-through path still flushes them itself.
+	void FlushGatherPipeWrites(bool keep_pending = false);
 
 	// Generate a load/write from the MMIO handler for a given address. Only
 	// call for known addresses in MMIO range (MMIO::IsMMIOAddress).
@@ -179,6 +182,10 @@ public:
 		return swap && !cpu_info.bMOVBE && accessSize > 8;
 	}
 
+	// Records a store to RAM for Memory's write tracking, if enabled. Clobbers flags.
+	void MarkPageWritten(Gen::X64Reg reg_addr, s32 offset, const Gen::OpArg& reg_value,
+		BitSet32 registersInUse);
+
 	void WriteToConstRamAddress(int accessSize, Gen::OpArg arg, u32 address, bool swap = true);
 	// returns true if an exception could have been caused
 	bool WriteToConstAddress(int accessSize, Gen::OpArg arg, u32 address, BitSet32 registersInUse);
@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
+
 #include "Common/Atomic.h"
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
@@ -105,6 +107,125 @@ struct TranslateAddressResult
 template <const XCheckTLBFlag flag>
 static TranslateAddressResult TranslateAddress(const u32 address);
 
+// Software TLB which maps effective data pages straight to host memory when MSR.DR is set.
+// Entries are filled on demand after a successful translation to RAM, so repeated accesses
+// to the same page skip the BAT lookup and page table walk. Reads and writes are cached
+// separately because the first write to a page has to go through the page table to set
+// the C bit. Everything here is dropped whenever the BATs, segment registers or SDR1
+// change, and per set whenever the corresponding emulated TLB entry goes away.
+struct HostTLBEntry
+{
+	u32 tag;
+	u8* host_page;
+	// Physical page that is marked as written, or HOST_TLB_UNTRACKED for locked L1 and fake VMEM
+	u32 tracked_page;
+};
+
+enum
+{
+	HOST_TLB_SIZE = 1024,
+	HOST_TLB_MASK = HOST_TLB_SIZE - 1
+};
+static const u32 HOST_TLB_UNTRACKED = 0xFFFFFFFF;
+
+static std::array<HostTLBEntry, HOST_TLB_SIZE> s_host_tlb_read;
+static std::array<HostTLBEntry, HOST_TLB_SIZE> s_host_tlb_write;
+
+// Returns the host pointer backing a translated page, or nullptr if the page is not plain
+// memory (MMIO, EFB or the gather pipe). tracked_page is set to the page WriteToHardware marks as
+// written for it.
+static u8* GetHostPage(u32 physical_address, u32* tracked_page)
+{
+	physical_address &= ~(HW_PAGE_SIZE - 1);
+	*tracked_page = HOST_TLB_UNTRACKED;
+	if ((physical_address >> 28) == 0xE && (physical_address < (0xE0000000 + Memory::L1_CACHE_SIZE)))
+		return &Memory::m_pL1Cache[physical_address & 0x0FFFFFFF];
+	if (Memory::bFakeVMEM && ((physical_address & 0xFE000000) == 0x7E000000))
+		return &Memory::m_pFakeVMEM[physical_address & Memory::RAM_MASK];
+	if ((physical_address & 0xF8000000) == 0x00000000)
+	{
+		*tracked_page = physical_address & Memory::RAM_MASK;
+		return &Memory::m_pRAM[physical_address & Memory::RAM_MASK];
+	}
+	if (Memory::m_pEXRAM && (physical_address >> 28) == 0x1 &&
+		(physical_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
+	{
+		*tracked_page = physical_address;
+		return &Memory::m_pEXRAM[physical_address & 0x0FFFFFFF];
+	}
+	return nullptr;
+}
+
+template <XCheckTLBFlag flag>
+__forceinline static std::array<HostTLBEntry, HOST_TLB_SIZE>& GetHostTLB()
+{
+	return flag == FLAG_WRITE ? s_host_tlb_write : s_host_tlb_read;
+}
+
+// If tracked_address is given, it is set to the physical address to mark as written, or to
+// HOST_TLB_UNTRACKED.
+template <XCheckTLBFlag flag, typename T>
+__forceinline static u8* LookupHostTLB(u32 em_address, u32* tracked_address = nullptr)
+{
+	// Accesses which cross into the next page take the slow path.
+	if ((em_address & (HW_PAGE_SIZE - 1)) > HW_PAGE_SIZE - sizeof(T))
+		return nullptr;
+	const u32 tag = em_address >> HW_PAGE_INDEX_SHIFT;
+	const HostTLBEntry& entry = GetHostTLB<flag>()[tag & HOST_TLB_MASK];
+	if (entry.tag != tag)
+		return nullptr;
+	if (tracked_address)
+	{
+		*tracked_address = entry.tracked_page == HOST_TLB_UNTRACKED ?
+			HOST_TLB_UNTRACKED :
+			entry.tracked_page | (em_address & (HW_PAGE_SIZE - 1));
+	}
+	return entry.host_page + (em_address & (HW_PAGE_SIZE - 1));
+}
+
+template <XCheckTLBFlag flag>
+static void FillHostTLB(u32 em_address, u32 physical_address)
+{
+	u32 tracked_page;
+	u8* host_page = GetHostPage(physical_address, &tracked_page);
+	if (!host_page)
+		return;
+	const u32 tag = em_address >> HW_PAGE_INDEX_SHIFT;
+	HostTLBEntry& entry = GetHostTLB<flag>()[tag & HOST_TLB_MASK];
+	entry.tag = tag;
+	entry.host_page = host_page;
+	entry.tracked_page = tracked_page;
+}
+
+static void InvalidateHostTLBPage(u32 tag)
+{
+	HostTLBEntry& read_entry = s_host_tlb_read[tag & HOST_TLB_MASK];
+	if (read_entry.tag == tag)
+		read_entry.tag = TLB_TAG_INVALID;
+	HostTLBEntry& write_entry = s_host_tlb_write[tag & HOST_TLB_MASK];
+	if (write_entry.tag == tag)
+		write_entry.tag = TLB_TAG_INVALID;
+}
+
+// Drops every entry which shares an emulated TLB set with the given page.
+static void InvalidateHostTLBSet(u32 tag)
+{
+	for (u32 i = tag & HW_PAGE_INDEX_MASK; i < HOST_TLB_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+	{
+		s_host_tlb_read[i].tag = TLB_TAG_INVALID;
+		s_host_tlb_write[i].tag = TLB_TAG_INVALID;
+	}
+}
+
+void InvalidateHostTLB()
+{
+	for (u32 i = 0; i < HOST_TLB_SIZE; i++)
+	{
+		s_host_tlb_read[i].tag = TLB_TAG_INVALID;
+		s_host_tlb_write[i].tag = TLB_TAG_INVALID;
+	}
+}
+
 // Nasty but necessary. Super Mario Galaxy pointer relies on this stuff.
 static u32 EFB_Read(const u32 addr)
 {
@@ -165,6 +286,12 @@ __forceinline static T ReadFromHardware(u32 em_address)
 {
 	if (!never_translate && UReg_MSR(MSR).DR)
 	{
+		if (flag == FLAG_READ)
+		{
+			if (const u8* host_ptr = LookupHostTLB<flag, T>(em_address))
+				return bswap(*(const T*)host_ptr);
+		}
+
 		auto translated_addr = TranslateAddress<flag>(em_address);
 		if (!translated_addr.Success())
 		{
@@ -196,6 +323,8 @@ __forceinline static T ReadFromHardware(u32 em_address)
 			}
 			return var;
 		}
+		if (flag == FLAG_READ)
+			FillHostTLB<flag>(em_address, translated_addr.address);
 		em_address = translated_addr.address;
 	}
 
@@ -245,6 +374,18 @@ __forceinline static void WriteToHardware(u32 em_address, const T data)
 {
 	if (!never_translate && UReg_MSR(MSR).DR)
 	{
+		if (flag == FLAG_WRITE)
+		{
+			u32 tracked_address;
+			if (u8* host_ptr = LookupHostTLB<flag, T>(em_address, &tracked_address))
+			{
+				*(T*)host_ptr = bswap(data);
+				if (tracked_address != HOST_TLB_UNTRACKED)
+					Memory::MarkWritten(tracked_address, sizeof(T));
+				return;
+			}
+		}
+
 		auto translated_addr = TranslateAddress<flag>(em_address);
 		if (!translated_addr.Success())
 		{
@@ -278,6 +419,9 @@ __forceinline static void WriteToHardware(u32 em_address, const T data)
 			}
 			return;
 		}
+		// The C bit of the page is set by now, so later writes can skip the page table.
+		if (flag == FLAG_WRITE)
+			FillHostTLB<flag>(em_address, translated_addr.address);
 		em_address = translated_addr.address;
 	}
 
@@ -341,6 +485,7 @@ __forceinline static void WriteToHardware(u32 em_address, const T data)
 		// mirrors of memory).
 		// TODO: Only the first REALRAM_SIZE is supposed to be backed by actual memory.
 		*(T*)&Memory::m_pRAM[em_address & Memory::RAM_MASK] = bswap(data);
+		Memory::MarkWritten(em_address & Memory::RAM_MASK, sizeof(T));
 		return;
 	}
 
@@ -348,6 +493,7 @@ __forceinline static void WriteToHardware(u32 em_address, const T data)
 		(em_address & 0x0FFFFFFF) < Memory::EXRAM_SIZE)
 	{
 		*(T*)&Memory::m_pEXRAM[em_address & 0x0FFFFFFF] = bswap(data);
+		Memory::MarkWritten(em_address, sizeof(T));
 		return;
 	}
 
@@ -683,6 +829,7 @@ void DMA_LCToMemory(const u32 memAddr, const u32 cacheAddr, const u32 numBlocks)
 		return;
 
 	memcpy(dst, src, 32 * numBlocks);
+	Memory::MarkWritten(memAddr, 32 * numBlocks);
 }
 
 void DMA_MemoryToLC(const u32 cacheAddr, const u32 memAddr, const u32 numBlocks)
@@ -946,6 +1093,7 @@ void SDRUpdated()
 	}
 	PowerPC::ppcState.pagetable_base = htaborg << 16;
 	PowerPC::ppcState.pagetable_hashmask = ((xx << 10) | 0x3ff);
+	InvalidateHostTLB();
 }
 
 enum TLBLookupResult
@@ -1015,6 +1163,8 @@ static __forceinline void UpdateTLBEntry(const XCheckTLBFlag flag, UPTE2 PTE2, c
 	int tag = address >> HW_PAGE_INDEX_SHIFT;
 	PowerPC::tlb_entry* tlbe = &PowerPC::ppcState.tlb[IsOpcodeFlag(flag)][tag & HW_PAGE_INDEX_MASK];
 	int index = tlbe->recent == 0 && tlbe->tag[0] != TLB_TAG_INVALID;
+	if (!IsOpcodeFlag(flag) && tlbe->tag[index] != TLB_TAG_INVALID)
+		InvalidateHostTLBPage(tlbe->tag[index]);
 	tlbe->recent = index;
 	tlbe->paddr[index] = PTE2.RPN << HW_PAGE_INDEX_SHIFT;
 	tlbe->pte[index] = PTE2.Hex;
@@ -1031,6 +1181,7 @@ void InvalidateTLBEntry(u32 address)
 		&PowerPC::ppcState.tlb[1][(address >> HW_PAGE_INDEX_SHIFT) & HW_PAGE_INDEX_MASK];
 	tlbe_i->tag[0] = TLB_TAG_INVALID;
 	tlbe_i->tag[1] = TLB_TAG_INVALID;
+	InvalidateHostTLBSet(address >> HW_PAGE_INDEX_SHIFT);
 }
 
 // Page Address Translation
@@ -1211,6 +1362,7 @@ void DBATUpdated()
 		UpdateFakeMMUBat(dbat_table, 0x70000000);
 	}
 	Memory::UpdateLogicalMemory(dbat_table);
+	InvalidateHostTLB();
 
 	// IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
 	JitInterface::ClearSafe();
@@ -9,6 +9,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
+#include "Core/HLE/HLE.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
@@ -631,6 +632,49 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, GekkoOPInf
 	}
 }
 
+// Finds polling loops at the start of a block, such as
+//   loop: lwz   r0, 0x10(r3)
+//         cmpwi r0, 0
+//         beq   loop
+// The loop may only contain integer instructions and loads, and no register may carry a value
+// from one iteration to the next. Nothing inside the loop can then change what it reads, so it
+// spins until an interrupt, DMA or MMIO state change, and the JIT can skip to the next event.
+void PPCAnalyzer::DetectIdleLoop(CodeBlock* block, CodeOp* code)
+{
+	static const u32 MAX_IDLE_LOOP_INSTRUCTIONS = 8;
+
+	BitSet32 read_before_write;
+	BitSet32 written;
+	for (u32 i = 0; i < block->m_num_instructions && i < MAX_IDLE_LOOP_INSTRUCTIONS; i++)
+	{
+		CodeOp& op = code[i];
+		const UGeckoInstruction inst = op.inst;
+		if (op.opinfo->type == OPTYPE_BRANCH)
+		{
+			u32 destination;
+			if (inst.OPCD == 18 && !inst.LK)
+				destination = inst.AA ? SignExt26(inst.LI << 2) : op.address + SignExt26(inst.LI << 2);
+			else if (inst.OPCD == 16 && !inst.LK && (inst.BO & BO_DONT_DECREMENT_FLAG))
+				destination = inst.AA ? SignExt16(inst.BD << 2) : op.address + SignExt16(inst.BD << 2);
+			else
+				return;
+
+			op.branchIsIdleLoop = destination == block->m_address;
+			return;
+		}
+
+		if (op.opinfo->type != OPTYPE_INTEGER && op.opinfo->type != OPTYPE_LOAD)
+			return;
+		if (op.opinfo->flags & FL_READ_CA)
+			return;
+
+		read_before_write |= op.regsIn & ~written;
+		if (op.regsOut & read_before_write)
+			return;
+		written |= op.regsOut;
+	}
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32 blockSize)
 {
 	// Clear block stats
@@ -798,6 +842,8 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
 
 	block->m_num_instructions = num_inst;
 
+	DetectIdleLoop(block, code);
+
 	if (block->m_num_instructions > 1)
 		ReorderInstructions(block->m_num_instructions, code);
 
@@ -811,6 +857,16 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
 	// wants flags, to be safe.
 	bool wantsCR0 = true, wantsCR1 = true, wantsFPRF = true, wantsCA = true;
 	BitSet32 fprInUse, gprInUse, gprInReg, fprInXmm;
+	BitSet32 gprDiscardable, fprDiscardable;
+	u32 first_fpu_inst = block->m_num_instructions;
+	for (u32 i = 0; i < block->m_num_instructions; i++)
+	{
+		if (!code[i].skip && (code[i].opinfo->flags & FL_USE_FPU))
+		{
+			first_fpu_inst = i;
+			break;
+		}
+	}
 	for (int i = block->m_num_instructions - 1; i >= 0; i--)
 	{
 		bool opWantsCR0 = code[i].wantsCR0;
@@ -833,8 +889,31 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, u32
 		code[i].fprInUse = fprInUse;
 		code[i].gprInReg = gprInReg;
 		code[i].fprInXmm = fprInXmm;
-		// TODO: if there's no possible endblocks or exceptions in between, tell the regcache
-		// we can throw away a register if it's going to be overwritten later.
+		code[i].gprDiscardable = gprDiscardable;
+		code[i].fprDiscardable = fprDiscardable;
+
+		// A register that gets overwritten later can be thrown away instead of written back, as
+		// long as nothing in between can observe the register file. That rules out branches,
+		// memory accesses (DSI), the gather pipe check that follows a store, the FPU-unavailable
+		// check on the first FPU instruction and HLE hooks.
+		const u32 flags = code[i].opinfo->flags;
+		if (code[i].canEndBlock || (flags & (FL_ENDBLOCK | FL_LOADSTORE | FL_EVIL)) ||
+			(i > 0 && (code[i - 1].opinfo->flags & FL_LOADSTORE)) ||
+			static_cast<u32>(i) == first_fpu_inst || HLE::GetFunctionIndex(code[i].address) != 0)
+		{
+			gprDiscardable = BitSet32(0);
+			fprDiscardable = BitSet32(0);
+		}
+		else if (!code[i].skip)
+		{
+			gprDiscardable |= code[i].regsOut;
+			gprDiscardable &= ~code[i].regsIn;
+			// Instructions that only write ps0 list their output as an input too.
+			if (code[i].fregOut >= 0)
+				fprDiscardable[code[i].fregOut] = true;
+			fprDiscardable &= ~code[i].fregsIn;
+		}
+
 		gprInUse |= code[i].regsIn;
 		gprInReg |= code[i].regsIn;
 		fprInUse |= code[i].fregsIn;
@@ -41,6 +41,7 @@ struct CodeOp  // 16B
 	bool outputFPRF;
 	bool outputCA;
 	bool canEndBlock;
+	bool branchIsIdleLoop;  // branch back to the start of a polling loop, see DetectIdleLoop
 	bool skip;  // followed BL-s for example
 	// which registers are still needed after this instruction in this block
 	BitSet32 fprInUse;
@@ -50,6 +51,10 @@ struct CodeOp  // 16B
 	// we do double stores from GPRs, so we don't want to load a PowerPC floating point register into
 	// an XMM only to move it again to a GPR afterwards.
 	BitSet32 fprInXmm;
+	// registers whose current value is dead after this instruction: it is overwritten later in the
+	// block before being read, and nothing in between can leave the block.
+	BitSet32 gprDiscardable;
+	BitSet32 fprDiscardable;
 	// whether an fpr is known to be an actual single-precision value at this point in the block.
 	BitSet32 fprIsSingle;
 	// whether an fpr is known to have identical top and bottom halves (e.g. due to a single
@@ -169,6 +174,7 @@ private:
 	void ReorderInstructionsCore(u32 instructions, CodeOp* code, bool reverse, ReorderType type);
 	void ReorderInstructions(u32 instructions, CodeOp* code);
 	void SetInstructionStats(CodeBlock* block, CodeOp* code, GekkoOPInfo* opinfo, u32 index);
+	void DetectIdleLoop(CodeBlock* block, CodeOp* code);
 
 	// Options
 	u32 m_options;
@@ -73,6 +73,8 @@ void DoState(PointerWrap& p)
 	// comes first :)
 
 	p.DoPOD(ppcState);
+	if (p.GetMode() == PointerWrap::MODE_READ)
+		InvalidateHostTLB();
 
 	// SystemTimers::DecrementerSet();
 	// SystemTimers::TimeBaseSet();
@@ -144,6 +146,7 @@ void Init(int cpu_core)
 			}
 		}
 	}
+	InvalidateHostTLB();
 
 	ResetRegisters();
 	PPCTables::InitTables(cpu_core);
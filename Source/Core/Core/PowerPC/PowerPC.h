@@ -267,6 +267,7 @@ void ClearCacheLine(const u32 address);  // Zeroes 32 bytes; address should be 3
 // TLB functions
 void SDRUpdated();
 void InvalidateTLBEntry(u32 address);
+void InvalidateHostTLB();
 void DBATUpdated();
 void IBATUpdated();
 
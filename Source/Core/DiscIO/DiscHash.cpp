@@ -0,0 +1,177 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <xxhash.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DiscHash.h"
+
+namespace DiscIO
+{
+static const u64 CHUNK_SIZE = 4 * 1024 * 1024;
+static const unsigned int MAX_THREADS = 8;
+static const char CACHE_FILE_NAME[] = "DiscHashes.txt";
+
+struct CachedHash
+{
+	u64 size;
+	u64 mtime;
+	std::string hash;
+};
+
+static std::mutex s_cache_lock;
+static std::map<std::string, CachedHash> s_cache;
+static bool s_cache_loaded = false;
+
+static std::string GetCachePath()
+{
+	return File::GetUserPath(D_CACHE_IDX) + CACHE_FILE_NAME;
+}
+
+// One entry per line: size, modification time, hash and path
+static void LoadCache()
+{
+	s_cache_loaded = true;
+
+	std::ifstream file;
+	OpenFStream(file, GetCachePath(), std::ios_base::in);
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream stream(line);
+		CachedHash entry;
+		std::string path;
+		if (stream >> entry.size >> entry.mtime >> entry.hash && std::getline(stream >> std::ws, path))
+			s_cache[path] = entry;
+	}
+}
+
+static void SaveCache()
+{
+	File::CreateFullPath(GetCachePath());
+	std::ofstream file;
+	OpenFStream(file, GetCachePath(), std::ios_base::out | std::ios_base::trunc);
+	for (const auto& entry : s_cache)
+		file << entry.second.size << ' ' << entry.second.mtime << ' ' << entry.second.hash << ' ' << entry.first << '\n';
+}
+
+static std::string HashChunks(const std::string& file_path, std::function<bool(int)>& report_progress)
+{
+	std::unique_ptr<IBlobReader> reader(CreateBlobReader(file_path));
+	if (!reader)
+		return "";
+
+	const u64 data_size = reader->GetDataSize();
+	const u64 num_chunks = (data_size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	std::vector<u64> chunk_hashes(num_chunks);
+
+	std::atomic<u64> next_chunk(0);
+	std::atomic<u64> done_chunks(0);
+	std::atomic<bool> failed(false);
+	std::atomic<bool> aborted(false);
+
+	// Blob readers aren't thread safe, so every worker opens the file itself. For compressed
+	// formats this also spreads the decompression over the workers.
+	auto worker = [&](std::unique_ptr<IBlobReader> worker_reader) {
+		if (!worker_reader)
+		{
+			failed = true;
+			return;
+		}
+
+		std::vector<u8> buffer(CHUNK_SIZE);
+		while (!failed && !aborted)
+		{
+			u64 chunk = next_chunk++;
+			if (chunk >= num_chunks)
+				break;
+
+			u64 offset = chunk * CHUNK_SIZE;
+			u64 size = std::min(CHUNK_SIZE, data_size - offset);
+			if (!worker_reader->Read(offset, size, buffer.data()))
+			{
+				failed = true;
+				break;
+			}
+			chunk_hashes[chunk] = XXH64(buffer.data(), (size_t)size, 0, chunk);
+			++done_chunks;
+		}
+	};
+
+	unsigned int num_threads = std::max(1u, std::min(std::thread::hardware_concurrency(), MAX_THREADS));
+	num_threads = (unsigned int)std::min<u64>(num_threads, std::max<u64>(num_chunks, 1));
+	std::vector<std::thread> threads;
+	threads.emplace_back(worker, std::move(reader));
+	for (unsigned int i = 1; i < num_threads; ++i)
+		threads.emplace_back(worker, std::unique_ptr<IBlobReader>(CreateBlobReader(file_path)));
+
+	int last_progress = -1;
+	while (done_chunks < num_chunks && !failed && !aborted)
+	{
+		int progress = (int)(done_chunks * 100 / num_chunks);
+		if (progress != last_progress)
+		{
+			last_progress = progress;
+			if (!report_progress(progress))
+				aborted = true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	if (failed || aborted)
+		return "";
+	if (!report_progress(100))
+		return "";
+
+	u64 hash = XXH64(chunk_hashes.data(), chunk_hashes.size() * sizeof(u64), 0, data_size);
+	return StringFromFormat("%016llx", (unsigned long long)hash);
+}
+
+std::string ComputeDiscHash(const std::string& file_path, std::function<bool(int)> report_progress)
+{
+	const u64 size = File::GetSize(file_path);
+	const u64 mtime = File::GetModificationTime(file_path);
+
+	{
+		std::lock_guard<std::mutex> lk(s_cache_lock);
+		if (!s_cache_loaded)
+			LoadCache();
+
+		auto it = s_cache.find(file_path);
+		if (it != s_cache.end() && it->second.size == size && it->second.mtime == mtime)
+		{
+			report_progress(100);
+			return it->second.hash;
+		}
+	}
+
+	std::string hash = HashChunks(file_path, report_progress);
+	if (hash.empty())
+		return hash;
+
+	std::lock_guard<std::mutex> lk(s_cache_lock);
+	s_cache[file_path] = { size, mtime, hash };
+	SaveCache();
+	return hash;
+}
+}
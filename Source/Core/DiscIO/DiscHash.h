@@ -0,0 +1,20 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+// Fast checksum used to verify that NetPlay players have the same game.
+// Fixed-size chunks of the logical disc data are hashed with xxHash64 on several threads and
+// the chunk hashes are hashed again. Formats that keep every byte of the disc, like ISO and GCZ,
+// hash the same. WBFS drops the unused parts of Wii discs, so it doesn't match their ISO.
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace DiscIO
+{
+// Returns the hash as a hex string, or an empty string if the file couldn't be read or
+// report_progress returned false. Results are cached by path, size and modification time.
+std::string ComputeDiscHash(const std::string& file_path, std::function<bool(int)> report_progress);
+}
@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <map>
@@ -16,6 +17,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/ThreadPool.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Enums.h"
 #include "DiscIO/FileMonitor.h"
@@ -30,7 +32,8 @@ namespace DiscIO
 CVolumeWiiCrypted::CVolumeWiiCrypted(std::unique_ptr<IBlobReader> reader, u64 _VolumeOffset,
 	const unsigned char* _pVolumeKey)
 	: m_pReader(std::move(reader)), m_AES_ctx(std::make_unique<mbedtls_aes_context>()),
-	m_VolumeOffset(_VolumeOffset), m_dataOffset(0x20000), m_LastDecryptedBlockOffset(-1)
+	m_VolumeOffset(_VolumeOffset), m_dataOffset(0x20000), m_block_cache(s_block_cache_size),
+	m_block_cache_clock(0)
 {
 	mbedtls_aes_setkey_dec(m_AES_ctx.get(), _pVolumeKey, 128);
 }
@@ -38,7 +41,7 @@ CVolumeWiiCrypted::CVolumeWiiCrypted(std::unique_ptr<IBlobReader> reader, u64 _V
 bool CVolumeWiiCrypted::ChangePartition(u64 offset)
 {
 	m_VolumeOffset = offset;
-	m_LastDecryptedBlockOffset = -1;
+	ClearBlockCache();
 
 	u8 volume_key[16];
 	DiscIO::VolumeKeyForPartition(*m_pReader, offset, volume_key);
@@ -50,6 +53,48 @@ CVolumeWiiCrypted::~CVolumeWiiCrypted()
 {
 }
 
+const u8* CVolumeWiiCrypted::FindCachedBlock(u64 block) const
+{
+	for (CachedBlock& entry : m_block_cache)
+	{
+		if (entry.block == block)
+		{
+			entry.last_use = ++m_block_cache_clock;
+			return entry.data.data();
+		}
+	}
+	return nullptr;
+}
+
+CVolumeWiiCrypted::CachedBlock& CVolumeWiiCrypted::AllocateCachedBlock(u64 block) const
+{
+	CachedBlock& entry = *std::min_element(m_block_cache.begin(), m_block_cache.end(),
+		[](const CachedBlock& a, const CachedBlock& b) { return a.last_use < b.last_use; });
+	entry.block = block;
+	entry.last_use = ++m_block_cache_clock;
+	return entry;
+}
+
+void CVolumeWiiCrypted::ClearBlockCache()
+{
+	for (CachedBlock& entry : m_block_cache)
+	{
+		entry.block = UINT64_MAX;
+		entry.last_use = 0;
+	}
+}
+
+void CVolumeWiiCrypted::DecryptBlock(u8* raw_block, u8* out) const
+{
+	// Every cluster has its own IV at 0x3D0, so clusters can be decrypted independently.
+	// The IV gets overwritten, but that won't affect anything since the raw data isn't used again.
+	// The rest of the 0x000 - 0x3FF part contains SHA-1 hashes that IOS uses to check that
+	// discs aren't tampered with.
+	// http://wiibrew.org/wiki/Wii_Disc#Encrypted
+	mbedtls_aes_crypt_cbc(m_AES_ctx.get(), MBEDTLS_AES_DECRYPT, s_block_data_size,
+		&raw_block[0x3D0], &raw_block[s_block_header_size], out);
+}
+
 bool CVolumeWiiCrypted::Read(u64 _ReadOffset, u64 _Length, u8* _pBuffer, bool decrypt) const
 {
 	if (m_pReader == nullptr)
@@ -60,39 +105,66 @@ bool CVolumeWiiCrypted::Read(u64 _ReadOffset, u64 _Length, u8* _pBuffer, bool de
 
 	FileMon::FindFilename(_ReadOffset);
 
-	std::vector<u8> read_buffer(s_block_total_size);
 	while (_Length > 0)
 	{
 		// Calculate block offset
 		u64 Block = _ReadOffset / s_block_data_size;
 		u64 Offset = _ReadOffset % s_block_data_size;
 
-		if (m_LastDecryptedBlockOffset != Block)
+		if (const u8* cached = FindCachedBlock(Block))
 		{
-			// Read the current block
-			if (!m_pReader->Read(m_VolumeOffset + m_dataOffset + Block * s_block_total_size,
-				s_block_total_size, read_buffer.data()))
-				return false;
+			u64 CopySize = std::min(_Length, s_block_data_size - Offset);
+			memcpy(_pBuffer, cached + Offset, (size_t)CopySize);
+			_Length -= CopySize;
+			_pBuffer += CopySize;
+			_ReadOffset += CopySize;
+			continue;
+		}
 
-			// Decrypt the block's data.
-			// 0x3D0 - 0x3DF in m_pBuffer will be overwritten,
-			// but that won't affect anything, because we won't
-			// use the content of m_pBuffer anymore after this
-			mbedtls_aes_crypt_cbc(m_AES_ctx.get(), MBEDTLS_AES_DECRYPT, s_block_data_size,
-				&read_buffer[0x3D0], &read_buffer[s_block_header_size],
-				m_LastDecryptedBlock);
-			m_LastDecryptedBlockOffset = Block;
-
-			// The only thing we currently use from the 0x000 - 0x3FF part
-			// of the block is the IV (at 0x3D0), but it also contains SHA-1
-			// hashes that IOS uses to check that discs aren't tampered with.
-			// http://wiibrew.org/wiki/Wii_Disc#Encrypted
+		// Read all the uncached clusters up to the next cached one at once
+		u64 last_block = (_ReadOffset + _Length - 1) / s_block_data_size;
+		u64 num_blocks = 1;
+		while (num_blocks < s_max_batch_blocks && Block + num_blocks <= last_block &&
+			!FindCachedBlock(Block + num_blocks))
+		{
+			++num_blocks;
 		}
 
-		// Copy the decrypted data
-		u64 MaxSizeToCopy = s_block_data_size - Offset;
-		u64 CopySize = (_Length > MaxSizeToCopy) ? MaxSizeToCopy : _Length;
-		memcpy(_pBuffer, &m_LastDecryptedBlock[Offset], (size_t)CopySize);
+		if (m_raw_buffer.size() < num_blocks * s_block_total_size)
+			m_raw_buffer.resize(num_blocks * s_block_total_size);
+		if (!m_pReader->Read(m_VolumeOffset + m_dataOffset + Block * s_block_total_size,
+			num_blocks * s_block_total_size, m_raw_buffer.data()))
+			return false;
+
+		// Clusters covered entirely are decrypted straight into the output buffer,
+		// only the partial ones at either end go through the cache.
+		u64 CopySize = std::min(_Length, num_blocks * s_block_data_size - Offset);
+		u64 last_start = (num_blocks - 1) * s_block_data_size - Offset;
+		CachedBlock* first = nullptr;
+		CachedBlock* last = nullptr;
+		if (Offset != 0 || CopySize < s_block_data_size)
+			first = &AllocateCachedBlock(Block);
+		if (num_blocks > 1 && Offset + CopySize < num_blocks * s_block_data_size)
+			last = &AllocateCachedBlock(Block + num_blocks - 1);
+
+		Common::ThreadPool::Loop([&](int lower, int upper) {
+			for (int i = lower; i < upper; ++i)
+			{
+				u8* out;
+				if (i == 0 && first)
+					out = first->data.data();
+				else if ((u64)i == num_blocks - 1 && last)
+					out = last->data.data();
+				else
+					out = _pBuffer + i * s_block_data_size - Offset;
+				DecryptBlock(&m_raw_buffer[i * s_block_total_size], out);
+			}
+		}, 0, (int)num_blocks, s_min_parallel_blocks);
+
+		if (first)
+			memcpy(_pBuffer, first->data.data() + Offset, (size_t)std::min(CopySize, s_block_data_size - Offset));
+		if (last)
+			memcpy(_pBuffer + last_start, last->data.data(), (size_t)(CopySize - last_start));
 
 		// Update offsets
 		_Length -= CopySize;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <mbedtls/aes.h>
 #include <memory>
@@ -56,14 +57,35 @@ private:
 	static const unsigned int s_block_data_size = 0x7C00;
 	static const unsigned int s_block_total_size = s_block_header_size + s_block_data_size;
 
+	// Decrypted clusters kept for reads that only cover part of a cluster
+	static const size_t s_block_cache_size = 8;
+	// Limits the raw data read and decrypted in one go
+	static const u64 s_max_batch_blocks = 64;
+	// Smallest number of clusters worth handing to another thread
+	static const int s_min_parallel_blocks = 4;
+
+	struct CachedBlock
+	{
+		u64 block = UINT64_MAX;
+		u64 last_use = 0;
+		std::array<u8, s_block_data_size> data;
+	};
+
+	const u8* FindCachedBlock(u64 block) const;
+	// Returns the least recently used slot, already claimed for block
+	CachedBlock& AllocateCachedBlock(u64 block) const;
+	void ClearBlockCache();
+	void DecryptBlock(u8* raw_block, u8* out) const;
+
 	std::unique_ptr<IBlobReader> m_pReader;
 	std::unique_ptr<mbedtls_aes_context> m_AES_ctx;
 
 	u64 m_VolumeOffset;
 	u64 m_dataOffset;
 
-	mutable u64 m_LastDecryptedBlockOffset;
-	mutable unsigned char m_LastDecryptedBlock[s_block_data_size];
+	mutable std::vector<CachedBlock> m_block_cache;
+	mutable u64 m_block_cache_clock;
+	mutable std::vector<u8> m_raw_buffer;
 };
 
 }  // namespace
@@ -216,12 +216,17 @@ NetPlayDialog::NetPlayDialog(wxWindow* const parent, const CGameListCtrl* const
 		bottom_szr->Add(m_start_btn);
 
 		bottom_szr->Add(new wxStaticText(panel, wxID_ANY, _("Buffer:")), 0, wxLEFT | wxCENTER, 5);
-		wxSpinCtrl* const padbuf_spin =
+		m_padbuf_spin =
 			new wxSpinCtrl(panel, wxID_ANY, std::to_string(INITIAL_PAD_BUFFER_SIZE), wxDefaultPosition,
 				wxSize(64, -1), wxSP_ARROW_KEYS, 0, 200, INITIAL_PAD_BUFFER_SIZE);
-		padbuf_spin->Bind(wxEVT_SPINCTRL, &NetPlayDialog::OnAdjustBuffer, this);
+		m_padbuf_spin->Bind(wxEVT_SPINCTRL, &NetPlayDialog::OnAdjustBuffer, this);
 		bottom_szr->AddSpacer(3);
-		bottom_szr->Add(padbuf_spin, 0, wxCENTER);
+		bottom_szr->Add(m_padbuf_spin, 0, wxCENTER);
+		bottom_szr->AddSpacer(5);
+		wxCheckBox* const padbuf_auto = new wxCheckBox(panel, wxID_ANY, _("Auto"));
+		padbuf_auto->SetToolTip(_("Adjust the buffer to the players' ping and jitter while playing."));
+		padbuf_auto->Bind(wxEVT_CHECKBOX, &NetPlayDialog::OnAutoBuffer, this);
+		bottom_szr->Add(padbuf_auto, 0, wxCENTER);
 		bottom_szr->AddSpacer(5);
 		m_memcard_write = new wxCheckBox(panel, wxID_ANY, _("Write to memcards/SD"));
 		bottom_szr->Add(m_memcard_write, 0, wxCENTER);
@@ -402,6 +407,12 @@ void NetPlayDialog::OnAdjustBuffer(wxCommandEvent& event)
 	netplay_server->AdjustPadBufferSize(val);
 }
 
+void NetPlayDialog::OnAutoBuffer(wxCommandEvent& event)
+{
+	m_padbuf_spin->Enable(!event.IsChecked());
+	netplay_server->SetAutoPadBuffer(event.IsChecked());
+}
+
 void NetPlayDialog::OnPadBufferChanged(u32 buffer)
 {
 	m_pad_buffer = buffer;
@@ -547,6 +558,9 @@ void NetPlayDialog::OnThread(wxThreadEvent& event)
 	{
 		std::string msg = StringFromFormat("Pad buffer: %d", m_pad_buffer);
 
+		if (m_padbuf_spin)
+			m_padbuf_spin->SetValue(m_pad_buffer);
+
 		if (g_ActiveConfig.bShowNetPlayMessages)
 		{
 			OSD::AddTypedMessage(OSD::MessageType::NetPlayBuffer, msg, OSD::Duration::NORMAL);
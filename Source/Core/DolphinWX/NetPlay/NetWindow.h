@@ -19,6 +19,7 @@ class wxButton;
 class wxCheckBox;
 class wxChoice;
 class wxListBox;
+class wxSpinCtrl;
 class wxStaticText;
 class wxString;
 class wxTextCtrl;
@@ -107,6 +108,7 @@ private:
 	void OnChangeGame(wxCommandEvent& event);
 	void OnMD5ComputeRequested(wxCommandEvent& event);
 	void OnAdjustBuffer(wxCommandEvent& event);
+	void OnAutoBuffer(wxCommandEvent& event);
 	void OnAssignPads(wxCommandEvent& event);
 	void OnKick(wxCommandEvent& event);
 	void OnPlayerSelect(wxCommandEvent& event);
@@ -124,6 +126,7 @@ private:
 	wxTextCtrl* m_chat_msg_text;
 	wxCheckBox* m_memcard_write;
 	wxCheckBox* m_record_chkbox;
+	wxSpinCtrl* m_padbuf_spin = nullptr;
 
 	std::string m_selected_game;
 	wxButton* m_player_config_btn;
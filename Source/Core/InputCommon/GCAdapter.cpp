@@ -3,12 +3,15 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <cinttypes>
 #include <libusb.h>
 #include <mutex>
 
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Common/Timer.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -34,14 +37,45 @@ static u8 s_controller_type[MAX_SI_CHANNELS] = {
 		ControllerTypes::CONTROLLER_NONE, ControllerTypes::CONTROLLER_NONE };
 static u8 s_controller_rumble[4];
 
-static std::mutex s_mutex;
-static u8 s_controller_payload[37];
-static u8 s_controller_payload_swap[37];
-
-static std::atomic<int> s_controller_payload_size = { 0 };
+enum
+{
+	CONTROLLER_PAYLOAD_SIZE = 37,
+	// Interrupt transfers kept queued on the input endpoint, so a report is never missed
+	// while the previous one is being handled
+	NUM_READ_TRANSFERS = 4,
+};
+
+// Controller reports go from the libusb event thread to the emulation thread through a triple
+// buffer. The writer fills its own slot and swaps it with the shared one; the reader swaps the
+// shared one in when it holds a newer report. Neither side ever waits for the other.
+struct Payload
+{
+	u8 data[CONTROLLER_PAYLOAD_SIZE];
+	int size;
+	u64 timestamp;  // Timer::GetTimeUs() at completion, 0 if nothing has arrived yet
+};
+enum
+{
+	PAYLOAD_INDEX_MASK = 0x3,
+	PAYLOAD_FRESH = 0x4,
+};
+static Payload s_payloads[3];
+static std::atomic<u8> s_shared_payload;
+static u8 s_write_payload;  // event thread
+static u8 s_read_payload;   // emulation thread
+
+static libusb_transfer* s_read_transfers[NUM_READ_TRANSFERS];
+static u8 s_read_buffers[NUM_READ_TRANSFERS][CONTROLLER_PAYLOAD_SIZE];
+static std::atomic<int> s_read_transfers_pending = { 0 };
+
+// Age of the report handed to the game at each poll
+static std::atomic<u64> s_latency_samples = { 0 };
+static std::atomic<u64> s_latency_total_us = { 0 };
+static std::atomic<u64> s_latency_max_us = { 0 };
 
 static std::thread s_adapter_thread;
 static Common::Flag s_adapter_thread_running;
+static Common::Flag s_adapter_removed;
 
 static std::mutex s_init_mutex;
 static std::thread s_adapter_detect_thread;
@@ -61,21 +95,117 @@ static u8 s_endpoint_out = 0;
 
 static u64 s_last_init = 0;
 
+static void ResetPayloads()
+{
+	for (Payload& payload : s_payloads)
+		payload = {};
+	s_write_payload = 0;
+	s_read_payload = 1;
+	s_shared_payload.store(2);
+}
+
+static void PublishPayload(const u8* data, int size)
+{
+	Payload& payload = s_payloads[s_write_payload];
+	std::copy(data, data + std::min<int>(size, CONTROLLER_PAYLOAD_SIZE), payload.data);
+	payload.size = size;
+	payload.timestamp = Common::Timer::GetTimeUs();
+	s_write_payload =
+		s_shared_payload.exchange(s_write_payload | PAYLOAD_FRESH, std::memory_order_acq_rel) &
+		PAYLOAD_INDEX_MASK;
+}
+
+static void RecordLatency(u64 latency_us)
+{
+	s_latency_samples++;
+	s_latency_total_us += latency_us;
+	u64 max = s_latency_max_us.load();
+	while (latency_us > max && !s_latency_max_us.compare_exchange_weak(max, latency_us))
+	{
+	}
+}
+
+static const Payload& LatestPayload()
+{
+	if (s_shared_payload.load(std::memory_order_relaxed) & PAYLOAD_FRESH)
+	{
+		s_read_payload =
+			s_shared_payload.exchange(s_read_payload, std::memory_order_acq_rel) & PAYLOAD_INDEX_MASK;
+		// Each report counts once, when it is first handed out, however many channels poll it
+		RecordLatency(Common::Timer::GetTimeUs() - s_payloads[s_read_payload].timestamp);
+	}
+	return s_payloads[s_read_payload];
+}
+
+static void LIBUSB_CALL ReadCallback(libusb_transfer* transfer)
+{
+	if (transfer->status == LIBUSB_TRANSFER_COMPLETED)
+	{
+		PublishPayload(transfer->buffer, transfer->actual_length);
+		if (s_adapter_thread_running.IsSet())
+		{
+			int ret = libusb_submit_transfer(transfer);
+			if (ret == LIBUSB_SUCCESS)
+				return;
+			ERROR_LOG(SERIALINTERFACE, "libusb_submit_transfer failed with error: %d", ret);
+		}
+	}
+	else if (transfer->status != LIBUSB_TRANSFER_CANCELLED)
+	{
+		// An empty report makes Input() reset the adapter.
+		PublishPayload(transfer->buffer, 0);
+	}
+	s_read_transfers_pending--;
+}
+
 static void Read()
 {
-	int payload_size = 0;
-	while (s_adapter_thread_running.IsSet())
+	Common::SetCurrentThreadName("GC Adapter Read Thread");
+
+	for (int i = 0; i < NUM_READ_TRANSFERS; i++)
 	{
-		libusb_interrupt_transfer(s_handle, s_endpoint_in, s_controller_payload_swap,
-			sizeof(s_controller_payload_swap), &payload_size, 16);
+		libusb_transfer* transfer = libusb_alloc_transfer(0);
+		s_read_transfers[i] = transfer;
+		if (!transfer)
+			continue;
+		libusb_fill_interrupt_transfer(transfer, s_handle, s_endpoint_in, s_read_buffers[i],
+			CONTROLLER_PAYLOAD_SIZE, ReadCallback, nullptr, 0);
+		s_read_transfers_pending++;
+		int ret = libusb_submit_transfer(transfer);
+		if (ret != LIBUSB_SUCCESS)
+		{
+			ERROR_LOG(SERIALINTERFACE, "libusb_submit_transfer failed with error: %d", ret);
+			s_read_transfers_pending--;
+		}
+	}
 
+	timeval tv = { 0, 100000 };
+	while (s_adapter_thread_running.IsSet())
+	{
+		// Nothing can arrive anymore if no transfer is queued, so treat the adapter as detached
+		// rather than handing out the last report forever.
+		if (s_read_transfers_pending.load() == 0)
 		{
-			std::lock_guard<std::mutex> lk(s_mutex);
-			std::swap(s_controller_payload_swap, s_controller_payload);
-			s_controller_payload_size.store(payload_size);
+			ERROR_LOG(SERIALINTERFACE, "No read transfers left, detaching the GC Adapter");
+			PublishPayload(s_read_buffers[0], 0);
+			s_adapter_removed.Set();
+			break;
 		}
+		libusb_handle_events_timeout_completed(s_libusb_context, &tv, nullptr);
+	}
 
-		Common::YieldCPU();
+	for (libusb_transfer* transfer : s_read_transfers)
+	{
+		if (transfer)
+			libusb_cancel_transfer(transfer);
+	}
+	while (s_read_transfers_pending.load() > 0)
+		libusb_handle_events_timeout_completed(s_libusb_context, &tv, nullptr);
+
+	for (libusb_transfer*& transfer : s_read_transfers)
+	{
+		libusb_free_transfer(transfer);
+		transfer = nullptr;
 	}
 }
 
@@ -93,8 +223,10 @@ static int HotplugCallback(libusb_context* ctx, libusb_device* dev, libusb_hotpl
 	}
 	else if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT)
 	{
+		// Reset() waits for the read transfers to be cancelled, which needs events to be handled,
+		// so it can't run from inside this callback.
 		if (s_handle != nullptr && libusb_get_device(s_handle) == dev)
-			Reset();
+			s_adapter_removed.Set();
 	}
 	return 0;
 }
@@ -126,9 +258,14 @@ static void ScanThreadFunc()
 		{
 			static timeval tv = { 0, 500000 };
 			libusb_handle_events_timeout(s_libusb_context, &tv);
+			if (s_adapter_removed.TestAndClear())
+				Reset();
 		}
 		else
 		{
+			// Without hotplug events, a removed adapter is only noticed by the read thread
+			if (s_adapter_removed.TestAndClear())
+				Reset();
 			if (s_handle == nullptr)
 			{
 				std::lock_guard<std::mutex> lk(s_init_mutex);
@@ -315,6 +452,8 @@ static void AddGCAdapter(libusb_device* device)
 	unsigned char payload = 0x13;
 	libusb_interrupt_transfer(s_handle, s_endpoint_out, &payload, sizeof(payload), &tmp, 16);
 
+	ResetPayloads();
+	s_adapter_removed.Clear();
 	s_adapter_thread_running.Set(true);
 	s_adapter_thread = std::thread(Read);
 
@@ -360,6 +499,14 @@ static void Reset()
 
 	s_detected = false;
 
+	const u64 samples = s_latency_samples.load();
+	if (samples)
+	{
+		NOTICE_LOG(SERIALINTERFACE, "GC Adapter input latency: average %" PRIu64 " us, max %" PRIu64
+			" us over %" PRIu64 " polls", s_latency_total_us.load() / samples, s_latency_max_us.load(),
+			samples);
+	}
+
 	if (s_handle)
 	{
 		libusb_release_interface(s_handle, 0);
@@ -379,18 +526,15 @@ GCPadStatus Input(int chan)
 	if (s_handle == nullptr || !s_detected)
 		return{};
 
-	int payload_size = 0;
-	u8 controller_payload_copy[37];
+	const Payload& payload = LatestPayload();
+	if (payload.timestamp == 0)
+		return{};
 
-	{
-		std::lock_guard<std::mutex> lk(s_mutex);
-		std::copy(std::begin(s_controller_payload), std::end(s_controller_payload),
-			std::begin(controller_payload_copy));
-		payload_size = s_controller_payload_size.load();
-	}
+	const int payload_size = payload.size;
+	const u8* controller_payload_copy = payload.data;
 
 	GCPadStatus pad = {};
-	if (payload_size != sizeof(controller_payload_copy) ||
+	if (payload_size != CONTROLLER_PAYLOAD_SIZE ||
 		controller_payload_copy[0] != LIBUSB_DT_HID)
 	{
 		INFO_LOG(SERIALINTERFACE, "error reading payload (size: %d, type: %02x)", payload_size,
@@ -541,4 +685,20 @@ bool IsDriverDetected()
 	return !s_libusb_driver_not_supported;
 }
 
+LatencyStats GetLatencyStats()
+{
+	LatencyStats stats;
+	stats.samples = s_latency_samples.load();
+	stats.average_us = stats.samples ? s_latency_total_us.load() / stats.samples : 0;
+	stats.max_us = s_latency_max_us.load();
+	return stats;
+}
+
+void ResetLatencyStats()
+{
+	s_latency_samples.store(0);
+	s_latency_total_us.store(0);
+	s_latency_max_us.store(0);
+}
+
 }  // end of namespace GCAdapter
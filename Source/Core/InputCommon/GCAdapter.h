@@ -18,6 +18,14 @@ enum ControllerTypes
 	CONTROLLER_WIRED = 1,
 	CONTROLLER_WIRELESS = 2
 };
+// How old the adapter report handed to the game was when it polled the controller
+struct LatencyStats
+{
+	u64 samples = 0;
+	u64 average_us = 0;
+	u64 max_us = 0;
+};
+
 void Init();
 void ResetRumble();
 void Shutdown();
@@ -30,5 +38,7 @@ bool IsDetected();
 bool IsDriverDetected();
 bool DeviceConnected(int chan);
 bool UseAdapter();
+LatencyStats GetLatencyStats();
+void ResetLatencyStats();
 
 }  // end of namespace GCAdapter
@@ -391,6 +391,15 @@ bool UseAdapter()
          SConfig::GetInstance().m_SIDevice[3] == SIDEVICE_WIIU_ADAPTER;
 }
 
+LatencyStats GetLatencyStats()
+{
+  return {};
+}
+
+void ResetLatencyStats()
+{
+}
+
 void ResetRumble()
 {
   unsigned char rumble[5] = {0x11, 0, 0, 0, 0};
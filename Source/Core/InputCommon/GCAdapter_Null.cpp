@@ -49,5 +49,12 @@ bool UseAdapter()
 {
   return false;
 }
+LatencyStats GetLatencyStats()
+{
+  return {};
+}
+void ResetLatencyStats()
+{
+}
 
 }  // end of namespace GCAdapter
@@ -841,11 +841,6 @@ void DrawEFBPokeQuads(EFBAccessType type,
 			InitColVertex(&vertex[3], x1, y2, z, col);
 			InitColVertex(&vertex[4], x2, y1, z, col);
 			InitColVertex(&vertex[5], x2, y2, z, col);
-
-			if (type == POKE_COLOR)
-				FramebufferManager::SetEFBCachedColor(point.x, point.y, col);
-			else
-				FramebufferManager::SetEFBCachedDepth(point.x, point.y, z);
 		}
 
 		D3D::current_command_list->DrawInstanced(6 * static_cast<UINT>(points_to_draw), 1, static_cast<UINT>(base_vertex_index), 0);
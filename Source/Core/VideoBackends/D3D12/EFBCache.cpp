@@ -0,0 +1,172 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/MathUtil.h"
+
+#include "VideoBackends/D3D12/D3DBase.h"
+#include "VideoBackends/D3D12/D3DCommandListManager.h"
+#include "VideoBackends/D3D12/D3DTexture.h"
+#include "VideoBackends/D3D12/D3DUtil.h"
+#include "VideoBackends/D3D12/EFBCache.h"
+#include "VideoBackends/D3D12/FramebufferManager.h"
+#include "VideoBackends/D3D12/Render.h"
+#include "VideoBackends/D3D12/StaticShaderCache.h"
+
+#include "VideoCommon/VideoConfig.h"
+
+namespace DX12
+{
+
+EFBCache::EFBCache()
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		Plane& plane = m_planes[i];
+		DXGI_FORMAT format = i ? DXGI_FORMAT_R32_FLOAT : DXGI_FORMAT_R8G8B8A8_UNORM;
+		D3D12_CLEAR_VALUE clear_value = { format, { 0.0f, 0.0f, 0.0f, i ? 0.0f : 1.0f } };
+		ComPtr<ID3D12Resource> buff;
+
+		D3D12_RESOURCE_DESC tex_desc = CD3DX12_RESOURCE_DESC::Tex2D(format, EFB_WIDTH, EFB_HEIGHT, 1, 1, 1, 0, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
+		HRESULT hr = D3D::device->CreateCommittedResource(&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT), D3D12_HEAP_FLAG_NONE, &tex_desc, D3D12_RESOURCE_STATE_COMMON, &clear_value, IID_PPV_ARGS(buff.ReleaseAndGetAddressOf()));
+		CHECK(hr == S_OK, "create EFB cache texture (hr=%#x)", hr);
+		plane.tex = new D3DTexture2D(buff.Get(), TEXTURE_BIND_FLAG_SHADER_RESOURCE | TEXTURE_BIND_FLAG_RENDER_TARGET, format, format, DXGI_FORMAT_UNKNOWN, format, false, D3D12_RESOURCE_STATE_COMMON);
+		D3D::SetDebugObjectName12(plane.tex->GetTex(), "EFB cache texture (used in Renderer::AccessEFB)");
+
+		tex_desc = CD3DX12_RESOURCE_DESC::Buffer(READBACK_PITCH * EFB_HEIGHT);
+		hr = D3D::device->CreateCommittedResource(&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK), D3D12_HEAP_FLAG_NONE, &tex_desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(plane.readback_buffer.ReleaseAndGetAddressOf()));
+		CHECK(hr == S_OK, "create EFB cache readback buffer (hr=%#x)", hr);
+		D3D::SetDebugObjectName12(plane.readback_buffer.Get(), "EFB cache readback buffer");
+	}
+
+	m_tracking_fence = D3D::command_list_mgr->RegisterQueueFenceCallback(this, &EFBCache::QueueFenceCallback);
+}
+
+EFBCache::~EFBCache()
+{
+	D3D::command_list_mgr->RemoveQueueFenceCallback(this);
+	for (Plane& plane : m_planes)
+	{
+		SAFE_RELEASE(plane.tex);
+		D3D::command_list_mgr->DestroyResourceAfterCurrentCommandListExecuted(plane.readback_buffer.Detach());
+	}
+}
+
+void EFBCache::QueueFenceCallback(void* owning_object, UINT64 fence_value)
+{
+	static_cast<EFBCache*>(owning_object)->m_next_fence_value = fence_value + 1;
+}
+
+void EFBCache::StartReadback(EFBAccessType type)
+{
+	Plane& plane = GetPlane(type);
+	bool depth = type == PEEK_Z;
+
+	// for non-1xIR or multisampled cases, we need to copy to an intermediate texture first
+	D3DTexture2D* src_texture;
+	if (g_ActiveConfig.iEFBScale != SCALE_1X || g_ActiveConfig.iMultisamples > 1)
+	{
+		const D3D12_RECT src_rect = CD3DX12_RECT(0, 0, Renderer::GetTargetWidth(), Renderer::GetTargetHeight());
+		D3D::SetViewportAndScissor(0, 0, EFB_WIDTH, EFB_HEIGHT);
+		plane.tex->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_RENDER_TARGET);
+		D3D::current_command_list->OMSetRenderTargets(1, &plane.tex->GetRTV(), FALSE, nullptr);
+		D3D::SetPointCopySampler();
+
+		D3D::DrawShadedTexQuad(
+			depth ? FramebufferManager::GetEFBDepthTexture() : FramebufferManager::GetEFBColorTexture(),
+			&src_rect,
+			Renderer::GetTargetWidth(),
+			Renderer::GetTargetHeight(),
+			depth ? StaticShaderCache::GetDepthCopyPixelShader(true) : StaticShaderCache::GetColorCopyPixelShader(true),
+			StaticShaderCache::GetSimpleVertexShader(),
+			StaticShaderCache::GetSimpleVertexShaderInputLayout(),
+			depth ? StaticShaderCache::GetCopyGeometryShader() : D3D12_SHADER_BYTECODE(),
+			0,
+			depth ? DXGI_FORMAT_R32_FLOAT : DXGI_FORMAT_R8G8B8A8_UNORM
+		);
+
+		// The EFB targets and viewport are set again before the next draw
+		g_renderer->RestoreAPIState();
+
+		src_texture = plane.tex;
+	}
+	else
+	{
+		// can copy directly from efb texture
+		src_texture = depth ? FramebufferManager::GetEFBDepthTexture() : FramebufferManager::GetEFBColorTexture();
+	}
+
+	D3D12_BOX src_box = CD3DX12_BOX(0, 0, 0, EFB_WIDTH, EFB_HEIGHT, 1);
+
+	D3D12_TEXTURE_COPY_LOCATION dst_location = {};
+	dst_location.pResource = plane.readback_buffer.Get();
+	dst_location.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+	dst_location.PlacedFootprint.Offset = 0;
+	dst_location.PlacedFootprint.Footprint.Format = depth ? DXGI_FORMAT_R32_FLOAT : DXGI_FORMAT_R8G8B8A8_UNORM;
+	dst_location.PlacedFootprint.Footprint.Width = EFB_WIDTH;
+	dst_location.PlacedFootprint.Footprint.Height = EFB_HEIGHT;
+	dst_location.PlacedFootprint.Footprint.Depth = 1;
+	dst_location.PlacedFootprint.Footprint.RowPitch = READBACK_PITCH;
+
+	D3D12_TEXTURE_COPY_LOCATION src_location = {};
+	src_location.pResource = src_texture->GetTex();
+	src_location.SubresourceIndex = 0;
+	src_location.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+
+	src_texture->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_COPY_SOURCE);
+	D3D::current_command_list->CopyTextureRegion(&dst_location, 0, 0, 0, &src_location, &src_box);
+
+	// The copy is submitted with the rest of the command list, so nothing waits for it here
+	plane.fence_value = m_next_fence_value;
+}
+
+bool EFBCache::IsReadbackDone(EFBAccessType type)
+{
+	const Plane& plane = GetPlane(type);
+	return plane.fence_value != m_next_fence_value && m_tracking_fence->GetCompletedValue() >= plane.fence_value;
+}
+
+void EFBCache::FinishReadback(EFBAccessType type, u32* data)
+{
+	Plane& plane = GetPlane(type);
+
+	// Has the command list been executed yet?
+	if (plane.fence_value == m_next_fence_value)
+	{
+		D3D::command_list_mgr->CPUAccessNotify();
+		D3D::command_list_mgr->ExecuteQueuedWork(false);
+	}
+	D3D::command_list_mgr->WaitOnCPUForFence(m_tracking_fence, plane.fence_value);
+
+	D3D12_RANGE read_range = { 0, READBACK_PITCH * EFB_HEIGHT };
+	void* readback_buffer_map;
+	HRESULT hr = plane.readback_buffer->Map(0, &read_range, &readback_buffer_map);
+	CHECK(SUCCEEDED(hr), "failed to map efb peek cache buffer (hr=%08X)", hr);
+	if (FAILED(hr))
+		return;
+
+	for (u32 y = 0; y < EFB_HEIGHT; ++y)
+	{
+		const u8* row = static_cast<const u8*>(readback_buffer_map) + y * READBACK_PITCH;
+		u32* dst = data + y * EFB_WIDTH;
+		if (type == PEEK_Z)
+		{
+			// depth buffer is inverted in the d3d backend
+			const float* src = reinterpret_cast<const float*>(row);
+			for (u32 x = 0; x < EFB_WIDTH; ++x)
+				dst[x] = MathUtil::Clamp<u32>(static_cast<u32>((1.0f - src[x]) * 16777216.0f), 0, 0xFFFFFF);
+		}
+		else
+		{
+			// our internal buffers are RGBA, yet a BGRA value is expected
+			const u32* src = reinterpret_cast<const u32*>(row);
+			for (u32 x = 0; x < EFB_WIDTH; ++x)
+				dst[x] = RGBA8ToBGRA8(src[x]);
+		}
+	}
+
+	D3D12_RANGE write_range = {};
+	plane.readback_buffer->Unmap(0, &write_range);
+}
+
+}  // namespace DX12
@@ -0,0 +1,52 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/MathUtil.h"
+
+#include "VideoBackends/D3D12/D3DBase.h"
+
+#include "VideoCommon/EFBCacheBase.h"
+#include "VideoCommon/VideoCommon.h"
+
+namespace DX12
+{
+
+class D3DTexture2D;
+
+class EFBCache final : public EFBCacheBase
+{
+public:
+	EFBCache();
+	~EFBCache();
+
+protected:
+	void StartReadback(EFBAccessType type) override;
+	bool IsReadbackDone(EFBAccessType type) override;
+	void FinishReadback(EFBAccessType type, u32* data) override;
+
+private:
+	struct Plane
+	{
+		// Render target used to downsample the EFB to native resolution
+		D3DTexture2D* tex = nullptr;
+		ComPtr<ID3D12Resource> readback_buffer;
+		// Fence value signaled once the copy to readback_buffer is done
+		UINT64 fence_value = 0;
+	};
+
+	Plane& GetPlane(EFBAccessType type) { return m_planes[type == PEEK_Z ? 1 : 0]; }
+
+	static void QueueFenceCallback(void* owning_object, UINT64 fence_value);
+
+	static constexpr size_t READBACK_PITCH = ROUND_UP(EFB_WIDTH * sizeof(u32), D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+
+	Plane m_planes[2];
+	ID3D12Fence* m_tracking_fence = nullptr;
+	// Fence value of the work that is recorded but not submitted yet
+	UINT64 m_next_fence_value = 0;
+};
+
+}  // namespace DX12
@@ -73,38 +73,6 @@ D3DTexture2D*& FramebufferManager::GetResolvedEFBDepthTexture()
 	}
 }
 
-void FramebufferManager::InitializeEFBCache(const D3D12_CLEAR_VALUE& color_clear_value, const D3D12_CLEAR_VALUE& depth_clear_value)
-{
-	ComPtr<ID3D12Resource> buff;
-	D3D12_RESOURCE_DESC tex_desc;
-
-	// Render buffer for AccessEFB (color data)
-	tex_desc = CD3DX12_RESOURCE_DESC::Tex2D(color_clear_value.Format, EFB_WIDTH, EFB_HEIGHT, 1, 1, 1, 0, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
-	HRESULT hr = D3D::device->CreateCommittedResource(&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT), D3D12_HEAP_FLAG_NONE, &tex_desc, D3D12_RESOURCE_STATE_COMMON, &color_clear_value, IID_PPV_ARGS(buff.ReleaseAndGetAddressOf()));
-	CHECK(hr == S_OK, "create EFB color cache texture (hr=%#x)", hr);
-	m_efb.color_cache_tex = new D3DTexture2D(buff.Get(), TEXTURE_BIND_FLAG_SHADER_RESOURCE | TEXTURE_BIND_FLAG_RENDER_TARGET, color_clear_value.Format, color_clear_value.Format, DXGI_FORMAT_UNKNOWN, color_clear_value.Format, false, D3D12_RESOURCE_STATE_COMMON);
-	D3D::SetDebugObjectName12(m_efb.color_cache_tex->GetTex(), "EFB color cache texture");
-
-	// AccessEFB - Sysmem buffer used to retrieve the pixel data from color_tex
-	tex_desc = CD3DX12_RESOURCE_DESC::Buffer(EFB_CACHE_PITCH * EFB_HEIGHT);
-	hr = D3D::device->CreateCommittedResource(&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK), D3D12_HEAP_FLAG_NONE, &tex_desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(m_efb.color_cache_buf.ReleaseAndGetAddressOf()));
-	CHECK(hr == S_OK, "create EFB color cache buffer (hr=%#x)", hr);
-
-	// Render buffer for AccessEFB (depth data)
-	tex_desc = CD3DX12_RESOURCE_DESC::Tex2D(depth_clear_value.Format, EFB_WIDTH, EFB_HEIGHT, 1, 1, 1, 0, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET);
-	hr = D3D::device->CreateCommittedResource(&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT), D3D12_HEAP_FLAG_NONE, &tex_desc, D3D12_RESOURCE_STATE_COMMON, &depth_clear_value, IID_PPV_ARGS(buff.ReleaseAndGetAddressOf()));
-	CHECK(hr == S_OK, "create EFB depth cache texture (hr=%#x)", hr);
-	m_efb.depth_cache_tex = new D3DTexture2D(buff.Get(), TEXTURE_BIND_FLAG_RENDER_TARGET, depth_clear_value.Format, DXGI_FORMAT_UNKNOWN, DXGI_FORMAT_UNKNOWN, depth_clear_value.Format, false, D3D12_RESOURCE_STATE_COMMON);
-	D3D::SetDebugObjectName12(m_efb.depth_cache_tex->GetTex(), "EFB depth cache texture (used in Renderer::AccessEFB)");
-
-	// AccessEFB - Sysmem buffer used to retrieve the pixel data from depth_read_texture
-	tex_desc = CD3DX12_RESOURCE_DESC::Buffer(EFB_CACHE_PITCH * EFB_HEIGHT);
-	hr = D3D::device->CreateCommittedResource(&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK), D3D12_HEAP_FLAG_NONE, &tex_desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(m_efb.depth_cache_buf.ReleaseAndGetAddressOf()));
-	CHECK(hr == S_OK, "create EFB depth cache buffer (hr=%#x)", hr);
-	D3D::SetDebugObjectName12(m_efb.depth_cache_buf.Get(), "EFB depth cache buffer");
-
-}
-
 FramebufferManager::FramebufferManager()
 {
 	m_target_width = std::max(Renderer::GetTargetWidth(), 1);
@@ -166,22 +134,14 @@ FramebufferManager::FramebufferManager()
 		m_efb.resolved_color_tex = nullptr;
 		m_efb.resolved_depth_tex = nullptr;
 	}
-	InitializeEFBCache(clear_valueRTV, clear_valueDSV);
 }
 
 FramebufferManager::~FramebufferManager()
 {
-	FramebufferManager::InvalidateEFBCache();
 	SAFE_RELEASE(m_efb.color_tex);
 	SAFE_RELEASE(m_efb.color_temp_tex);
-	SAFE_RELEASE(m_efb.color_cache_tex);
-	D3D::command_list_mgr->DestroyResourceAfterCurrentCommandListExecuted(m_efb.color_cache_buf.Detach());
-
 	SAFE_RELEASE(m_efb.resolved_color_tex);
 	SAFE_RELEASE(m_efb.depth_tex);
-	SAFE_RELEASE(m_efb.depth_cache_tex);
-	D3D::command_list_mgr->DestroyResourceAfterCurrentCommandListExecuted(m_efb.depth_cache_buf.Detach());
-
 	SAFE_RELEASE(m_efb.resolved_depth_tex);
 }
 
@@ -344,183 +304,4 @@ void XFBSource::CopyEFB(float gamma)
 	g_renderer->RestoreAPIState();
 }
 
-u32 FramebufferManager::GetEFBCachedColor(u32 x, u32 y)
-{
-	if (!m_efb.color_cache_data)
-		PopulateEFBColorCache();
-
-	const u32* row = reinterpret_cast<const u32*>(m_efb.color_cache_data + y * EFB_CACHE_PITCH);
-	return row[x];
-}
-
-float FramebufferManager::GetEFBCachedDepth(u32 x, u32 y)
-{
-	if (!m_efb.depth_cache_data)
-		PopulateEFBDepthCache();
-
-	u32 row_offset = y * EFB_CACHE_PITCH;
-	const float* row = reinterpret_cast<const float*>(m_efb.depth_cache_data + y * EFB_CACHE_PITCH);
-	return row[x];
-}
-
-void FramebufferManager::SetEFBCachedColor(u32 x, u32 y, u32 value)
-{
-	if (!m_efb.color_cache_data)
-		return;
-
-	u32* row = reinterpret_cast<u32*>(m_efb.color_cache_data + y * EFB_CACHE_PITCH);
-	row[x] = value;
-}
-
-void FramebufferManager::SetEFBCachedDepth(u32 x, u32 y, float value)
-{
-	if (!m_efb.depth_cache_data)
-		return;
-
-	float* row = reinterpret_cast<float*>(m_efb.depth_cache_data + y * EFB_CACHE_PITCH);
-	row[x] = value;
-}
-
-void FramebufferManager::PopulateEFBColorCache()
-{
-	_dbg_assert_(!m_efb.color_readback_buffer_data, "cache is invalid");
-	D3D::command_list_mgr->CPUAccessNotify();
-	// for non-1xIR or multisampled cases, we need to copy to an intermediate texture first
-	DX12::D3DTexture2D* src_texture;
-	if (g_ActiveConfig.iEFBScale != SCALE_1X || g_ActiveConfig.iMultisamples > 1)
-	{
-		D3D12_RECT src_rect = { 0, 0, static_cast<LONG>(m_target_width), static_cast<LONG>(m_target_height) };
-		D3D::SetViewportAndScissor(0, 0, EFB_WIDTH, EFB_HEIGHT);
-		m_efb.color_cache_tex->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_RENDER_TARGET);
-		D3D::current_command_list->OMSetRenderTargets(1, &m_efb.color_cache_tex->GetRTV(), FALSE, nullptr);
-		D3D::SetPointCopySampler();
-
-		D3D::DrawShadedTexQuad(
-			m_efb.color_tex,
-			&src_rect,
-			m_target_width,
-			m_target_height,
-			StaticShaderCache::GetColorCopyPixelShader(true),
-			StaticShaderCache::GetSimpleVertexShader(),
-			StaticShaderCache::GetSimpleVertexShaderInputLayout(),
-			D3D12_SHADER_BYTECODE()
-		);
-		src_texture = m_efb.color_cache_tex;
-	}
-	else
-	{
-		// can copy directly from efb texture
-		src_texture = m_efb.color_tex;
-	}
-
-	// copy to system memory
-	D3D12_BOX src_box = CD3DX12_BOX(0, 0, 0, EFB_WIDTH, EFB_HEIGHT, 1);
-
-	D3D12_TEXTURE_COPY_LOCATION dst_location = {};
-	dst_location.pResource = m_efb.color_cache_buf.Get();
-	dst_location.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-	dst_location.PlacedFootprint.Offset = 0;
-	dst_location.PlacedFootprint.Footprint.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-	dst_location.PlacedFootprint.Footprint.Width = EFB_WIDTH;
-	dst_location.PlacedFootprint.Footprint.Height = EFB_HEIGHT;
-	dst_location.PlacedFootprint.Footprint.Depth = 1;
-	dst_location.PlacedFootprint.Footprint.RowPitch = EFB_CACHE_PITCH;
-
-	D3D12_TEXTURE_COPY_LOCATION src_location = {};
-	src_location.pResource = src_texture->GetTex();
-	src_location.SubresourceIndex = 0;
-	src_location.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-
-	src_texture->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_COPY_SOURCE);
-	D3D::current_command_list->CopyTextureRegion(&dst_location, 0, 0, 0, &src_location, &src_box);
-
-
-	// Need to wait for the CPU to complete the copy (and all prior operations) before we can read it on the CPU.
-	D3D::command_list_mgr->ExecuteQueuedWork(true);
-	D3D12_RANGE read_range = { 0, EFB_CACHE_PITCH * EFB_HEIGHT };
-	HRESULT hr = m_efb.color_cache_buf->Map(0, &read_range, reinterpret_cast<void**>(&m_efb.color_cache_data));
-	CHECK(SUCCEEDED(hr), "failed to map efb peek color cache texture (hr=%08X)", hr);
-}
-
-void FramebufferManager::PopulateEFBDepthCache()
-{
-	_dbg_assert_(!m_efb.depth_staging_buf_map.pData, "cache is invalid");
-	D3D::command_list_mgr->CPUAccessNotify();
-	// for non-1xIR or multisampled cases, we need to copy to an intermediate texture first
-	DX12::D3DTexture2D* src_texture;
-	if (g_ActiveConfig.iEFBScale != SCALE_1X || g_ActiveConfig.iMultisamples > 1)
-	{
-		D3D::SetViewportAndScissor(0, 0, EFB_WIDTH, EFB_HEIGHT);
-
-		m_efb.depth_cache_tex->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_RENDER_TARGET);
-		D3D::current_command_list->OMSetRenderTargets(0, &m_efb.depth_cache_tex->GetRTV(), FALSE, nullptr);
-
-		D3D::SetPointCopySampler();
-
-		// Render a quad covering the entire target, writing SV_Depth.
-		const D3D12_RECT source_rect = CD3DX12_RECT(0, 0, m_target_width, m_target_height);
-		D3D::DrawShadedTexQuad(
-			m_efb.depth_tex,
-			&source_rect,
-			m_target_width,
-			m_target_height,
-			StaticShaderCache::GetDepthCopyPixelShader(true),
-			StaticShaderCache::GetSimpleVertexShader(),
-			StaticShaderCache::GetSimpleVertexShaderInputLayout(),
-			StaticShaderCache::GetCopyGeometryShader(),
-			0,
-			DXGI_FORMAT_R32_FLOAT
-		);
-		src_texture = m_efb.depth_cache_tex;
-	}
-	else
-	{
-		// can copy directly from efb texture
-		src_texture = m_efb.depth_tex;
-	}
-
-	// copy to system memory
-	D3D12_BOX src_box = CD3DX12_BOX(0, 0, 0, EFB_WIDTH, EFB_HEIGHT, 1);
-
-	D3D12_TEXTURE_COPY_LOCATION dst_location = {};
-	dst_location.pResource = m_efb.depth_cache_buf.Get();
-	dst_location.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-	dst_location.PlacedFootprint.Offset = 0;
-	dst_location.PlacedFootprint.Footprint.Format = DXGI_FORMAT_R32_FLOAT;
-	dst_location.PlacedFootprint.Footprint.Width = EFB_WIDTH;
-	dst_location.PlacedFootprint.Footprint.Height = EFB_HEIGHT;
-	dst_location.PlacedFootprint.Footprint.Depth = 1;
-	dst_location.PlacedFootprint.Footprint.RowPitch = EFB_CACHE_PITCH;
-
-	D3D12_TEXTURE_COPY_LOCATION src_location = {};
-	src_location.pResource = src_texture->GetTex();
-	src_location.SubresourceIndex = 0;
-	src_location.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-
-	src_texture->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_COPY_SOURCE);
-	D3D::current_command_list->CopyTextureRegion(&dst_location, 0, 0, 0, &src_location, &src_box);
-
-	// Need to wait for the CPU to complete the copy (and all prior operations) before we can read it on the CPU.
-	D3D::command_list_mgr->ExecuteQueuedWork(true);
-	D3D12_RANGE read_range = { 0, EFB_CACHE_PITCH * EFB_HEIGHT };
-	HRESULT hr = m_efb.depth_cache_buf->Map(0, &read_range, reinterpret_cast<void**>(&m_efb.depth_cache_data));
-	CHECK(SUCCEEDED(hr), "failed to map efb peek color cache texture (hr=%08X)", hr);
-}
-
-void FramebufferManager::InvalidateEFBCache()
-{
-	D3D12_RANGE write_range = {};
-	if (m_efb.color_cache_data)
-	{
-		m_efb.color_cache_buf->Unmap(0, &write_range);
-		m_efb.color_cache_data = nullptr;
-	}
-
-	if (m_efb.depth_cache_data)
-	{
-		m_efb.depth_cache_buf->Unmap(0, &write_range);
-		m_efb.depth_cache_data = nullptr;
-	}
-}
-
 }  // namespace DX12
@@ -83,18 +83,9 @@ public:
 			&FramebufferManager::GetEFBDepthTexture()->GetDSV());
 	}
 
-	static u32 GetEFBCachedColor(u32 x, u32 y);
-	static float GetEFBCachedDepth(u32 x, u32 y);
-	static void SetEFBCachedColor(u32 x, u32 y, u32 value);
-	static void SetEFBCachedDepth(u32 x, u32 y, float value);
-	static void PopulateEFBColorCache();
-	static void PopulateEFBDepthCache();
-	static void InvalidateEFBCache();
-
 private:
 	std::unique_ptr<XFBSourceBase> CreateXFBSource(unsigned int target_width, unsigned int target_height, unsigned int layers) override;
 	void GetTargetSize(unsigned int* width, unsigned int* height) override;
-	static void InitializeEFBCache(const D3D12_CLEAR_VALUE& color_clear_value, const D3D12_CLEAR_VALUE& depth_clear_value);
 	void CopyToRealXFB(u32 xfbAddr, u32 fbStride, u32 fbHeight, const EFBRectangle& sourceRc, float gamma) override;
 
 
@@ -108,19 +99,8 @@ private:
 
 		D3DTexture2D* color_temp_tex{};
 
-		// EFB Cache
-
-		D3DTexture2D* color_cache_tex{};
-		ComPtr<ID3D12Resource> color_cache_buf;
-		u8* color_cache_data{};
-
-		D3DTexture2D* depth_cache_tex{};
-		ComPtr<ID3D12Resource> depth_cache_buf;
-		u8* depth_cache_data{};
-
 		int slices{};
 	} m_efb;
-	static constexpr size_t EFB_CACHE_PITCH = ROUND_UP(EFB_WIDTH * sizeof(int), D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
 	static unsigned int m_target_width;
 	static unsigned int m_target_height;
 };
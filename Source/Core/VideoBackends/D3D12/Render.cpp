@@ -34,6 +34,7 @@
 
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/EFBCacheBase.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -374,26 +375,17 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 {
 	if (type == PEEK_Z)
 	{
-		// depth buffer is inverted in the d3d backend
-		float val = 1.0f - FramebufferManager::GetEFBCachedDepth(x, y);
-		u32 ret = 0;
+		u32 ret = g_efb_cache->Peek(type, x, y);
 
+		// if Z is in 16 bit format you must return a 16 bit integer
 		if (bpmem.zcontrol.pixel_format == PEControl::RGB565_Z16)
-		{
-			// if Z is in 16 bit format you must return a 16 bit integer
-			ret = MathUtil::Clamp<u32>(static_cast<u32>(val * 65536.0f), 0, 0xFFFF);
-		}
-		else
-		{
-			ret = MathUtil::Clamp<u32>(static_cast<u32>(val * 16777216.0f), 0, 0xFFFFFF);
-		}
+			ret = ret >> 8;
+
 		return ret;
 	}
 	else if (type == PEEK_COLOR)
 	{
-		u32 ret = FramebufferManager::GetEFBCachedColor(x, y);
-
-		ret = RGBA8ToBGRA8(ret);
+		u32 ret = g_efb_cache->Peek(type, x, y);
 
 		// check what to do with the alpha channel (GX_PokeAlphaRead)
 		PixelEngine::UPEAlphaReadReg alpha_read_mode = PixelEngine::GetAlphaReadMode();
@@ -465,6 +457,8 @@ void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num
 	}
 	RestoreAPIState();
 	s_target_dirty = false;
+
+	g_efb_cache->Poke(type, points, num_points);
 }
 
 void Renderer::SetViewport()
@@ -563,7 +557,7 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool color_enable, bool alpha
 
 	// Restores proper viewport/scissor settings.
 	RestoreAPIState();
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 void Renderer::ReinterpretPixelData(unsigned int convtype)
@@ -608,7 +602,7 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
 	);
 
 	FramebufferManager::SwapReinterpretTexture();
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 	// Restores proper viewport/scissor settings.
 	RestoreAPIState();
 }
@@ -756,9 +750,6 @@ void Renderer::SwapImpl(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height
 		return;
 	}
 
-	// Invalidate EFB access copies. Not strictly necessary, but this avoids having the buffers mapped when calling Present().
-	FramebufferManager::InvalidateEFBCache();
-
 	// Prepare to copy the XFBs to our backbuffer
 	UpdateDrawRectangle(s_backbuffer_width, s_backbuffer_height);
 	TargetRectangle target_rc = GetTargetRectangle();
@@ -1197,7 +1188,7 @@ void Renderer::ApplyState(bool use_dst_alpha)
 
 		D3D::command_list_mgr->SetCommandListDirtyState(COMMAND_LIST_STATE_PSO, false);
 	}
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 	FramebufferManager::GetEFBDepthTexture()->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_DEPTH_WRITE);
 	FramebufferManager::GetEFBColorTexture()->TransitionToResourceState(D3D::current_command_list, D3D12_RESOURCE_STATE_RENDER_TARGET);
 }
@@ -15,6 +15,7 @@
 #include "VideoBackends/D3D12/D3DCommandListManager.h"
 #include "VideoBackends/D3D12/D3DBase.h"
 #include "VideoBackends/D3D12/D3DUtil.h"
+#include "VideoBackends/D3D12/EFBCache.h"
 #include "VideoBackends/D3D12/PerfQuery.h"
 #include "VideoBackends/D3D12/Render.h"
 #include "VideoBackends/D3D12/ShaderCache.h"
@@ -109,6 +110,7 @@ void VideoBackend::InitBackendInfo()
 	g_Config.backend_info.bSupportsComputeTextureDecoding = false;
 	g_Config.backend_info.bSupportsComputeTextureEncoding = false;
 	g_Config.backend_info.bSupportsDepthClamp = true;
+	g_Config.backend_info.bSupportsPrimitiveRestart = false;
 	IDXGIFactory* factory;
 	IDXGIAdapter* ad;
 	hr = create_dxgi_factory(__uuidof(IDXGIFactory), (void**)&factory);
@@ -191,6 +193,7 @@ void VideoBackend::Video_Prepare()
 	g_texture_cache = std::make_unique<TextureCache>();
 	g_vertex_manager = std::make_unique<VertexManager>();
 	g_perf_query = std::make_unique<PerfQuery>();
+	g_efb_cache = std::make_unique<EFBCache>();
 	g_xfb_encoder = std::make_unique<XFBEncoder>();
 	ShaderCache::Init();
 	ShaderConstantsManager::Init();
@@ -240,6 +243,7 @@ void VideoBackend::Shutdown()
 	D3D::WaitForOutstandingRenderingToComplete();
 
 	g_xfb_encoder.reset();
+	g_efb_cache.reset();
 	g_perf_query.reset();
 	g_vertex_manager.reset();
 	g_texture_cache.reset();
@@ -778,11 +778,6 @@ void DrawEFBPokeQuads(EFBAccessType type, const EfbPokeData* points, size_t num_
 			InitColVertex(&vertex[3], x1, y2, z, col);
 			InitColVertex(&vertex[4], x2, y1, z, col);
 			InitColVertex(&vertex[5], x2, y2, z, col);
-
-			if (type == POKE_COLOR)
-				FramebufferManager::SetEFBCachedColor(point.x, point.y, col);
-			else
-				FramebufferManager::SetEFBCachedDepth(point.x, point.y, z);
 		}
 
 		// unmap the util buffer, and issue the draw
@@ -0,0 +1,157 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/MathUtil.h"
+
+#include "VideoBackends/DX11/D3DBase.h"
+#include "VideoBackends/DX11/D3DTexture.h"
+#include "VideoBackends/DX11/D3DUtil.h"
+#include "VideoBackends/DX11/EFBCache.h"
+#include "VideoBackends/DX11/FramebufferManager.h"
+#include "VideoBackends/DX11/PixelShaderCache.h"
+#include "VideoBackends/DX11/Render.h"
+#include "VideoBackends/DX11/VertexShaderCache.h"
+
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DX11
+{
+
+EFBCache::EFBCache()
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		Plane& plane = m_planes[i];
+		DXGI_FORMAT format = i ? DXGI_FORMAT_R32_FLOAT : DXGI_FORMAT_R8G8B8A8_UNORM;
+		ID3D11Texture2D* buf;
+
+		D3D11_TEXTURE2D_DESC tex_desc = CD3D11_TEXTURE2D_DESC(format, EFB_WIDTH, EFB_HEIGHT, 1, 1, D3D11_BIND_RENDER_TARGET);
+		HRESULT hr = D3D::device->CreateTexture2D(&tex_desc, nullptr, &buf);
+		CHECK(hr == S_OK, "create EFB cache texture (hr=%#x)", hr);
+		plane.tex = new D3DTexture2D(buf, D3D11_BIND_RENDER_TARGET);
+		SAFE_RELEASE(buf);
+		D3D::SetDebugObjectName((ID3D11DeviceChild*)plane.tex->GetTex(), "EFB cache texture (used in Renderer::AccessEFB)");
+
+		tex_desc = CD3D11_TEXTURE2D_DESC(format, EFB_WIDTH, EFB_HEIGHT, 1, 1, 0, D3D11_USAGE_STAGING, D3D11_CPU_ACCESS_READ);
+		hr = D3D::device->CreateTexture2D(&tex_desc, nullptr, &plane.staging);
+		CHECK(hr == S_OK, "create EFB cache staging texture (hr=%#x)", hr);
+		D3D::SetDebugObjectName((ID3D11DeviceChild*)plane.staging, "EFB cache staging texture (used in Renderer::AccessEFB)");
+	}
+}
+
+EFBCache::~EFBCache()
+{
+	for (Plane& plane : m_planes)
+	{
+		Unmap(plane);
+		SAFE_RELEASE(plane.tex);
+		SAFE_RELEASE(plane.staging);
+	}
+}
+
+void EFBCache::Unmap(Plane& plane)
+{
+	if (plane.map.pData)
+	{
+		D3D::context->Unmap(plane.staging, 0);
+		plane.map.pData = nullptr;
+	}
+}
+
+void EFBCache::StartReadback(EFBAccessType type)
+{
+	Plane& plane = GetPlane(type);
+	bool depth = type == PEEK_Z;
+	Unmap(plane);
+
+	// for non-1xIR or multisampled cases, we need to copy to an intermediate texture first
+	ID3D11Texture2D* src_texture;
+	if (g_ActiveConfig.iEFBScale != SCALE_1X || g_ActiveConfig.iMultisamples > 1)
+	{
+		g_renderer->ResetAPIState();
+
+		CD3D11_RECT src_rect(0, 0, Renderer::GetTargetWidth(), Renderer::GetTargetHeight());
+		CD3D11_VIEWPORT vp(0.0f, 0.0f, EFB_WIDTH, EFB_HEIGHT);
+		D3D::context->RSSetViewports(1, &vp);
+		D3D::context->OMSetRenderTargets(1, &plane.tex->GetRTV(), nullptr);
+		D3D::SetPointCopySampler();
+
+		// MSAA has to go through a different path for depth
+		ID3D11PixelShader* pixel_shader = PixelShaderCache::GetColorCopyProgram(!depth);
+		if (depth && g_ActiveConfig.iMultisamples > 1)
+			pixel_shader = PixelShaderCache::GetDepthResolveProgram();
+
+		D3DTexture2D* efb_tex = depth ? FramebufferManager::GetEFBDepthTexture() : FramebufferManager::GetEFBColorTexture();
+		D3D::drawShadedTexQuad(efb_tex->GetSRV(), &src_rect, Renderer::GetTargetWidth(), Renderer::GetTargetHeight(),
+			pixel_shader, VertexShaderCache::GetSimpleVertexShader(), VertexShaderCache::GetSimpleInputLayout(),
+			nullptr, 1.0f, 0);
+
+		D3D::context->OMSetRenderTargets(1, &FramebufferManager::GetEFBColorTexture()->GetRTV(), FramebufferManager::GetEFBDepthTexture()->GetDSV());
+		g_renderer->RestoreAPIState();
+
+		src_texture = plane.tex->GetTex();
+	}
+	else
+	{
+		// can copy directly from efb texture
+		src_texture = depth ? FramebufferManager::GetEFBDepthTexture()->GetTex() : FramebufferManager::GetEFBColorTexture()->GetTex();
+	}
+
+	D3D::context->CopySubresourceRegion(plane.staging, 0, 0, 0, 0, src_texture, 0, nullptr);
+}
+
+bool EFBCache::IsReadbackDone(EFBAccessType type)
+{
+	Plane& plane = GetPlane(type);
+	if (plane.map.pData)
+		return true;
+
+	HRESULT hr = D3D::context->Map(plane.staging, 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &plane.map);
+	if (FAILED(hr))
+	{
+		plane.map.pData = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void EFBCache::FinishReadback(EFBAccessType type, u32* data)
+{
+	Plane& plane = GetPlane(type);
+	if (!plane.map.pData)
+	{
+		HRESULT hr = D3D::context->Map(plane.staging, 0, D3D11_MAP_READ, 0, &plane.map);
+		CHECK(SUCCEEDED(hr), "failed to map efb peek cache texture (hr=%08X)", hr);
+		if (FAILED(hr))
+		{
+			plane.map.pData = nullptr;
+			return;
+		}
+	}
+
+	for (u32 y = 0; y < EFB_HEIGHT; ++y)
+	{
+		const u8* row = static_cast<const u8*>(plane.map.pData) + y * plane.map.RowPitch;
+		u32* dst = data + y * EFB_WIDTH;
+		if (type == PEEK_Z)
+		{
+			// depth buffer is inverted in the d3d backend
+			const float* src = reinterpret_cast<const float*>(row);
+			for (u32 x = 0; x < EFB_WIDTH; ++x)
+				dst[x] = MathUtil::Clamp<u32>((u32)((1.0f - src[x]) * 16777216.0f), 0, 0xFFFFFF);
+		}
+		else
+		{
+			// our internal buffers are RGBA, yet a BGRA value is expected
+			const u32* src = reinterpret_cast<const u32*>(row);
+			for (u32 x = 0; x < EFB_WIDTH; ++x)
+				dst[x] = RGBA8ToBGRA8(src[x]);
+		}
+	}
+
+	Unmap(plane);
+}
+
+}  // namespace DX11
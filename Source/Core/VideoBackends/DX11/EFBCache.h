@@ -0,0 +1,42 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "VideoBackends/DX11/D3DBase.h"
+
+#include "VideoCommon/EFBCacheBase.h"
+
+namespace DX11
+{
+
+class D3DTexture2D;
+
+class EFBCache : public EFBCacheBase
+{
+public:
+	EFBCache();
+	~EFBCache();
+
+protected:
+	void StartReadback(EFBAccessType type) override;
+	bool IsReadbackDone(EFBAccessType type) override;
+	void FinishReadback(EFBAccessType type, u32* data) override;
+
+private:
+	struct Plane
+	{
+		// Render target used to downsample the EFB to native resolution
+		D3DTexture2D* tex = nullptr;
+		ID3D11Texture2D* staging = nullptr;
+		D3D11_MAPPED_SUBRESOURCE map = {};
+	};
+
+	Plane& GetPlane(EFBAccessType type) { return m_planes[type == PEEK_Z ? 1 : 0]; }
+	void Unmap(Plane& plane);
+
+	Plane m_planes[2];
+};
+
+}  // namespace DX11
@@ -92,18 +92,9 @@ public:
 		m_efb.color_tex = swaptex;
 	}
 
-	static u32 GetEFBCachedColor(u32 x, u32 y);
-	static float GetEFBCachedDepth(u32 x, u32 y);
-	static void SetEFBCachedColor(u32 x, u32 y, u32 value);
-	static void SetEFBCachedDepth(u32 x, u32 y, float value);
-	static void PopulateEFBColorCache();
-	static void PopulateEFBDepthCache();
-	static void InvalidateEFBCache();
-
 private:
 	std::unique_ptr<XFBSourceBase> CreateXFBSource(u32 target_width, u32 target_height, u32 layers) override;
 	void GetTargetSize(u32 *width, u32 *height) override;
-	static void InitializeEFBCache();
 	void CopyToRealXFB(u32 xfbAddr, u32 fbStride, u32 fbHeight, const EFBRectangle& sourceRc, float Gamma) override;
 
 	static struct Efb
@@ -115,15 +106,6 @@ private:
 		D3DTexture2D* depth_tex{};
 		D3DTexture2D* resolved_depth_tex{};
 
-		// EFB Cache
-		D3DTexture2D* color_cache_tex{};
-		ID3D11Texture2D* color_cache_buf{};
-		D3D11_MAPPED_SUBRESOURCE color_cache_buf_map{};
-
-		D3DTexture2D* depth_cache_tex{};
-		ID3D11Texture2D* depth_cache_buf{};
-		D3D11_MAPPED_SUBRESOURCE depth_cache_buf_map{};
-
 		int slices{};
 	} m_efb;
 
@@ -36,6 +36,7 @@
 
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/EFBCacheBase.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/OnScreenDisplay.h"
@@ -378,26 +379,17 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 {
 	if (type == PEEK_Z)
 	{
-		float val = FramebufferManager::GetEFBCachedDepth(x, y);
-		// depth buffer is inverted in the d3d backend
-		val = 1.0f - val;
-		u32 ret = 0;
+		u32 ret = g_efb_cache->Peek(type, x, y);
+
+		// if Z is in 16 bit format you must return a 16 bit integer
 		if (bpmem.zcontrol.pixel_format == PEControl::RGB565_Z16)
-		{
-			// if Z is in 16 bit format you must return a 16 bit integer
-			ret = MathUtil::Clamp<u32>((u32)(val * 65536.0f), 0, 0xFFFF);
-		}
-		else
-		{
-			ret = MathUtil::Clamp<u32>((u32)(val * 16777216.0f), 0, 0xFFFFFF);
-		}
+			ret = ret >> 8;
+
 		return ret;
 	}
 	else if (type == PEEK_COLOR)
 	{
-		u32 ret = FramebufferManager::GetEFBCachedColor(x, y);
-		// our internal buffers are RGBA, yet a BGRA value is expected
-		ret = RGBA8ToBGRA8(ret);
+		u32 ret = g_efb_cache->Peek(type, x, y);
 
 		// check what to do with the alpha channel (GX_PokeAlphaRead)
 		PixelEngine::UPEAlphaReadReg alpha_read_mode = PixelEngine::GetAlphaReadMode();
@@ -451,6 +443,8 @@ void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* data, size_t num_p
 	}
 
 	RestoreAPIState();
+
+	g_efb_cache->Poke(type, data, num_points);
 }
 
 // Called from VertexShaderManager
@@ -535,7 +529,7 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaE
 
 	RestoreAPIState();
 
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 void Renderer::ReinterpretPixelData(unsigned int convtype)
@@ -573,7 +567,7 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
 	FramebufferManager::SwapReinterpretTexture();
 	D3D::context->OMSetRenderTargets(1, &FramebufferManager::GetEFBColorTexture()->GetRTV(), FramebufferManager::GetEFBDepthTexture()->GetDSV());
 
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 void Renderer::SetBlendMode(bool forceUpdate)
@@ -1039,7 +1033,7 @@ void Renderer::ApplyState(bool bUseDstAlpha)
 	D3D::stateman->SetDomainShader(HullDomainShaderCache::GetActiveDomainShader());
 	D3D::stateman->SetPixelShader(PixelShaderCache::GetActiveShader());
 
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 void Renderer::RestoreState()
@@ -31,6 +31,7 @@
 #include "VideoBackends/DX11/BoundingBox.h"
 #include "VideoBackends/DX11/D3DUtil.h"
 #include "VideoBackends/DX11/D3DBase.h"
+#include "VideoBackends/DX11/EFBCache.h"
 #include "VideoBackends/DX11/GeometryShaderCache.h"
 #include "VideoBackends/DX11/HullDomainShaderCache.h"
 #include "VideoBackends/DX11/PerfQuery.h"
@@ -103,6 +104,7 @@ void VideoBackend::InitBackendInfo()
 	g_Config.backend_info.bSupportsClipControl = true;
 	g_Config.backend_info.bSupportsNormalMaps = true;
 	g_Config.backend_info.bSupportsDepthClamp = true;
+	g_Config.backend_info.bSupportsPrimitiveRestart = false;
 	IDXGIFactory* factory;
 	IDXGIAdapter* ad;
 	hr = DX11::PCreateDXGIFactory(__uuidof(IDXGIFactory), (void**)&factory);
@@ -186,6 +188,7 @@ void VideoBackend::Video_Prepare()
 	g_texture_cache = std::make_unique<TextureCache>();
 	g_vertex_manager = std::make_unique<VertexManager>();
 	g_perf_query = std::make_unique<PerfQuery>();
+	g_efb_cache = std::make_unique<EFBCache>();
 	VertexShaderCache::Init();
 	PixelShaderCache::Init();
 	D3D::InitUtils();
@@ -227,6 +230,7 @@ void VideoBackend::Shutdown()
 	HullDomainShaderCache::Shutdown();
 	VertexShaderCache::Shutdown();
 	BBox::Shutdown();
+	g_efb_cache.reset();
 	g_perf_query.reset();
 	g_vertex_manager.reset();
 	g_texture_cache.reset();
@@ -504,10 +504,6 @@ void DrawEFBPokeQuads(EFBAccessType type, const EfbPokeData* points, size_t num_
 		vertex[3] = { x1, y2, z, 1.0, col };
 		vertex[4] = { x2, y1, z, 1.0, col };
 		vertex[5] = { x2, y2, z, 1.0, col };
-		if (type == POKE_COLOR)
-			FramebufferManager::SetEFBCachedColor(point.x, point.y, col);
-		else
-			FramebufferManager::SetEFBCachedDepth(point.x, point.y, u32(z * 0xFFFFFF));
 	}
 	D3D::ChangeVertexShader(Vshader);
 	D3D::ChangePixelShader(PShader);
@@ -0,0 +1,153 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoBackends/DX9/D3DBase.h"
+#include "VideoBackends/DX9/D3DUtil.h"
+#include "VideoBackends/DX9/EFBCache.h"
+#include "VideoBackends/DX9/FramebufferManager.h"
+#include "VideoBackends/DX9/PixelShaderCache.h"
+#include "VideoBackends/DX9/Render.h"
+#include "VideoBackends/DX9/VertexShaderCache.h"
+
+#include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/VideoCommon.h"
+
+namespace DX9
+{
+
+#define SAFE_RELEASE(p) if (p) { (p)->Release(); (p) = nullptr; }
+
+#undef CHECK
+#define CHECK(hr, Message, ...) if (FAILED(hr)) { PanicAlert(__FUNCTION__ "Failed in %s at line %d: " Message, __FILE__, __LINE__, __VA_ARGS__); }
+
+EFBCache::EFBCache()
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		Plane& plane = m_planes[i];
+		D3DFORMAT format = FramebufferManager::GetEFBColorRTSurfaceFormat();
+		if (i)
+		{
+			// Z peeks are disabled without depth textures
+			if (!FramebufferManager::GetEFBDepthTexture())
+				break;
+			// D24X8 isn't a valid render target everywhere, A8R8G8B8 is expected to work on all hardware
+			format = D3D::CheckTextureSupport(D3DUSAGE_RENDERTARGET, D3DFMT_D24X8) ? D3DFMT_D24X8 : D3DFMT_A8R8G8B8;
+		}
+
+		HRESULT hr = D3D::dev->CreateTexture(EFB_WIDTH, EFB_HEIGHT, 1, D3DUSAGE_RENDERTARGET, format,
+			D3DPOOL_DEFAULT, &plane.texture, nullptr);
+		CHECK(hr, "Create EFB cache texture (hr=%#x)", hr);
+		if (plane.texture)
+			plane.texture->GetSurfaceLevel(0, &plane.surface);
+
+		hr = D3D::dev->CreateOffscreenPlainSurface(EFB_WIDTH, EFB_HEIGHT, format, D3DPOOL_SYSTEMMEM, &plane.buffer, nullptr);
+		CHECK(hr, "Create EFB cache offscreen surface (hr=%#x)", hr);
+
+		// Without event queries every readback is waited for
+		D3D::dev->CreateQuery(D3DQUERYTYPE_EVENT, &plane.query);
+	}
+}
+
+EFBCache::~EFBCache()
+{
+	for (Plane& plane : m_planes)
+	{
+		SAFE_RELEASE(plane.query);
+		SAFE_RELEASE(plane.buffer);
+		SAFE_RELEASE(plane.surface);
+		SAFE_RELEASE(plane.texture);
+	}
+}
+
+void EFBCache::StartReadback(EFBAccessType type)
+{
+	Plane& plane = GetPlane(type);
+
+	if (type == PEEK_COLOR)
+	{
+		// We can't directly StretchRect to System buf because is not supported by all implementations
+		// this is the only safe path that works in most cases
+		HRESULT hr = D3D::dev->StretchRect(FramebufferManager::GetEFBColorRTSurface(), nullptr, plane.surface, nullptr, D3DTEXF_LINEAR);
+		CHECK(hr, "failed to stretch efb peek color cache texture (hr=%08X)", hr);
+	}
+	else
+	{
+		g_renderer->ResetAPIState(); // Reset any game specific settings
+		D3D::dev->SetDepthStencilSurface(nullptr);
+		D3D::dev->SetRenderTarget(0, plane.surface);
+
+		// Stretch picture with increased internal resolution
+		D3DVIEWPORT9 vp;
+		vp.X = 0;
+		vp.Y = 0;
+		vp.Width = EFB_WIDTH;
+		vp.Height = EFB_HEIGHT;
+		vp.MinZ = 0.0f;
+		vp.MaxZ = 1.0f;
+		D3D::dev->SetViewport(&vp);
+
+		float colmat[28] = { 0.0f };
+		colmat[0] = colmat[5] = colmat[10] = 1.0f;
+		PixelShaderManager::SetColorMatrix(colmat); // set transformation
+		D3D::dev->SetPixelShaderConstantF(C_COLORMATRIX, PixelShaderManager::GetBuffer(), 7);
+
+		D3D::ChangeSamplerState(0, D3DSAMP_MINFILTER, D3DTEXF_POINT);
+
+		D3DFORMAT bformat = FramebufferManager::GetEFBDepthRTSurfaceFormat();
+
+		D3D::drawShadedTexQuad(
+			FramebufferManager::GetEFBDepthTexture(),
+			nullptr,
+			Renderer::GetTargetWidth(),
+			Renderer::GetTargetHeight(),
+			EFB_WIDTH, EFB_HEIGHT,
+			PixelShaderCache::GetDepthMatrixProgram(0, bformat != FOURCC_RAWZ),
+			VertexShaderCache::GetSimpleVertexShader(0));
+
+		D3D::RefreshSamplerState(0, D3DSAMP_MINFILTER);
+
+		D3D::dev->SetRenderTarget(0, FramebufferManager::GetEFBColorRTSurface());
+		D3D::dev->SetDepthStencilSurface(FramebufferManager::GetEFBDepthRTSurface());
+		g_renderer->RestoreAPIState();
+	}
+
+	if (plane.query)
+		plane.query->Issue(D3DISSUE_END);
+}
+
+bool EFBCache::IsReadbackDone(EFBAccessType type)
+{
+	Plane& plane = GetPlane(type);
+	return plane.query && plane.query->GetData(nullptr, 0, D3DGETDATA_FLUSH) == S_OK;
+}
+
+void EFBCache::FinishReadback(EFBAccessType type, u32* data)
+{
+	Plane& plane = GetPlane(type);
+
+	// Retrieve the pixel data to the local memory buffer
+	HRESULT hr = D3D::dev->GetRenderTargetData(plane.surface, plane.buffer);
+	CHECK(hr, "failed to get data from efb peek cache texture (hr=%08X)", hr);
+
+	D3DLOCKED_RECT lock_rect;
+	hr = plane.buffer->LockRect(&lock_rect, nullptr, D3DLOCK_READONLY);
+	CHECK(hr, "failed to map efb peek cache texture (hr=%08X)", hr);
+	if (FAILED(hr))
+		return;
+
+	// The color surface is A8R8G8B8 already, and the depth matrix program writes 24-bit depth
+	const u32 mask = type == PEEK_Z ? 0xFFFFFF : 0xFFFFFFFF;
+	for (u32 y = 0; y < EFB_HEIGHT; ++y)
+	{
+		const u32* src = reinterpret_cast<const u32*>(static_cast<const u8*>(lock_rect.pBits) + y * lock_rect.Pitch);
+		u32* dst = data + y * EFB_WIDTH;
+		for (u32 x = 0; x < EFB_WIDTH; ++x)
+			dst[x] = src[x] & mask;
+	}
+
+	plane.buffer->UnlockRect();
+}
+
+}  // namespace DX9
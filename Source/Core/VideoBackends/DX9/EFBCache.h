@@ -0,0 +1,43 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "VideoBackends/DX9/D3DBase.h"
+
+#include "VideoCommon/EFBCacheBase.h"
+
+namespace DX9
+{
+
+// Created and destroyed with the other POOL_DEFAULT device objects
+class EFBCache : public EFBCacheBase
+{
+public:
+	EFBCache();
+	~EFBCache();
+
+protected:
+	void StartReadback(EFBAccessType type) override;
+	bool IsReadbackDone(EFBAccessType type) override;
+	void FinishReadback(EFBAccessType type, u32* data) override;
+
+private:
+	struct Plane
+	{
+		// Render target the EFB is downsampled to
+		LPDIRECT3DTEXTURE9 texture = nullptr;
+		LPDIRECT3DSURFACE9 surface = nullptr;
+		// System memory surface that can be locked to retrieve the data
+		LPDIRECT3DSURFACE9 buffer = nullptr;
+		// Signaled once the GPU is done with the downsample, so copying it back doesn't stall
+		LPDIRECT3DQUERY9 query = nullptr;
+	};
+
+	Plane& GetPlane(EFBAccessType type) { return m_planes[type == PEEK_Z ? 1 : 0]; }
+
+	Plane m_planes[2];
+};
+
+}  // namespace DX9
@@ -33,31 +33,6 @@ FramebufferManager::Efb FramebufferManager::s_efb;
 u32 FramebufferManager::m_target_width;
 u32 FramebufferManager::m_target_height;
 
-void FramebufferManager::InitializeEFBCache()
-{
-	// Render buffer for AccessEFB (color data)
-	HRESULT hr = D3D::dev->CreateTexture(EFB_WIDTH, EFB_HEIGHT, 1, D3DUSAGE_RENDERTARGET, s_efb.color_surface_Format,
-		D3DPOOL_DEFAULT, &s_efb.color_cache_texture, NULL);
-	GetSurface(s_efb.color_cache_texture, &s_efb.color_cache_surf);
-	CHECK(hr, "Create Color Read Texture (hr=%#x)", hr);
-
-	// AccessEFB - Sysmem buffer used to retrieve the pixel data from color_ReadBuffer
-	hr = D3D::dev->CreateOffscreenPlainSurface(EFB_WIDTH, EFB_HEIGHT, s_efb.color_surface_Format, D3DPOOL_SYSTEMMEM, &s_efb.color_cache_buf, NULL);
-	CHECK(hr, "Create offscreen color surface (hr=%#x)", hr);
-	if (s_efb.depth_textures_supported)
-	{
-		hr = D3D::dev->CreateTexture(EFB_WIDTH, EFB_HEIGHT, 1, D3DUSAGE_RENDERTARGET, s_efb.depth_cache_Format,
-			D3DPOOL_DEFAULT, &s_efb.depth_cache_texture, NULL);
-		GetSurface(s_efb.depth_cache_texture, &s_efb.depth_cache_surf);
-		CHECK(hr, "Create depth read texture (hr=%#x)", hr);
-
-		// AccessEFB - Sysmem buffer used to retrieve the pixel data from depth_ReadBuffer
-		hr = D3D::dev->CreateOffscreenPlainSurface(EFB_WIDTH, EFB_HEIGHT, s_efb.depth_cache_Format, D3DPOOL_SYSTEMMEM, &s_efb.depth_cache_buf, NULL);
-		CHECK(hr, "Create depth offscreen surface (hr=%#x)", hr);
-	}
-
-}
-
 FramebufferManager::FramebufferManager()
 {
 	s_efb.depth_textures_supported = true;
@@ -90,21 +65,6 @@ FramebufferManager::FramebufferManager()
 			D3DPOOL_DEFAULT, &s_efb.depth_texture, NULL);
 		GetSurface(s_efb.depth_texture, &s_efb.depth_surface);
 		CHECK(hr, "Framebuffer depth texture (size: %dx%d; hr=%#x)", m_target_width, m_target_height, hr);
-
-		// Render buffer for AccessEFB (depth data)
-		D3DFORMAT DepthTexFormats[2];
-		DepthTexFormats[0] = D3DFMT_D24X8;
-		// This is expected to work on all hardware
-		DepthTexFormats[1] = D3DFMT_A8R8G8B8;
-
-		for (int i = 0; i < 2; ++i)
-		{
-			if (D3D::CheckTextureSupport(D3DUSAGE_RENDERTARGET, DepthTexFormats[i]))
-			{
-				s_efb.depth_cache_Format = DepthTexFormats[i];
-				break;
-			}
-		}
 	}
 	else if (s_efb.depth_surface_Format)
 	{
@@ -118,27 +78,18 @@ FramebufferManager::FramebufferManager()
 		D3DPOOL_DEFAULT, &s_efb.color_reinterpret_texture, NULL);
 	GetSurface(s_efb.color_reinterpret_texture, &s_efb.color_reinterpret_surface);
 	CHECK(hr, "Create color reinterpret texture (size: %dx%d; hr=%#x)", m_target_width, m_target_height, hr);
-	InitializeEFBCache();
 }
 
 FramebufferManager::~FramebufferManager()
 {
-	FramebufferManager::InvalidateEFBCache();
 	SAFE_RELEASE(s_efb.depth_surface);
 	SAFE_RELEASE(s_efb.color_surface);
-	SAFE_RELEASE(s_efb.color_cache_surf);
-	SAFE_RELEASE(s_efb.depth_cache_surf);
-	SAFE_RELEASE(s_efb.color_cache_buf);
-	SAFE_RELEASE(s_efb.depth_cache_surf);
 	SAFE_RELEASE(s_efb.color_texture);
-	SAFE_RELEASE(s_efb.color_cache_texture);
 	SAFE_RELEASE(s_efb.depth_texture);
-	SAFE_RELEASE(s_efb.depth_cache_texture);
 	SAFE_RELEASE(s_efb.color_reinterpret_texture);
 	SAFE_RELEASE(s_efb.color_reinterpret_surface);
 	s_efb.color_surface_Format = D3DFMT_UNKNOWN;
 	s_efb.depth_surface_Format = D3DFMT_UNKNOWN;
-	s_efb.depth_cache_Format = D3DFMT_UNKNOWN;
 }
 
 std::unique_ptr<XFBSourceBase> FramebufferManager::CreateXFBSource(u32 target_width, u32 target_height, u32 layers)
@@ -231,124 +182,4 @@ void XFBSource::CopyEFB(float Gamma)
 	g_renderer->RestoreAPIState();
 }
 
-u32 FramebufferManager::GetEFBCachedDepth(u32 x, u32 y)
-{
-	if (!s_efb.depth_lock_rect.pBits)
-		PopulateEFBDepthCache();
-
-	u32 row_offset = y * s_efb.depth_lock_rect.Pitch;
-	u32* row = reinterpret_cast<u32*>(reinterpret_cast<u8*>(s_efb.depth_lock_rect.pBits) + row_offset);
-	return row[x];
-}
-
-u32 FramebufferManager::GetEFBCachedColor(u32 x, u32 y)
-{
-	if (!s_efb.color_lock_rect.pBits)
-		PopulateEFBColorCache();
-
-	u32 row_offset = y * s_efb.color_lock_rect.Pitch;
-	u32* row = reinterpret_cast<u32*>(reinterpret_cast<u8*>(s_efb.color_lock_rect.pBits) + row_offset);
-	return row[x];
-}
-
-void FramebufferManager::SetEFBCachedColor(u32 x, u32 y, u32 value)
-{
-	if (!s_efb.color_lock_rect.pBits)
-		return;
-
-	u32 row_offset = y * s_efb.color_lock_rect.Pitch;
-	u32* row = reinterpret_cast<u32*>(reinterpret_cast<u8*>(s_efb.color_lock_rect.pBits) + row_offset);
-	row[x] = value;
-}
-
-void FramebufferManager::SetEFBCachedDepth(u32 x, u32 y, u32 value)
-{
-	if (!s_efb.depth_lock_rect.pBits)
-		PopulateEFBDepthCache();
-
-	u32 row_offset = y * s_efb.depth_lock_rect.Pitch;
-	u32* row = reinterpret_cast<u32*>(reinterpret_cast<u8*>(s_efb.depth_lock_rect.pBits) + row_offset);
-	row[x] = value;
-}
-
-void FramebufferManager::PopulateEFBColorCache()
-{
-	_dbg_assert_(!s_efb.color_lock_rect.pBits, "cache is invalid");
-
-	// We can't directly StretchRect to System buf because is not supported by all implementations
-	// this is the only safe path that works in most cases
-	HRESULT hr = D3D::dev->StretchRect(s_efb.color_surface, nullptr, s_efb.color_cache_surf, nullptr, D3DTEXF_LINEAR);
-	CHECK(SUCCEEDED(hr), "failed to stretch efb peek color cache texture (hr=%08X)", hr);
-	hr = D3D::dev->GetRenderTargetData(s_efb.color_cache_surf, s_efb.color_cache_buf);
-	CHECK(SUCCEEDED(hr), "failed to get data from efb peek color cache texture (hr=%08X)", hr);
-	hr = s_efb.color_cache_buf->LockRect(&s_efb.color_lock_rect, nullptr, D3DLOCK_READONLY);
-	CHECK(SUCCEEDED(hr), "failed to map efb peek color cache texture (hr=%08X)", hr);
-}
-
-void FramebufferManager::PopulateEFBDepthCache()
-{
-	_dbg_assert_(!s_efb.dept_lock_rect.pBits, "cache is invalid");
-
-	g_renderer->ResetAPIState(); // Reset any game specific settings
-	D3D::dev->SetDepthStencilSurface(NULL);
-	D3D::dev->SetRenderTarget(0, s_efb.depth_cache_surf);
-
-	// Stretch picture with increased internal resolution
-	D3DVIEWPORT9 vp;
-	vp.X = 0;
-	vp.Y = 0;
-	vp.Width = EFB_WIDTH;
-	vp.Height = EFB_HEIGHT;
-	vp.MinZ = 0.0f;
-	vp.MaxZ = 1.0f;
-	D3D::dev->SetViewport(&vp);
-
-	float colmat[28] = { 0.0f };
-	colmat[0] = colmat[5] = colmat[10] = 1.0f;
-	PixelShaderManager::SetColorMatrix(colmat); // set transformation
-	D3D::dev->SetPixelShaderConstantF(C_COLORMATRIX, PixelShaderManager::GetBuffer(), 7);
-	LPDIRECT3DTEXTURE9 read_texture = FramebufferManager::GetEFBDepthTexture();
-
-	D3D::ChangeSamplerState(0, D3DSAMP_MINFILTER, D3DTEXF_POINT);
-
-	D3DFORMAT bformat = FramebufferManager::GetEFBDepthRTSurfaceFormat();
-
-	D3D::drawShadedTexQuad(
-		read_texture,
-		nullptr,
-		Renderer::GetTargetWidth(),
-		Renderer::GetTargetHeight(),
-		EFB_WIDTH, EFB_HEIGHT,
-		PixelShaderCache::GetDepthMatrixProgram(0, bformat != FOURCC_RAWZ),
-		VertexShaderCache::GetSimpleVertexShader(0));
-
-	D3D::RefreshSamplerState(0, D3DSAMP_MINFILTER);
-
-	D3D::dev->SetRenderTarget(0, FramebufferManager::GetEFBColorRTSurface());
-	D3D::dev->SetDepthStencilSurface(FramebufferManager::GetEFBDepthRTSurface());
-	g_renderer->RestoreAPIState();
-
-	// Retrieve the pixel data to the local memory buffer
-	HRESULT hr = D3D::dev->GetRenderTargetData(s_efb.depth_cache_surf, s_efb.depth_cache_buf);
-
-	// EFB data successfully retrieved, now get the pixel data
-	hr = s_efb.depth_cache_buf->LockRect(&s_efb.depth_lock_rect, nullptr, D3DLOCK_READONLY);
-	CHECK(SUCCEEDED(hr), "failed to map efb peek depth cache texture (hr=%08X)", hr);
-}
-
-void FramebufferManager::InvalidateEFBCache()
-{
-	if (s_efb.color_lock_rect.pBits)
-	{
-		s_efb.color_cache_buf->UnlockRect();
-		s_efb.color_lock_rect.pBits = nullptr;
-	}
-
-	if (s_efb.depth_lock_rect.pBits)
-	{
-		s_efb.depth_cache_buf->UnlockRect();
-		s_efb.depth_lock_rect.pBits = nullptr;
-	}
-}
-
 }  // namespace DX9
@@ -109,18 +109,9 @@ public:
 		s_efb.color_texture = swaptex;
 	}
 
-	static u32 GetEFBCachedColor(u32 x, u32 y);
-	static u32 GetEFBCachedDepth(u32 x, u32 y);
-	static void SetEFBCachedColor(u32 x, u32 y, u32 value);
-	static void SetEFBCachedDepth(u32 x, u32 y, u32 value);
-	static void PopulateEFBColorCache();
-	static void PopulateEFBDepthCache();
-	static void InvalidateEFBCache();
-
 private:
 	std::unique_ptr<XFBSourceBase> CreateXFBSource(u32 target_width, u32 target_height, u32 layers);
 	void GetTargetSize(u32 *width, u32 *height);
-	static void InitializeEFBCache();
 	void CopyToRealXFB(u32 xfbAddr, u32 fbStride, u32 fbHeight, const EFBRectangle& sourceRc, float Gamma);
 
 	static struct Efb
@@ -133,20 +124,9 @@ private:
 
 		D3DFORMAT color_surface_Format{};//Format of the color Surface
 		D3DFORMAT depth_surface_Format{};//Format of the Depth Surface
-		D3DFORMAT depth_cache_Format{};//Format of the Depth color Read Surface
 
 		LPDIRECT3DTEXTURE9 color_reinterpret_texture{};//buffer used for ReinterpretPixelData
 		LPDIRECT3DSURFACE9 color_reinterpret_surface{};//corresponding surface
-
-		LPDIRECT3DTEXTURE9 color_cache_texture{};//texture for temporal data store
-		LPDIRECT3DSURFACE9 color_cache_surf{};//Surface 0 of color_cache_texture
-		LPDIRECT3DSURFACE9 color_cache_buf{};//System memory Surface that can be locked to retrieve the data
-		D3DLOCKED_RECT color_lock_rect{};
-
-		LPDIRECT3DTEXTURE9 depth_cache_texture{};//texture for temporal data store
-		LPDIRECT3DSURFACE9 depth_cache_surf{};//Surface 0 of depth_cache_texture
-		LPDIRECT3DSURFACE9 depth_cache_buf{};//System memory Surface that can be locked to retrieve the data
-		D3DLOCKED_RECT depth_lock_rect{};
 		bool depth_textures_supported{};
 	} s_efb;
 
@@ -20,6 +20,7 @@
 #include "Core/Movie.h"
 
 #include "VideoBackends/DX9/D3DUtil.h"
+#include "VideoBackends/DX9/EFBCache.h"
 #include "VideoBackends/DX9/FramebufferManager.h"
 #include "VideoBackends/DX9/PerfQuery.h"
 #include "VideoBackends/DX9/PixelShaderCache.h"
@@ -31,6 +32,7 @@
 
 #include "VideoCommon/AVIDump.h"
 #include "VideoCommon/Debugger.h"
+#include "VideoCommon/EFBCacheBase.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/FPSCounter.h"
 #include "VideoCommon/BPFunctions.h"
@@ -64,6 +66,7 @@ void SetupDeviceObjects()
 	D3D::font.Init();
 	VertexLoaderManager::Init();
 	g_framebuffer_manager = std::make_unique<FramebufferManager>();
+	g_efb_cache = std::make_unique<EFBCache>();
 
 	VertexShaderManager::Dirty();
 	PixelShaderManager::Dirty();
@@ -85,6 +88,7 @@ void TeardownDeviceObjects()
 	ScreenShootMEMSurface = NULL;
 	D3D::dev->SetRenderTarget(0, D3D::GetBackBufferSurface());
 	D3D::dev->SetDepthStencilSurface(D3D::GetBackBufferDepthSurface());
+	g_efb_cache.reset();
 	g_framebuffer_manager.reset();
 	static_cast<PerfQuery*>(g_perf_query.get())->DestroyDeviceObjects();
 	D3D::font.Shutdown();
@@ -300,7 +304,7 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 
 	if (type == PEEK_Z)
 	{
-		u32 z = FramebufferManager::GetEFBCachedDepth(x, y);
+		u32 z = g_efb_cache->Peek(type, x, y);
 
 		// if Z is in 16 bit format you must return a 16 bit integer
 		if (bpmem.zcontrol.pixel_format == PEControl::RGB565_Z16)
@@ -311,7 +315,7 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 	}
 	else if (type == PEEK_COLOR)
 	{
-		u32 ret = FramebufferManager::GetEFBCachedColor(x, y);
+		u32 ret = g_efb_cache->Peek(type, x, y);
 
 		// check what to do with the alpha channel (GX_PokeAlphaRead)
 		PixelEngine::UPEAlphaReadReg alpha_read_mode = PixelEngine::GetAlphaReadMode();
@@ -378,6 +382,8 @@ void Renderer::PokeEFB(EFBAccessType type, const EfbPokeData* points, size_t num
 	D3D::DrawEFBPokeQuads(type, points, num_points, PixelShaderCache::GetClearProgram(), VertexShaderCache::GetClearVertexShader());
 
 	RestoreAPIState();
+
+	g_efb_cache->Poke(type, points, num_points);
 }
 
 void Renderer::ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaEnable, bool zEnable, u32 color, u32 z)
@@ -412,7 +418,7 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaE
 	D3D::drawClearQuad(color, (0xFFFFFF - (z & 0xFFFFFF)) / 16777216.0f, PixelShaderCache::GetClearProgram(), VertexShaderCache::GetClearVertexShader());
 	RestoreAPIState();
 
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 void Renderer::ReinterpretPixelData(unsigned int convtype)
@@ -448,7 +454,7 @@ void Renderer::ReinterpretPixelData(unsigned int convtype)
 	FramebufferManager::SwapReinterpretTexture();
 	D3D::RefreshSamplerState(0, D3DSAMP_MINFILTER);
 	RestoreAPIState();
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 bool Renderer::SaveScreenshot(const std::string &filename, const TargetRectangle &dst_rect)
@@ -955,7 +961,7 @@ void Renderer::ApplyState(bool bUseDstAlpha)
 			D3D::ChangeRenderState(D3DRS_ZFUNC, D3DCMP_EQUAL);
 		}
 	}
-	FramebufferManager::InvalidateEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 void Renderer::RestoreState()
@@ -0,0 +1,153 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/MathUtil.h"
+#include "Common/GL/GLInterfaceBase.h"
+#include "Common/GL/GLUtil.h"
+
+#include "VideoBackends/OGL/EFBCache.h"
+#include "VideoBackends/OGL/FramebufferManager.h"
+#include "VideoBackends/OGL/Render.h"
+
+#include "VideoCommon/VideoCommon.h"
+
+namespace OGL
+{
+
+EFBCache::EFBCache()
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		Plane& plane = m_planes[i];
+
+		glGenRenderbuffers(1, &plane.renderbuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, plane.renderbuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, i ? GL_DEPTH_COMPONENT32F : GL_RGBA8, EFB_WIDTH, EFB_HEIGHT);
+
+		glGenFramebuffers(1, &plane.framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, plane.framebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, i ? GL_DEPTH_ATTACHMENT : GL_COLOR_ATTACHMENT0,
+			GL_RENDERBUFFER, plane.renderbuffer);
+
+		glGenBuffers(1, &plane.pbo);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, plane.pbo);
+		glBufferData(GL_PIXEL_PACK_BUFFER, EFB_WIDTH * EFB_HEIGHT * sizeof(u32), nullptr, GL_STREAM_READ);
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	FramebufferManager::SetFramebuffer(0);
+}
+
+EFBCache::~EFBCache()
+{
+	for (Plane& plane : m_planes)
+	{
+		if (plane.fence)
+			glDeleteSync(plane.fence);
+		glDeleteBuffers(1, &plane.pbo);
+		glDeleteFramebuffers(1, &plane.framebuffer);
+		glDeleteRenderbuffers(1, &plane.renderbuffer);
+	}
+}
+
+void EFBCache::StartReadback(EFBAccessType type)
+{
+	Plane& plane = GetPlane(type);
+	bool depth = type == PEEK_Z;
+
+	EFBRectangle efb_rect(0, 0, EFB_WIDTH, EFB_HEIGHT);
+	TargetRectangle target_rect = g_renderer->ConvertEFBRectangle(efb_rect);
+
+	g_renderer->ResetAPIState();
+
+	GLuint source = FramebufferManager::GetEFBFramebuffer();
+	if (FramebufferManager::IsMultisampled())
+	{
+		if (depth)
+			FramebufferManager::GetEFBDepthTexture(efb_rect);
+		else
+			FramebufferManager::GetEFBColorTexture(efb_rect);
+		source = FramebufferManager::GetResolvedFramebuffer();
+	}
+
+	// Scale down on the GPU, picking one sample per EFB pixel like the old per-block path did
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, source);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, plane.framebuffer);
+	glBlitFramebuffer(target_rect.left, target_rect.bottom, target_rect.right, target_rect.top,
+		0, 0, EFB_WIDTH, EFB_HEIGHT, depth ? GL_DEPTH_BUFFER_BIT : GL_COLOR_BUFFER_BIT, GL_NEAREST);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, plane.framebuffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, plane.pbo);
+	if (depth)
+		glReadPixels(0, 0, EFB_WIDTH, EFB_HEIGHT, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+	else if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
+		glReadPixels(0, 0, EFB_WIDTH, EFB_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	else
+		glReadPixels(0, 0, EFB_WIDTH, EFB_HEIGHT, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	if (g_ogl_config.bSupportsGLSync)
+	{
+		if (plane.fence)
+			glDeleteSync(plane.fence);
+		plane.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+	}
+
+	FramebufferManager::SetFramebuffer(0);
+	g_renderer->RestoreAPIState();
+}
+
+bool EFBCache::IsReadbackDone(EFBAccessType type)
+{
+	// Without sync objects there's no way to tell, so only stall once the old data is unusable
+	Plane& plane = GetPlane(type);
+	if (!plane.fence)
+		return false;
+
+	GLenum result = glClientWaitSync(plane.fence, 0, 0);
+	return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+void EFBCache::FinishReadback(EFBAccessType type, u32* data)
+{
+	Plane& plane = GetPlane(type);
+	if (plane.fence)
+	{
+		glDeleteSync(plane.fence);
+		plane.fence = 0;
+	}
+
+	const u32 size = EFB_WIDTH * EFB_HEIGHT * sizeof(u32);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, plane.pbo);
+	const void* map = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+
+	// OpenGL rows start at the bottom of the EFB
+	for (u32 row = 0; row < EFB_HEIGHT; ++row)
+	{
+		u32* dst = data + (EFB_HEIGHT - 1 - row) * EFB_WIDTH;
+		if (type == PEEK_Z)
+		{
+			const float* src = static_cast<const float*>(map) + row * EFB_WIDTH;
+			for (u32 x = 0; x < EFB_WIDTH; ++x)
+				dst[x] = MathUtil::Clamp<u32>((u32)(src[x] * 16777216.0f), 0, 0xFFFFFF);
+		}
+		else if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
+		{
+			const u32* src = static_cast<const u32*>(map) + row * EFB_WIDTH;
+			for (u32 x = 0; x < EFB_WIDTH; ++x)
+				dst[x] = (src[x] & 0xFF00FF00) | ((src[x] >> 16) & 0xFF) | ((src[x] & 0xFF) << 16);
+		}
+		else
+		{
+			memcpy(dst, static_cast<const u32*>(map) + row * EFB_WIDTH, EFB_WIDTH * sizeof(u32));
+		}
+	}
+
+	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+}  // namespace OGL
@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "Common/GL/GLUtil.h"
+
+#include "VideoCommon/EFBCacheBase.h"
+
+namespace OGL
+{
+
+class EFBCache : public EFBCacheBase
+{
+public:
+	EFBCache();
+	~EFBCache();
+
+protected:
+	void StartReadback(EFBAccessType type) override;
+	bool IsReadbackDone(EFBAccessType type) override;
+	void FinishReadback(EFBAccessType type, u32* data) override;
+
+private:
+	// Downsamples the EFB to native resolution so only EFB_WIDTH * EFB_HEIGHT values are read back
+	struct Plane
+	{
+		GLuint renderbuffer = 0;
+		GLuint framebuffer = 0;
+		GLuint pbo = 0;
+		GLsync fence = 0;
+	};
+
+	Plane& GetPlane(EFBAccessType type) { return m_planes[type == PEEK_Z ? 1 : 0]; }
+
+	Plane m_planes[2];
+};
+
+}  // namespace OGL
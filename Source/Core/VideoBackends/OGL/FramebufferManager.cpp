@@ -14,6 +14,7 @@
 #include "VideoBackends/OGL/TextureConverter.h"
 
 #include "VideoCommon/DriverDetails.h"
+#include "VideoCommon/EFBCacheBase.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/PostProcessing.h"
 #include "VideoCommon/VertexShaderGen.h"
@@ -700,8 +701,7 @@ void FramebufferManager::PokeEFB(EFBAccessType type, const EfbPokeData* data, si
 
 	g_renderer->RestoreAPIState();
 
-	// TODO: Could just update the EFB cache with the new value
-	ClearEFBCache();
+	g_efb_cache->Poke(type, data, num_points);
 }
 
 }  // namespace OGL
@@ -91,6 +91,10 @@ public:
 	{
 		return m_resolvedFramebuffer[0];
 	}
+	static bool IsMultisampled()
+	{
+		return m_msaaSamples > 1;
+	}
 
 	static void SetFramebuffer(GLuint fb);
 	static void FramebufferTexture(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
@@ -30,9 +30,7 @@ u32 ProgramShaderCache::s_p_ubo_buffer_size;
 u32 ProgramShaderCache::s_g_ubo_buffer_size;
 s32 ProgramShaderCache::s_ubo_align;
 
-static std::unique_ptr<StreamBuffer> s_v_buffer;
-static std::unique_ptr<StreamBuffer> s_p_buffer;
-static std::unique_ptr<StreamBuffer> s_g_buffer;
+static std::unique_ptr<StreamBuffer> s_buffer;
 static int num_failures = 0;
 
 static LinearDiskCache<SHADERUID, u8> g_program_disk_cache;
@@ -151,48 +149,48 @@ void SHADER::Bind()
 
 void ProgramShaderCache::UploadConstants()
 {
-	if (VertexShaderManager::IsDirty())
+	bool vertex_dirty = VertexShaderManager::IsDirty();
+	bool pixel_dirty = PixelShaderManager::IsDirty();
+	bool geometry_dirty = GeometryShaderManager::IsDirty();
+	if (!vertex_dirty && !pixel_dirty && !geometry_dirty)
+		return;
+
+	// All dirty stages share one allocation, so a flush costs a single map and flush
+	u32 size = (vertex_dirty ? s_v_ubo_buffer_size : 0) + (pixel_dirty ? s_p_ubo_buffer_size : 0) +
+		(geometry_dirty ? s_g_ubo_buffer_size : 0);
+	glBindBuffer(GL_UNIFORM_BUFFER, s_buffer->m_buffer);
+	auto buffer = s_buffer->Map(size, s_ubo_align);
+	u32 offset = 0;
+
+	if (vertex_dirty)
 	{
-		glBindBuffer(GL_UNIFORM_BUFFER, s_v_buffer->m_buffer);
-		auto buffer = s_v_buffer->Map(s_v_ubo_buffer_size, s_ubo_align);
 		size_t vertex_buffer_size = VertexShaderManager::ConstantBufferSize * sizeof(float);
-		memcpy(buffer.first, VertexShaderManager::GetBuffer(), vertex_buffer_size);
-
-		s_v_buffer->Unmap(s_v_ubo_buffer_size);
-		glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_v_buffer->m_buffer,
-			buffer.second,
+		memcpy(buffer.first + offset, VertexShaderManager::GetBuffer(), vertex_buffer_size);
+		glBindBufferRange(GL_UNIFORM_BUFFER, 2, s_buffer->m_buffer, buffer.second + offset,
 			vertex_buffer_size);
 		VertexShaderManager::Clear();
-		ADDSTAT(stats.thisFrame.bytesUniformStreamed, s_v_ubo_buffer_size);
+		offset += s_v_ubo_buffer_size;
 	}
-	if (PixelShaderManager::IsDirty())
+	if (pixel_dirty)
 	{
-		glBindBuffer(GL_UNIFORM_BUFFER, s_p_buffer->m_buffer);
-		auto buffer = s_p_buffer->Map(s_p_ubo_buffer_size, s_ubo_align);
 		size_t pixel_buffer_size = C_PCONST_END * 4 * sizeof(float);
-		memcpy(buffer.first, PixelShaderManager::GetBuffer(), pixel_buffer_size);
-
-		s_p_buffer->Unmap(s_p_ubo_buffer_size);
-		glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_p_buffer->m_buffer,
-			buffer.second,
+		memcpy(buffer.first + offset, PixelShaderManager::GetBuffer(), pixel_buffer_size);
+		glBindBufferRange(GL_UNIFORM_BUFFER, 1, s_buffer->m_buffer, buffer.second + offset,
 			pixel_buffer_size);
-
 		PixelShaderManager::Clear();
-		ADDSTAT(stats.thisFrame.bytesUniformStreamed, s_p_ubo_buffer_size);
+		offset += s_p_ubo_buffer_size;
 	}
-	if (GeometryShaderManager::IsDirty())
+	if (geometry_dirty)
 	{
-		glBindBuffer(GL_UNIFORM_BUFFER, s_g_buffer->m_buffer);
-		auto buffer = s_g_buffer->Map(s_g_ubo_buffer_size, s_ubo_align);
-		memcpy(buffer.first, &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
-
-		s_g_buffer->Unmap(s_g_ubo_buffer_size);
-		glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_g_buffer->m_buffer, buffer.second, sizeof(GeometryShaderConstants));
-
+		memcpy(buffer.first + offset, &GeometryShaderManager::constants, sizeof(GeometryShaderConstants));
+		glBindBufferRange(GL_UNIFORM_BUFFER, 3, s_buffer->m_buffer, buffer.second + offset,
+			sizeof(GeometryShaderConstants));
 		GeometryShaderManager::Clear();
-
-		ADDSTAT(stats.thisFrame.bytesUniformStreamed, s_g_ubo_buffer_size);
+		offset += s_g_ubo_buffer_size;
 	}
+
+	s_buffer->Unmap(size);
+	ADDSTAT(stats.thisFrame.bytesUniformStreamed, size);
 }
 
 GLuint ProgramShaderCache::GetCurrentProgram()
@@ -441,13 +439,9 @@ void ProgramShaderCache::Init()
 	// We multiply by *4*4 because we need to get down to basic machine units.
 	// So multiply by four to get how many floats we have from vec4s
 	// Then once more to get bytes
-	s_p_buffer.reset();
-	s_v_buffer.reset();
-	s_g_buffer.reset();
-
-	s_p_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER, s_p_ubo_buffer_size * 1024);
-	s_v_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER, s_v_ubo_buffer_size * 1024);
-	s_g_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER, s_g_ubo_buffer_size * 1024);
+	s_buffer.reset();
+	s_buffer = StreamBuffer::Create(GL_UNIFORM_BUFFER,
+		(s_v_ubo_buffer_size + s_p_ubo_buffer_size + s_g_ubo_buffer_size) * 1024);
 
 	pKey_t gameid = (pKey_t)GetMurmurHash3(reinterpret_cast<const u8*>(SConfig::GetInstance().m_strUniqueID.data()), (u32)SConfig::GetInstance().m_strUniqueID.size(), 0);
 	pshaders = PCache::Create(
@@ -554,9 +548,7 @@ void ProgramShaderCache::Shutdown()
 		g_program_disk_cache.Close();
 	}
 
-	s_v_buffer.reset();
-	s_g_buffer.reset();
-	s_p_buffer.reset();
+	s_buffer.reset();
 }
 
 void ProgramShaderCache::CreateHeader()
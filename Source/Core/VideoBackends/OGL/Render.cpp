@@ -37,6 +37,7 @@
 #endif
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/DriverDetails.h"
+#include "VideoCommon/EFBCacheBase.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/ImageWrite.h"
 #include "VideoCommon/IndexGenerator.h"
@@ -72,16 +73,6 @@ static u32 s_blendMode;
 
 static bool s_vsync;
 
-// EFB cache related
-static const u32 EFB_CACHE_RECT_SIZE = 64;  // Cache 64x64 blocks.
-static const u32 EFB_CACHE_WIDTH =
-(EFB_WIDTH + EFB_CACHE_RECT_SIZE - 1) / EFB_CACHE_RECT_SIZE;  // round up
-static const u32 EFB_CACHE_HEIGHT = (EFB_HEIGHT + EFB_CACHE_RECT_SIZE - 1) / EFB_CACHE_RECT_SIZE;
-static bool s_efbCacheValid[2][EFB_CACHE_WIDTH * EFB_CACHE_HEIGHT];
-static bool s_efbCacheIsCleared = false;
-static std::vector<u32>
-s_efbCache[2][EFB_CACHE_WIDTH * EFB_CACHE_HEIGHT];  // 2 for PEEK_Z and PEEK_COLOR
-
 static void APIENTRY ErrorCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
 	GLsizei length, const char* message, const void* userParam)
 {
@@ -631,6 +622,12 @@ Renderer::Renderer()
 	g_Config.backend_info.bSupportsEarlyZ =
 		g_ogl_config.bSupportsEarlyFragmentTests || g_ogl_config.bSupportsConservativeDepth;
 
+	// GLES3 always has a fixed restart index, desktop GL needs 3.1 or the NV extension
+	g_Config.backend_info.bSupportsPrimitiveRestart =
+		!DriverDetails::HasBug(DriverDetails::BUG_PRIMITIVERESTART) &&
+		(GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3 ||
+			GLExtensions::Version() >= 310 || GLExtensions::Supports("GL_NV_primitive_restart"));
+
 	if (g_ogl_config.bSupportsDebug)
 	{
 		if (GLExtensions::Supports("GL_KHR_debug"))
@@ -743,6 +740,24 @@ Renderer::Renderer()
 		glEnable(GL_DEPTH_CLAMP);
 	}
 
+	if (g_ActiveConfig.backend_info.bSupportsPrimitiveRestart)
+	{
+		if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
+		{
+			glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+		}
+		else if (GLExtensions::Version() >= 310)
+		{
+			glEnable(GL_PRIMITIVE_RESTART);
+			glPrimitiveRestartIndex(65535);
+		}
+		else
+		{
+			glEnableClientState(GL_PRIMITIVE_RESTART_NV);
+			glPrimitiveRestartIndexNV(65535);
+		}
+	}
+
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);  // 4-byte pixel alignment
 
 	glDisable(GL_STENCIL_TEST);
@@ -752,7 +767,6 @@ Renderer::Renderer()
 	glBlendColor(0, 0, 0, 0.5f);
 	glClearDepthf(1.0f);
 	UpdateActiveConfig();
-	ClearEFBCache();
 }
 
 Renderer::~Renderer()
@@ -836,58 +850,6 @@ void Renderer::SetColorMask()
 	glColorMask(ColorMask, ColorMask, ColorMask, AlphaMask);
 }
 
-void ClearEFBCache()
-{
-	if (!s_efbCacheIsCleared)
-	{
-		s_efbCacheIsCleared = true;
-		memset(s_efbCacheValid, 0, sizeof(s_efbCacheValid));
-	}
-}
-
-void Renderer::UpdateEFBCache(EFBAccessType type, u32 cacheRectIdx, const EFBRectangle& efbPixelRc,
-	const TargetRectangle& targetPixelRc, const void* data)
-{
-	u32 cacheType = (type == PEEK_Z ? 0 : 1);
-
-	if (!s_efbCache[cacheType][cacheRectIdx].size())
-		s_efbCache[cacheType][cacheRectIdx].resize(EFB_CACHE_RECT_SIZE * EFB_CACHE_RECT_SIZE);
-
-	u32 targetPixelRcWidth = targetPixelRc.right - targetPixelRc.left;
-	u32 efbPixelRcHeight = efbPixelRc.bottom - efbPixelRc.top;
-	u32 efbPixelRcWidth = efbPixelRc.right - efbPixelRc.left;
-
-	for (u32 yCache = 0; yCache < efbPixelRcHeight; ++yCache)
-	{
-		u32 yEFB = efbPixelRc.top + yCache;
-		u32 yPixel = (EFBToScaledY(EFB_HEIGHT - yEFB) + EFBToScaledY(EFB_HEIGHT - yEFB - 1)) / 2;
-		u32 yData = yPixel - targetPixelRc.bottom;
-
-		for (u32 xCache = 0; xCache < efbPixelRcWidth; ++xCache)
-		{
-			u32 xEFB = efbPixelRc.left + xCache;
-			u32 xPixel = (EFBToScaledX(xEFB) + EFBToScaledX(xEFB + 1)) / 2;
-			u32 xData = xPixel - targetPixelRc.left;
-			u32 value;
-			if (type == PEEK_Z)
-			{
-				float* ptr = (float*)data;
-				value = MathUtil::Clamp<u32>((u32)(ptr[yData * targetPixelRcWidth + xData] * 16777216.0f),
-					0, 0xFFFFFF);
-			}
-			else
-			{
-				u32* ptr = (u32*)data;
-				value = ptr[yData * targetPixelRcWidth + xData];
-			}
-			s_efbCache[cacheType][cacheRectIdx][yCache * EFB_CACHE_RECT_SIZE + xCache] = value;
-		}
-	}
-
-	s_efbCacheValid[cacheType][cacheRectIdx] = true;
-	s_efbCacheIsCleared = false;
-}
-
 // This function allows the CPU to directly access the EFB.
 // There are EFB peeks (which will read the color or depth of a pixel)
 // and EFB pokes (which will change the color or depth of a pixel).
@@ -904,59 +866,11 @@ void Renderer::UpdateEFBCache(EFBAccessType type, u32 cacheRectIdx, const EFBRec
 // - GX_PokeZMode (TODO)
 u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 {
-	u32 cacheRectIdx = (y / EFB_CACHE_RECT_SIZE) * EFB_CACHE_WIDTH + (x / EFB_CACHE_RECT_SIZE);
-
-	EFBRectangle efbPixelRc;
-
-	if (type == PEEK_COLOR || type == PEEK_Z)
-	{
-		// Get the rectangular target region containing the EFB pixel
-		efbPixelRc.left = (x / EFB_CACHE_RECT_SIZE) * EFB_CACHE_RECT_SIZE;
-		efbPixelRc.top = (y / EFB_CACHE_RECT_SIZE) * EFB_CACHE_RECT_SIZE;
-		efbPixelRc.right = std::min(efbPixelRc.left + EFB_CACHE_RECT_SIZE, (u32)EFB_WIDTH);
-		efbPixelRc.bottom = std::min(efbPixelRc.top + EFB_CACHE_RECT_SIZE, (u32)EFB_HEIGHT);
-	}
-	else
-	{
-		efbPixelRc.left = x;
-		efbPixelRc.top = y;
-		efbPixelRc.right = x + 1;
-		efbPixelRc.bottom = y + 1;
-	}
-
-	TargetRectangle targetPixelRc = ConvertEFBRectangle(efbPixelRc);
-	u32 targetPixelRcWidth = targetPixelRc.right - targetPixelRc.left;
-	u32 targetPixelRcHeight = targetPixelRc.top - targetPixelRc.bottom;
-
-	// TODO (FIX) : currently, AA path is broken/offset and doesn't return the correct pixel
 	switch (type)
 	{
 	case PEEK_Z:
 	{
-		if (!s_efbCacheValid[0][cacheRectIdx])
-		{
-			if (s_MSAASamples > 1)
-			{
-				ResetAPIState();
-
-				// Resolve our rectangle.
-				FramebufferManager::GetEFBDepthTexture(efbPixelRc);
-				glBindFramebuffer(GL_READ_FRAMEBUFFER, FramebufferManager::GetResolvedFramebuffer());
-
-				RestoreAPIState();
-			}
-
-			std::unique_ptr<float[]> depthMap(new float[targetPixelRcWidth * targetPixelRcHeight]);
-
-			glReadPixels(targetPixelRc.left, targetPixelRc.bottom, targetPixelRcWidth,
-				targetPixelRcHeight, GL_DEPTH_COMPONENT, GL_FLOAT, depthMap.get());
-
-			UpdateEFBCache(type, cacheRectIdx, efbPixelRc, targetPixelRc, depthMap.get());
-		}
-
-		u32 xRect = x % EFB_CACHE_RECT_SIZE;
-		u32 yRect = y % EFB_CACHE_RECT_SIZE;
-		u32 z = s_efbCache[0][cacheRectIdx][yRect * EFB_CACHE_RECT_SIZE + xRect];
+		u32 z = g_efb_cache->Peek(type, x, y);
 
 		// if Z is in 16 bit format you must return a 16 bit integer
 		if (bpmem.zcontrol.pixel_format == PEControl::RGB565_Z16)
@@ -972,35 +886,7 @@ u32 Renderer::AccessEFB(EFBAccessType type, u32 x, u32 y, u32 poke_data)
 		// Tested in Killer 7, the first 8bits represent the alpha value which is used to
 		// determine if we're aiming at an enemy (0x80 / 0x88) or not (0x70)
 		// Wind Waker is also using it for the pictograph to determine the color of each pixel
-		if (!s_efbCacheValid[1][cacheRectIdx])
-		{
-			if (s_MSAASamples > 1)
-			{
-				ResetAPIState();
-
-				// Resolve our rectangle.
-				FramebufferManager::GetEFBColorTexture(efbPixelRc);
-				glBindFramebuffer(GL_READ_FRAMEBUFFER, FramebufferManager::GetResolvedFramebuffer());
-
-				RestoreAPIState();
-			}
-
-			std::unique_ptr<u32[]> colorMap(new u32[targetPixelRcWidth * targetPixelRcHeight]);
-
-			if (GLInterface->GetMode() == GLInterfaceMode::MODE_OPENGLES3)
-				// XXX: Swap colours
-				glReadPixels(targetPixelRc.left, targetPixelRc.bottom, targetPixelRcWidth,
-					targetPixelRcHeight, GL_RGBA, GL_UNSIGNED_BYTE, colorMap.get());
-			else
-				glReadPixels(targetPixelRc.left, targetPixelRc.bottom, targetPixelRcWidth,
-					targetPixelRcHeight, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, colorMap.get());
-
-			UpdateEFBCache(type, cacheRectIdx, efbPixelRc, targetPixelRc, colorMap.get());
-		}
-
-		u32 xRect = x % EFB_CACHE_RECT_SIZE;
-		u32 yRect = y % EFB_CACHE_RECT_SIZE;
-		u32 color = s_efbCache[1][cacheRectIdx][yRect * EFB_CACHE_RECT_SIZE + xRect];
+		u32 color = g_efb_cache->Peek(type, x, y);
 
 		// check what to do with the alpha channel (GX_PokeAlphaRead)
 		PixelEngine::UPEAlphaReadReg alpha_read_mode = PixelEngine::GetAlphaReadMode();
@@ -1186,7 +1072,7 @@ void Renderer::ClearScreen(const EFBRectangle& rc, bool colorEnable, bool alphaE
 
 	RestoreAPIState();
 
-	ClearEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 void Renderer::BlitScreen(TargetRectangle dst_rect, TargetRectangle src_rect, TargetSize src_size, GLuint src_texture, GLuint src_depth_texture, float gamma)
@@ -1683,7 +1569,7 @@ void Renderer::SwapImpl(u32 xfbAddr, u32 fbWidth, u32 fbStride, u32 fbHeight,
 	//	      GetTargetWidth(), GetTargetHeight());
 
 	// Invalidate EFB cache
-	ClearEFBCache();
+	g_efb_cache->Invalidate();
 
 	// if the configuration has changed, reload post processor (can fail, which will deactivate it)
 	if (m_post_processor->RequiresReload())
@@ -9,8 +9,6 @@
 
 namespace OGL
 {
-void ClearEFBCache();
-
 enum GLSL_VERSION
 {
 	GLSL_130,
@@ -112,7 +110,6 @@ public:
 	int GetMaxTextureSize() override;
 
 private:
-	void UpdateEFBCache(EFBAccessType type, u32 cacheRectIdx, const EFBRectangle& efbPixelRc, const TargetRectangle& targetPixelRc, const void* data);
 	void BlitScreen(TargetRectangle dst_rect, TargetRectangle src_rect, TargetSize src_size, GLuint src_texture, GLuint src_depth_texture, float gamma);
 };
 }
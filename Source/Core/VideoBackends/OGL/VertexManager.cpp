@@ -19,6 +19,7 @@
 #include "VideoBackends/OGL/VertexManager.h"
 
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/EFBCacheBase.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -131,7 +132,7 @@ void VertexManager::Draw(u32 stride)
 		glDisable(GL_CULL_FACE);
 		break;
 	case PRIMITIVE_TRIANGLES:
-		primitive_mode = GL_TRIANGLES;
+		primitive_mode = IndexGenerator::UsesPrimitiveRestart() ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
 		break;
 	}
 
@@ -218,7 +219,7 @@ void VertexManager::vFlush(bool useDstAlpha)
 	}
 	g_Config.iSaveTargetId++;
 
-	ClearEFBCache();
+	g_efb_cache->Invalidate();
 }
 
 }  // namespace
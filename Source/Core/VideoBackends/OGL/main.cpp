@@ -47,6 +47,7 @@ Make AA apply instantly during gameplay if possible
 #include "Core/Host.h"
 
 #include "VideoBackends/OGL/BoundingBox.h"
+#include "VideoBackends/OGL/EFBCache.h"
 #include "VideoBackends/OGL/PerfQuery.h"
 #include "VideoBackends/OGL/ProgramShaderCache.h"
 #include "VideoBackends/OGL/Render.h"
@@ -118,6 +119,7 @@ void VideoBackend::InitBackendInfo()
 	g_Config.backend_info.bSupportsComputeTextureDecoding = false;
 	g_Config.backend_info.bSupportsComputeTextureEncoding = false;
 	g_Config.backend_info.bSupportsDepthClamp = true;
+	g_Config.backend_info.bSupportsPrimitiveRestart = false;
 
 	g_Config.backend_info.Adapters.clear();
 
@@ -160,6 +162,7 @@ void VideoBackend::Video_Prepare()
 	GLInterface->MakeCurrent();
 
 	g_renderer = std::make_unique<Renderer>();
+	g_efb_cache = std::make_unique<EFBCache>();
 
 	CommandProcessor::Init();
 	PixelEngine::Init();
@@ -214,6 +217,7 @@ void VideoBackend::Video_Cleanup()
 	GeometryShaderManager::Shutdown();
 	g_perf_query.reset();
 	g_vertex_manager.reset();
+	g_efb_cache.reset();
 	g_renderer.reset();
 	GLInterface->ClearCurrent();
 }
@@ -189,6 +189,7 @@ void VideoSoftware::InitBackendInfo()
 	g_Config.backend_info.bSupportsDualSourceBlend = true;
 	g_Config.backend_info.bSupportsEarlyZ = true;
 	g_Config.backend_info.bSupportsOversizedViewports = true;
+	g_Config.backend_info.bSupportsPrimitiveRestart = false;
 
 	// aamodes
 	g_Config.backend_info.AAModes = {1};
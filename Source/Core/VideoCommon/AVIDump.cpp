@@ -6,7 +6,15 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <array>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -18,6 +26,7 @@ extern "C" {
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Thread.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
@@ -25,6 +34,7 @@ extern "C" {
 #include "Core/HW/VideoInterface.h"  //for TargetRefreshRate
 #include "Core/Movie.h"
 #include "VideoCommon/AVIDump.h"
+#include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(55, 28, 1)
@@ -32,10 +42,78 @@ extern "C" {
 #define av_frame_free avcodec_free_frame
 #endif
 
+// Frames are copied into a fixed pool of slots on the video thread and handed to a conversion
+// thread (sws_scale) and then an encoding thread (encode + mux). The video thread only waits when
+// every slot is in flight.
+enum
+{
+	FRAME_QUEUE_SIZE = 8
+};
+
+struct FrameSlot
+{
+	std::vector<u8> data;
+	int width;
+	int height;
+	s64 pts;
+	AVFrame* scaled;
+};
+
+class SlotQueue
+{
+public:
+	void Push(int slot)
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_slots.push_back(slot);
+		m_cond.notify_one();
+	}
+
+	bool TryPop(int* slot)
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		if (m_slots.empty())
+			return false;
+		*slot = m_slots.front();
+		m_slots.pop_front();
+		return true;
+	}
+
+	// Returns false once the queue is closed and drained
+	bool Pop(int* slot)
+	{
+		std::unique_lock<std::mutex> lk(m_mutex);
+		m_cond.wait(lk, [this] { return !m_slots.empty() || m_closed; });
+		if (m_slots.empty())
+			return false;
+		*slot = m_slots.front();
+		m_slots.pop_front();
+		return true;
+	}
+
+	void Close()
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_closed = true;
+		m_cond.notify_all();
+	}
+
+	void Reset()
+	{
+		std::lock_guard<std::mutex> lk(m_mutex);
+		m_slots.clear();
+		m_closed = false;
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_cond;
+	std::deque<int> m_slots;
+	bool m_closed = false;
+};
+
 static AVFormatContext* s_format_context = nullptr;
 static AVStream* s_stream = nullptr;
-static AVFrame* s_src_frame = nullptr;
-static AVFrame* s_scaled_frame = nullptr;
 static AVPixelFormat s_pix_fmt = AV_PIX_FMT_BGR24;
 static int s_bytes_per_pixel;
 static SwsContext* s_sws_context = nullptr;
@@ -48,6 +126,18 @@ static int s_current_width;
 static int s_current_height;
 static int s_file_index = 0;
 static AVIDump::DumpFormat s_current_format;
+// The file was opened and the threads are running. Reopening it after a resolution change can
+// fail, in which case frames are dropped instead of waiting for slots that never come back.
+static bool s_file_open = false;
+
+static std::array<FrameSlot, FRAME_QUEUE_SIZE> s_slots;
+static SlotQueue s_free_slots;
+static SlotQueue s_convert_queue;
+static SlotQueue s_encode_queue;
+static std::thread s_convert_thread;
+static std::thread s_encode_thread;
+static u64 s_frames_queued;
+static u64 s_frames_stalled;
 
 static void InitAVCodec()
 {
@@ -89,6 +179,97 @@ bool AVIDump::Start(int w, int h, DumpFormat format)
 	return success;
 }
 
+static void ConvertThread()
+{
+	Common::SetCurrentThreadName("Frame dump converter");
+
+	int slot;
+	while (s_convert_queue.Pop(&slot))
+	{
+		FrameSlot& frame = s_slots[slot];
+#if LIBAVCODEC_VERSION_MAJOR >= 55
+		// Frame-threaded encoders may still hold a reference to this buffer
+		if (av_frame_make_writable(frame.scaled))
+			ERROR_LOG(VIDEO, "Could not reallocate frame dump buffer");
+#endif
+		u8* src_data[4] = {frame.data.data(), nullptr, nullptr, nullptr};
+		int src_linesize[4] = {frame.width * s_bytes_per_pixel, 0, 0, 0};
+
+		// Convert image from {BGR24, RGBA} to desired pixel format, and scale to initial
+		// width and height
+		if ((s_sws_context =
+			sws_getCachedContext(s_sws_context, frame.width, frame.height, s_pix_fmt, s_width, s_height,
+				s_stream->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr)))
+		{
+			sws_scale(s_sws_context, src_data, src_linesize, 0, frame.height,
+				frame.scaled->data, frame.scaled->linesize);
+		}
+		frame.scaled->pts = frame.pts;
+		s_encode_queue.Push(slot);
+	}
+	s_encode_queue.Close();
+}
+
+static void PreparePacket(AVPacket* pkt)
+{
+	av_init_packet(pkt);
+	pkt->data = nullptr;
+	pkt->size = 0;
+}
+
+// Encodes one frame, or drains the encoder when frame is null
+static int EncodeFrame(AVFrame* frame)
+{
+	AVPacket pkt;
+	PreparePacket(&pkt);
+	int got_packet = 0;
+	int error = avcodec_encode_video2(s_stream->codec, &pkt, frame, &got_packet);
+	while (!error && got_packet)
+	{
+		// Write the compressed frame in the media file.
+		if (pkt.pts != (s64)AV_NOPTS_VALUE)
+		{
+			pkt.pts = av_rescale_q(pkt.pts, s_stream->codec->time_base, s_stream->time_base);
+		}
+		if (pkt.dts != (s64)AV_NOPTS_VALUE)
+		{
+			pkt.dts = av_rescale_q(pkt.dts, s_stream->codec->time_base, s_stream->time_base);
+		}
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(56, 60, 100)
+		if (s_stream->codec->coded_frame->key_frame)
+			pkt.flags |= AV_PKT_FLAG_KEY;
+#endif
+		pkt.stream_index = s_stream->index;
+		av_interleaved_write_frame(s_format_context, &pkt);
+
+		// A frame-threaded encoder only hands out packets while it is being flushed
+		if (frame)
+			break;
+		PreparePacket(&pkt);
+		error = avcodec_encode_video2(s_stream->codec, &pkt, nullptr, &got_packet);
+	}
+	return error;
+}
+
+static void EncodeThread()
+{
+	Common::SetCurrentThreadName("Frame dump encoder");
+
+	int slot;
+	while (s_encode_queue.Pop(&slot))
+	{
+		int error = EncodeFrame(s_slots[slot].scaled);
+		if (error)
+			ERROR_LOG(VIDEO, "Error while encoding video: %d", error);
+		s_free_slots.Push(slot);
+	}
+
+	// Handle delayed frames.
+	int error = EncodeFrame(nullptr);
+	if (error)
+		ERROR_LOG(VIDEO, "Error while encoding video: %d", error);
+}
+
 bool AVIDump::CreateFile()
 {
 	AVCodec* codec = nullptr;
@@ -135,6 +316,7 @@ bool AVIDump::CreateFile()
 	s_stream->codec->time_base.den = VideoInterface::GetTargetRefreshRate();
 	s_stream->codec->gop_size = 12;
 	s_stream->codec->pix_fmt = g_Config.bUseFFV1 ? AV_PIX_FMT_BGRA : AV_PIX_FMT_YUV420P;
+	s_stream->codec->thread_count = g_Config.iFrameDumpThreads;
 
 	if (!(codec = avcodec_find_encoder(s_stream->codec->codec_id)) ||
 		(avcodec_open2(s_stream->codec, codec, nullptr) < 0))
@@ -142,20 +324,26 @@ bool AVIDump::CreateFile()
 		return false;
 	}
 
-	s_src_frame = av_frame_alloc();
-	s_scaled_frame = av_frame_alloc();
-
-	s_scaled_frame->format = s_stream->codec->pix_fmt;
-	s_scaled_frame->width = s_width;
-	s_scaled_frame->height = s_height;
+	s_free_slots.Reset();
+	s_convert_queue.Reset();
+	s_encode_queue.Reset();
+	for (int i = 0; i < FRAME_QUEUE_SIZE; ++i)
+	{
+		AVFrame*& scaled = s_slots[i].scaled;
+		scaled = av_frame_alloc();
+		scaled->format = s_stream->codec->pix_fmt;
+		scaled->width = s_width;
+		scaled->height = s_height;
 
 #if LIBAVCODEC_VERSION_MAJOR >= 55
-	if (av_frame_get_buffer(s_scaled_frame, 1))
-		return false;
+		if (av_frame_get_buffer(scaled, 1))
+			return false;
 #else
-	if (avcodec_default_get_buffer(s_stream->codec, s_scaled_frame))
-		return false;
+		if (avcodec_default_get_buffer(s_stream->codec, scaled))
+			return false;
 #endif
+		s_free_slots.Push(i);
+	}
 
 	NOTICE_LOG(VIDEO, "Opening file %s for dumping", s_format_context->filename);
 	if (avio_open(&s_format_context->pb, s_format_context->filename, AVIO_FLAG_WRITE) < 0 ||
@@ -165,40 +353,20 @@ bool AVIDump::CreateFile()
 		return false;
 	}
 
+	s_frames_queued = 0;
+	s_frames_stalled = 0;
+	s_file_open = true;
+	s_convert_thread = std::thread(ConvertThread);
+	s_encode_thread = std::thread(EncodeThread);
 	return true;
 }
 
-static void PreparePacket(AVPacket* pkt)
-{
-	av_init_packet(pkt);
-	pkt->data = nullptr;
-	pkt->size = 0;
-}
-
 void AVIDump::AddFrame(const u8* data, int width, int height)
 {
 	CheckResolution(width, height);
-	s_src_frame->data[0] = const_cast<u8*>(data);
-	s_src_frame->linesize[0] = width * s_bytes_per_pixel;
-	s_src_frame->format = s_pix_fmt;
-	s_src_frame->width = s_width;
-	s_src_frame->height = s_height;
-
-	// Convert image from {BGR24, RGBA} to desired pixel format, and scale to initial
-	// width and height
-	if ((s_sws_context =
-		sws_getCachedContext(s_sws_context, width, height, s_pix_fmt, s_width, s_height,
-			s_stream->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr)))
-	{
-		sws_scale(s_sws_context, s_src_frame->data, s_src_frame->linesize, 0, height,
-			s_scaled_frame->data, s_scaled_frame->linesize);
-	}
+	if (!s_file_open)
+		return;
 
-	// Encode and write the image.
-	AVPacket pkt;
-	PreparePacket(&pkt);
-	int got_packet = 0;
-	int error = 0;
 	u64 delta;
 	s64 last_pts;
 	// Check to see if the first frame being dumped is the first frame of output from the emulator.
@@ -216,64 +384,74 @@ void AVIDump::AddFrame(const u8* data, int width, int height)
 		last_pts = (s_last_pts * s_stream->codec->time_base.den) / SystemTimers::GetTicksPerSecond();
 	}
 	u64 pts_in_ticks = s_last_pts + delta;
-	s_scaled_frame->pts =
-		(pts_in_ticks * s_stream->codec->time_base.den) / SystemTimers::GetTicksPerSecond();
-	if (s_scaled_frame->pts != last_pts)
-	{
-		s_last_frame = CoreTiming::GetTicks();
-		s_last_pts = pts_in_ticks;
-		error = avcodec_encode_video2(s_stream->codec, &pkt, s_scaled_frame, &got_packet);
-	}
-	while (!error && got_packet)
+	s64 pts = (pts_in_ticks * s_stream->codec->time_base.den) / SystemTimers::GetTicksPerSecond();
+	if (pts == last_pts)
+		return;
+	s_last_frame = CoreTiming::GetTicks();
+	s_last_pts = pts_in_ticks;
+
+	int slot;
+	if (!s_free_slots.TryPop(&slot))
 	{
-		// Write the compressed frame in the media file.
-		if (pkt.pts != (s64)AV_NOPTS_VALUE)
+		// The encoder can't keep up, so the emulator has to wait for it
+		if (!s_frames_stalled++)
 		{
-			pkt.pts = av_rescale_q(pkt.pts, s_stream->codec->time_base, s_stream->time_base);
+			WARN_LOG(VIDEO, "Frame dump queue is full, waiting for the encoder");
+			OSD::AddMessage("Frame dumping is slowing down emulation", 5000);
 		}
-		if (pkt.dts != (s64)AV_NOPTS_VALUE)
-		{
-			pkt.dts = av_rescale_q(pkt.dts, s_stream->codec->time_base, s_stream->time_base);
-		}
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(56, 60, 100)
-		if (s_stream->codec->coded_frame->key_frame)
-			pkt.flags |= AV_PKT_FLAG_KEY;
-#endif
-		pkt.stream_index = s_stream->index;
-		av_interleaved_write_frame(s_format_context, &pkt);
-
-		// Handle delayed frames.
-		PreparePacket(&pkt);
-		error = avcodec_encode_video2(s_stream->codec, &pkt, nullptr, &got_packet);
+		s_free_slots.Pop(&slot);
 	}
-	if (error)
-		ERROR_LOG(VIDEO, "Error while encoding video: %d", error);
+	s_frames_queued++;
+
+	FrameSlot& frame = s_slots[slot];
+	frame.width = width;
+	frame.height = height;
+	frame.pts = pts;
+	frame.data.resize(width * height * s_bytes_per_pixel);
+	memcpy(frame.data.data(), data, frame.data.size());
+	s_convert_queue.Push(slot);
 }
 
 void AVIDump::Stop()
 {
-	av_write_trailer(s_format_context);
+	s_convert_queue.Close();
+	if (s_convert_thread.joinable())
+		s_convert_thread.join();
+	if (s_encode_thread.joinable())
+		s_encode_thread.join();
+
+	if (s_file_open)
+		av_write_trailer(s_format_context);
 	CloseFile();
 	s_file_index = 0;
-	NOTICE_LOG(VIDEO, "Stopping frame dump");
+	NOTICE_LOG(VIDEO, "Stopping frame dump, %" PRIu64 " of %" PRIu64 " frames waited for the encoder",
+		s_frames_stalled, s_frames_queued);
 }
 
 void AVIDump::CloseFile()
 {
+	s_file_open = false;
 	if (s_stream)
 	{
 		if (s_stream->codec)
 		{
 #if LIBAVCODEC_VERSION_MAJOR < 55
-			avcodec_default_release_buffer(s_stream->codec, s_src_frame);
+			for (FrameSlot& frame : s_slots)
+			{
+				if (frame.scaled)
+					avcodec_default_release_buffer(s_stream->codec, frame.scaled);
+			}
 #endif
 			avcodec_close(s_stream->codec);
 		}
 		av_freep(&s_stream);
 	}
 
-	av_frame_free(&s_src_frame);
-	av_frame_free(&s_scaled_frame);
+	for (FrameSlot& frame : s_slots)
+	{
+		av_frame_free(&frame.scaled);
+		std::vector<u8>().swap(frame.data);
+	}
 
 	if (s_format_context)
 	{
@@ -301,7 +479,8 @@ void AVIDump::CheckResolution(int width, int height)
 		int temp_file_index = s_file_index;
 		Stop();
 		s_file_index = temp_file_index + 1;
-		Start(width, height, s_current_format);
+		if (!Start(width, height, s_current_format))
+			ERROR_LOG(VIDEO, "Could not restart the frame dump at %dx%d", width, height);
 		s_current_width = width;
 		s_current_height = height;
 	}
@@ -18,6 +18,7 @@
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BPStructs.h"
+#include "VideoCommon/EFBCacheBase.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/PerfQueryBase.h"
@@ -58,6 +59,45 @@ void BPInit()
 	mapTexFound = false;
 }
 
+// Whether a write to this register can change how already queued geometry is drawn.
+// The EFB copy, TLUT load and TMEM preload triggers still flush, the registers that only
+// hold their parameters don't need to.
+static bool AffectsRendering(u32 address)
+{
+	switch (address)
+	{
+	case BPMEM_DISPLAYCOPYFILTER:
+	case BPMEM_DISPLAYCOPYFILTER + 1:
+	case BPMEM_DISPLAYCOPYFILTER + 2:
+	case BPMEM_DISPLAYCOPYFILTER + 3:
+	case BPMEM_PERF0_TRI:
+	case BPMEM_PERF0_QUAD:
+	case BPMEM_FIELDMASK:
+	case BPMEM_BUSCLOCK0:
+	case BPMEM_EFB_TL:
+	case BPMEM_EFB_BR:
+	case BPMEM_EFB_ADDR:
+	case BPMEM_MIPMAP_STRIDE:
+	case BPMEM_COPYYSCALE:
+	case BPMEM_CLEAR_AR:
+	case BPMEM_CLEAR_GB:
+	case BPMEM_CLEAR_Z:
+	case BPMEM_COPYFILTER0:
+	case BPMEM_COPYFILTER1:
+	case BPMEM_PRELOAD_ADDR:
+	case BPMEM_PRELOAD_TMEMEVEN:
+	case BPMEM_PRELOAD_TMEMODD:
+	case BPMEM_LOADTLUT0:
+	case BPMEM_PERF1:
+	case BPMEM_FIELDMODE:
+	case BPMEM_BUSCLOCK1:
+	case BPMEM_BP_MASK:
+		return false;
+	default:
+		return true;
+	}
+}
+
 void BPWritten(const BPCmd& bp)
 {
 	/*
@@ -113,11 +153,16 @@ void BPWritten(const BPCmd& bp)
 			|| bp.address == BPMEM_PRELOAD_MODE
 			|| bp.address == BPMEM_CLEAR_PIXEL_PERF))
 		{
+			INCSTAT(stats.thisFrame.numRedundantBPWrites);
 			return;
 		}
 	}
 
-	FlushPipeline();
+	// Registers that only parameterize a later command can't affect queued geometry
+	if (AffectsRendering(bp.address))
+		FlushPipeline();
+	else
+		INCSTAT(stats.thisFrame.numFlushesSkipped);
 
 	((u32*)&bpmem)[bp.address] = bp.newvalue;
 
@@ -300,6 +345,10 @@ void BPWritten(const BPCmd& bp)
 			ClearScreen(srcRect);
 		}
 
+		// Games usually peek right after finishing a pass, so start reading the EFB back now
+		if (g_efb_cache)
+			g_efb_cache->Prefetch();
+
 		return;
 	}
 	case BPMEM_LOADTLUT0: // This one updates bpmem.tlutXferSrc, no need to do anything here.
@@ -0,0 +1,102 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+
+#include "VideoCommon/EFBCacheBase.h"
+#include "VideoCommon/RenderBase.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
+
+std::unique_ptr<EFBCacheBase> g_efb_cache;
+
+bool EFBCacheBase::IsUsable(const Snapshot& snapshot) const
+{
+	if (snapshot.generation == m_generation)
+		return true;
+
+	// Optionally keep serving the last frame's EFB until a newer readback is done
+	return snapshot.generation && g_ActiveConfig.bEFBAccessDeferInvalidation &&
+		frameCount - snapshot.frame <= 1;
+}
+
+void EFBCacheBase::Start(EFBAccessType type, Plane& plane)
+{
+	StartReadback(type);
+	plane.readback.generation = m_generation;
+	plane.readback.frame = frameCount;
+	plane.readback_pending = true;
+}
+
+void EFBCacheBase::Finish(EFBAccessType type, Plane& plane)
+{
+	plane.data.resize(EFB_WIDTH * EFB_HEIGHT);
+	FinishReadback(type, plane.data.data());
+	plane.contents = plane.readback;
+	plane.readback_pending = false;
+}
+
+u32 EFBCacheBase::Peek(EFBAccessType type, u32 x, u32 y)
+{
+	// EFB addresses can go past the edges
+	if (x >= EFB_WIDTH || y >= EFB_HEIGHT)
+		return 0;
+
+	Plane& plane = GetPlane(type);
+	plane.peeked = true;
+
+	if (plane.readback_pending && IsUsable(plane.readback) &&
+		(!IsUsable(plane.contents) || IsReadbackDone(type)))
+	{
+		Finish(type, plane);
+	}
+
+	if (!IsUsable(plane.contents))
+	{
+		// Nothing prefetched, so this peek has to wait for the GPU
+		INCSTAT(stats.thisFrame.numEFBPeekStalls);
+		Start(type, plane);
+		Finish(type, plane);
+	}
+
+	return plane.data[y * EFB_WIDTH + x];
+}
+
+void EFBCacheBase::Poke(EFBAccessType type, const EfbPokeData* points, size_t num_points)
+{
+	Plane& plane = GetPlane(type);
+
+	// A readback issued before the pokes misses them
+	plane.readback.generation = 0;
+
+	if (plane.data.empty())
+		return;
+
+	for (size_t i = 0; i < num_points; ++i)
+	{
+		const EfbPokeData& point = points[i];
+		if (point.x >= EFB_WIDTH || point.y >= EFB_HEIGHT)
+			continue;
+		plane.data[point.y * EFB_WIDTH + point.x] = (type == POKE_Z) ? (point.data & 0xFFFFFF) : point.data;
+	}
+}
+
+void EFBCacheBase::Prefetch()
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		Plane& plane = m_planes[i];
+		if (!plane.peeked)
+			continue;
+		plane.peeked = false;
+
+		if (plane.contents.generation == m_generation ||
+			(plane.readback_pending && plane.readback.generation == m_generation))
+		{
+			continue;
+		}
+		Start(PeekType(i), plane);
+	}
+}
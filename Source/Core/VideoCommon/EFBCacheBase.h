@@ -0,0 +1,70 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/VideoBackendBase.h"
+
+struct EfbPokeData;
+
+// CPU-side copy of the whole EFB at native resolution, used to answer EFB peeks.
+//
+// Backends read a full plane back at once. Readbacks of planes that were peeked are started
+// without waiting after every EFB copy, so the next peek usually finds the data already on the
+// CPU instead of stalling on the GPU. Colors are stored as A8R8G8B8, depth as 24-bit unorm.
+class EFBCacheBase
+{
+public:
+	virtual ~EFBCacheBase() {}
+
+	u32 Peek(EFBAccessType type, u32 x, u32 y);
+	// Keeps the cached copy in step with pokes instead of dropping it
+	void Poke(EFBAccessType type, const EfbPokeData* points, size_t num_points);
+
+	// The EFB was drawn to or cleared
+	void Invalidate() { ++m_generation; }
+
+	// Starts background readbacks of the planes peeked since the last call
+	void Prefetch();
+
+protected:
+	// Copies the plane to a staging resource without waiting for the GPU
+	virtual void StartReadback(EFBAccessType type) = 0;
+	// Returns true once the last started readback can be finished without stalling
+	virtual bool IsReadbackDone(EFBAccessType type) = 0;
+	// Waits for the last started readback and writes EFB_WIDTH * EFB_HEIGHT values, top row first
+	virtual void FinishReadback(EFBAccessType type, u32* data) = 0;
+
+private:
+	struct Snapshot
+	{
+		u64 generation = 0;
+		int frame = 0;
+	};
+
+	struct Plane
+	{
+		std::vector<u32> data;
+		Snapshot contents;
+		Snapshot readback;
+		bool readback_pending = false;
+		bool peeked = false;
+	};
+
+	static EFBAccessType PeekType(int plane) { return plane ? PEEK_Z : PEEK_COLOR; }
+	Plane& GetPlane(EFBAccessType type) { return m_planes[(type == PEEK_Z || type == POKE_Z) ? 1 : 0]; }
+
+	bool IsUsable(const Snapshot& snapshot) const;
+	void Start(EFBAccessType type, Plane& plane);
+	void Finish(EFBAccessType type, Plane& plane);
+
+	Plane m_planes[2];
+	u64 m_generation = 1;
+};
+
+extern std::unique_ptr<EFBCacheBase> g_efb_cache;
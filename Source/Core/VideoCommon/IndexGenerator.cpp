@@ -2,81 +2,207 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VideoConfig.h"
 
+#if defined(_M_X86)
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 //Init
 u16 *IndexGenerator::index_buffer_current;
 u16 *IndexGenerator::BASEIptr;
 u32 IndexGenerator::base_index;
+bool IndexGenerator::primitive_restart;
 
-static void(*primitive_table[8])(u32);
+namespace
+{
 
-void IndexGenerator::Init()
+enum
 {
-	primitive_table[GX_DRAW_QUADS] = IndexGenerator::AddQuads;
-#if defined(_DEBUG) || defined(DEBUGFAST)
-	primitive_table[GX_DRAW_QUADS_2] = IndexGenerator::AddQuads_nonstandard;
+	MAX_BLOCK_LENGTH = 40
+};
+
+// Vectorized form of a generator: each block writes `length` indices covering whole primitives.
+// Lane l of the k-th block is base + offsets[l] + k * steps[l], or the restart index if
+// restart[l] is set. Fans keep a zero step for their center vertex. The patterns are taken from
+// the scalar generators in Init, so both paths always agree.
+struct IndexBlock
+{
+	u32 length;  // 0 disables the vector path
+	u32 span;    // vertices referenced by the first block
+	u32 advance; // vertices consumed per block
+	alignas(16) u16 offsets[MAX_BLOCK_LENGTH];
+	alignas(16) u16 steps[MAX_BLOCK_LENGTH];
+	alignas(16) u16 restart[MAX_BLOCK_LENGTH];
+};
+
+// Vertices fed to the scalar generator to sample two blocks of the given length
+struct BlockSample
+{
+	u32 vertices;
+	u32 length;
+};
+
+const BlockSample s_block_samples[2][8] = {
+	{
+		{32, 24}, // GX_DRAW_QUADS: 4 quads
+		{32, 24}, // GX_DRAW_QUADS_2
+		{48, 24}, // GX_DRAW_TRIANGLES: 8 triangles
+		{18, 24}, // GX_DRAW_TRIANGLE_STRIP: 8 triangles
+		{18, 24}, // GX_DRAW_TRIANGLE_FAN: 8 triangles
+		{16, 8},  // GX_DRAW_LINES: 4 lines
+		{9, 8},   // GX_DRAW_LINE_STRIP: 4 lines
+		{16, 8},  // GX_DRAW_POINTS: 8 points
+	},
+	{
+		{64, 40}, // GX_DRAW_QUADS: 8 quads
+		{64, 40}, // GX_DRAW_QUADS_2
+		{36, 24}, // GX_DRAW_TRIANGLES: 6 triangles
+		{16, 8},  // GX_DRAW_TRIANGLE_STRIP: 8 vertices
+		{26, 24}, // GX_DRAW_TRIANGLE_FAN: 12 triangles
+		{16, 8},  // GX_DRAW_LINES: 4 lines
+		{9, 8},   // GX_DRAW_LINE_STRIP: 4 lines
+		{16, 8},  // GX_DRAW_POINTS: 8 points
+	},
+};
+
+typedef u16* (*PrimitiveFunction)(u16* ptr, u32 numVerts, u32 base);
+
+PrimitiveFunction s_primitive_table[8];
+IndexBlock s_blocks[8];
+
+template <u32 N>
+u16* WriteVectors(u16* ptr, const IndexBlock& block, u32 base, u32 count)
+{
+#if defined(_M_X86)
+	__m128i value[N], step[N], restart[N];
+	const __m128i first = _mm_set1_epi16((s16)base);
+	for (u32 v = 0; v < N; ++v)
+	{
+		value[v] = _mm_add_epi16(first, _mm_load_si128((const __m128i*)(block.offsets + v * 8)));
+		step[v] = _mm_load_si128((const __m128i*)(block.steps + v * 8));
+		restart[v] = _mm_load_si128((const __m128i*)(block.restart + v * 8));
+	}
+	for (u32 i = 0; i < count; ++i)
+	{
+		for (u32 v = 0; v < N; ++v)
+		{
+			_mm_storeu_si128((__m128i*)ptr, _mm_or_si128(value[v], restart[v]));
+			value[v] = _mm_add_epi16(value[v], step[v]);
+			ptr += 8;
+		}
+	}
+#elif defined(_M_ARM_64)
+	uint16x8_t value[N], step[N], restart[N];
+	const uint16x8_t first = vdupq_n_u16((u16)base);
+	for (u32 v = 0; v < N; ++v)
+	{
+		value[v] = vaddq_u16(first, vld1q_u16(block.offsets + v * 8));
+		step[v] = vld1q_u16(block.steps + v * 8);
+		restart[v] = vld1q_u16(block.restart + v * 8);
+	}
+	for (u32 i = 0; i < count; ++i)
+	{
+		for (u32 v = 0; v < N; ++v)
+		{
+			vst1q_u16(ptr, vorrq_u16(value[v], restart[v]));
+			value[v] = vaddq_u16(value[v], step[v]);
+			ptr += 8;
+		}
+	}
 #else
-	primitive_table[GX_DRAW_QUADS_2] = IndexGenerator::AddQuads;
+	for (u32 i = 0; i < count; ++i)
+	{
+		for (u32 l = 0; l < N * 8; ++l)
+			*ptr++ = (u16)(base + block.offsets[l] + i * block.steps[l]) | block.restart[l];
+	}
 #endif
-	primitive_table[GX_DRAW_TRIANGLES] = IndexGenerator::AddList;
-	primitive_table[GX_DRAW_TRIANGLE_STRIP] = IndexGenerator::AddStrip;
-	primitive_table[GX_DRAW_TRIANGLE_FAN] = IndexGenerator::AddFan;
-	primitive_table[GX_DRAW_LINES] = &IndexGenerator::AddLineList;
-	primitive_table[GX_DRAW_LINE_STRIP] = &IndexGenerator::AddLineStrip;
-	primitive_table[GX_DRAW_POINTS] = &IndexGenerator::AddPoints;
+	return ptr;
 }
 
-void IndexGenerator::Start(u16* Indexptr)
+// Writes as many whole blocks as fit before `last` and moves the generator's
+// loop counter past them; the scalar loop finishes the remainder.
+__forceinline u16* WriteBlocks(u16* ptr, int primitive, u32 base, u32 last, u32* counter)
 {
-	index_buffer_current = Indexptr;
-	BASEIptr = Indexptr;
-	base_index = 0;
-}
+	const IndexBlock& block = s_blocks[primitive];
+	if (!block.length || base + block.span > last)
+		return ptr;
 
-void IndexGenerator::AddIndices(int primitive, u32 numVerts)
-{
-	primitive_table[primitive](numVerts);
-	base_index += numVerts;
+	const u32 count = (last - base - block.span) / block.advance + 1;
+	switch (block.length / 8)
+	{
+	case 1:
+		ptr = WriteVectors<1>(ptr, block, base, count);
+		break;
+	case 3:
+		ptr = WriteVectors<3>(ptr, block, base, count);
+		break;
+	case 5:
+		ptr = WriteVectors<5>(ptr, block, base, count);
+		break;
+	}
+	*counter += count * block.advance;
+	return ptr;
 }
 
 // Triangles
-__forceinline u16* IndexGenerator::WriteTriangle(u16* ptr, u32 index1, u32 index2, u32 index3)
+template <bool pr>
+__forceinline u16* WriteTriangle(u16* ptr, u32 index1, u32 index2, u32 index3)
 {
 	*ptr++ = index1;
 	*ptr++ = index2;
 	*ptr++ = index3;
+	if (pr)
+		*ptr++ = IndexGenerator::RESTART_INDEX;
 	return ptr;
 }
 
-void IndexGenerator::AddList(u32 const numVerts)
+template <bool pr>
+u16* AddList(u16* ptr, u32 const numVerts, u32 base)
 {
-	u32 i = base_index + 2;
-	u32 top = (base_index + numVerts);
-	u16* ptr = index_buffer_current;
+	u32 i = base + 2;
+	u32 top = (base + numVerts);
+	ptr = WriteBlocks(ptr, GX_DRAW_TRIANGLES, base, top, &i);
 	while (i < top)
 	{
-		ptr = WriteTriangle(ptr, i - 2, i - 1, i);
+		ptr = WriteTriangle<pr>(ptr, i - 2, i - 1, i);
 		i += 3;
 	}
-	index_buffer_current = ptr;
+	return ptr;
 }
 
-void IndexGenerator::AddStrip(u32 const numVerts)
+template <bool pr>
+u16* AddStrip(u16* ptr, u32 const numVerts, u32 base)
 {
-	u16* ptr = index_buffer_current;
-	u32 top = (base_index + numVerts);
-	u32 i = base_index + 2;
+	u32 top = (base + numVerts);
+	if (pr)
+	{
+		u32 i = base;
+		ptr = WriteBlocks(ptr, GX_DRAW_TRIANGLE_STRIP, base, top, &i);
+		while (i < top)
+			*ptr++ = i++;
+		*ptr++ = IndexGenerator::RESTART_INDEX;
+		return ptr;
+	}
+
+	u32 i = base + 2;
 	bool wind = false;
+	// Blocks cover an even number of triangles, so the winding starts over
+	ptr = WriteBlocks(ptr, GX_DRAW_TRIANGLE_STRIP, base, top, &i);
 	while (i < top)
 	{
-		ptr = WriteTriangle(
+		ptr = WriteTriangle<pr>(
 			ptr,
 			i - 2,
 			i - !wind,
@@ -84,7 +210,7 @@ void IndexGenerator::AddStrip(u32 const numVerts)
 		wind ^= true;
 		++i;
 	}
-	index_buffer_current = ptr;
+	return ptr;
 }
 
 /**
@@ -106,18 +232,40 @@ void IndexGenerator::AddStrip(u32 const numVerts)
  * so we use 6 indices for 3 triangles
  */
 
-void IndexGenerator::AddFan(u32 numVerts)
+template <bool pr>
+u16* AddFan(u16* ptr, u32 numVerts, u32 base)
 {
-	u32 i = base_index + 2;
-	u32 top = (base_index + numVerts);
-	u16* ptr = index_buffer_current;
+	u32 i = base + 2;
+	u32 top = (base + numVerts);
+	ptr = WriteBlocks(ptr, GX_DRAW_TRIANGLE_FAN, base, top, &i);
+
+	if (pr)
+	{
+		for (; i + 3 <= top; i += 3)
+		{
+			*ptr++ = i - 1;
+			*ptr++ = i + 0;
+			*ptr++ = base;
+			*ptr++ = i + 1;
+			*ptr++ = i + 2;
+			*ptr++ = IndexGenerator::RESTART_INDEX;
+		}
+		for (; i + 2 <= top; i += 2)
+		{
+			*ptr++ = i - 1;
+			*ptr++ = i + 0;
+			*ptr++ = base;
+			*ptr++ = i + 1;
+			*ptr++ = IndexGenerator::RESTART_INDEX;
+		}
+	}
 
 	while (i < top)
 	{
-		ptr = WriteTriangle(ptr, base_index, i - 1, i);
+		ptr = WriteTriangle<pr>(ptr, base, i - 1, i);
 		++i;
 	}
-	index_buffer_current = ptr;
+	return ptr;
 }
 
 /*
@@ -137,73 +285,172 @@ void IndexGenerator::AddFan(u32 numVerts)
  * A simple triangle has to be rendered for three vertices.
  * ZWW do this for sun rays
  */
-void IndexGenerator::AddQuads(u32 numVerts)
+template <bool pr>
+u16* AddQuads(u16* ptr, u32 numVerts, u32 base)
 {
-	u32 i = base_index + 3;
-	u32 top = (base_index + numVerts);
-	u16* ptr = index_buffer_current;
+	u32 i = base + 3;
+	u32 top = (base + numVerts);
+	ptr = WriteBlocks(ptr, GX_DRAW_QUADS, base, top, &i);
 	while (i < top)
 	{
-		ptr = WriteTriangle(ptr, i - 3, i - 2, i - 1);
-		ptr = WriteTriangle(ptr, i - 3, i - 1, i - 0);
+		if (pr)
+		{
+			*ptr++ = i - 2;
+			*ptr++ = i - 1;
+			*ptr++ = i - 3;
+			*ptr++ = i - 0;
+			*ptr++ = IndexGenerator::RESTART_INDEX;
+		}
+		else
+		{
+			ptr = WriteTriangle<pr>(ptr, i - 3, i - 2, i - 1);
+			ptr = WriteTriangle<pr>(ptr, i - 3, i - 1, i - 0);
+		}
 		i += 4;
 	}
 
 	// three vertices remaining, so render a triangle
 	if (i == top)
 	{
-		ptr = WriteTriangle(ptr, top - 3, top - 2, top - 1);
+		ptr = WriteTriangle<pr>(ptr, top - 3, top - 2, top - 1);
 	}
-	index_buffer_current = ptr;
+	return ptr;
 }
 
-void IndexGenerator::AddQuads_nonstandard(u32 numVerts)
+template <bool pr>
+u16* AddQuads_nonstandard(u16* ptr, u32 numVerts, u32 base)
 {
 	WARN_LOG(VIDEO, "Non-standard primitive drawing command GL_DRAW_QUADS_2");
-	AddQuads(numVerts);
+	return AddQuads<pr>(ptr, numVerts, base);
 }
 
 // Lines
-void IndexGenerator::AddLineList(u32 numVerts)
+u16* AddLineList(u16* ptr, u32 numVerts, u32 base)
 {
-	u32 i = base_index + 1;
-	u32 top = (base_index + numVerts);
-	u16* ptr = index_buffer_current;
+	u32 i = base + 1;
+	u32 top = (base + numVerts);
+	ptr = WriteBlocks(ptr, GX_DRAW_LINES, base, top, &i);
 	while (i < top)
 	{
 		*ptr++ = i - 1;
 		*ptr++ = i;
 		i += 2;
 	}
-	index_buffer_current = ptr;
+	return ptr;
 }
 
 // shouldn't be used as strips as LineLists are much more common
 // so converting them to lists
-void IndexGenerator::AddLineStrip(u32 numVerts)
+u16* AddLineStrip(u16* ptr, u32 numVerts, u32 base)
 {
-	u32 i = base_index + 1;
-	u32 top = (base_index + numVerts);
-	u16* ptr = index_buffer_current;
+	u32 i = base + 1;
+	u32 top = (base + numVerts);
+	ptr = WriteBlocks(ptr, GX_DRAW_LINE_STRIP, base, top, &i);
 	while (i < top)
 	{
 		*ptr++ = i - 1;
 		*ptr++ = i;
 		++i;
 	}
-	index_buffer_current = ptr;
+	return ptr;
 }
 
 // Points
-void IndexGenerator::AddPoints(u32 numVerts)
+u16* AddPoints(u16* ptr, u32 numVerts, u32 base)
 {
-	u32 i = base_index;
-	u32 top = (base_index + numVerts);
-	u16 *ptr = index_buffer_current;
+	u32 i = base;
+	u32 top = (base + numVerts);
+	ptr = WriteBlocks(ptr, GX_DRAW_POINTS, base, top, &i);
 	while (i < top)
 	{
 		*ptr++ = i;
 		++i;
 	}
-	index_buffer_current = ptr;
+	return ptr;
+}
+
+template <bool pr>
+void InitPrimitiveTable()
+{
+	s_primitive_table[GX_DRAW_QUADS] = AddQuads<pr>;
+#if defined(_DEBUG) || defined(DEBUGFAST)
+	s_primitive_table[GX_DRAW_QUADS_2] = AddQuads_nonstandard<pr>;
+#else
+	s_primitive_table[GX_DRAW_QUADS_2] = AddQuads<pr>;
+#endif
+	s_primitive_table[GX_DRAW_TRIANGLES] = AddList<pr>;
+	s_primitive_table[GX_DRAW_TRIANGLE_STRIP] = AddStrip<pr>;
+	s_primitive_table[GX_DRAW_TRIANGLE_FAN] = AddFan<pr>;
+	s_primitive_table[GX_DRAW_LINES] = AddLineList;
+	s_primitive_table[GX_DRAW_LINE_STRIP] = AddLineStrip;
+	s_primitive_table[GX_DRAW_POINTS] = AddPoints;
+}
+
+// Runs the scalar generator over two blocks worth of vertices and derives the block pattern
+// from the difference between them.
+void InitBlock(int primitive, const BlockSample& sample)
+{
+	IndexBlock& block = s_blocks[primitive];
+	// Restarted strips append a trailing restart index
+	u16 indices[2 * MAX_BLOCK_LENGTH + 1];
+
+	u16* end = s_primitive_table[primitive](indices, sample.vertices, 0);
+	_assert_(end - indices >= 2 * sample.length && end - indices <= 2 * sample.length + 1);
+
+	for (u32 l = 0; l < sample.length; ++l)
+	{
+		if (indices[l] == IndexGenerator::RESTART_INDEX)
+		{
+			block.offsets[l] = 0;
+			block.steps[l] = 0;
+			block.restart[l] = IndexGenerator::RESTART_INDEX;
+			continue;
+		}
+		block.offsets[l] = indices[l];
+		block.steps[l] = indices[l + sample.length] - indices[l];
+		block.restart[l] = 0;
+		block.span = std::max<u32>(block.span, indices[l] + 1);
+		block.advance = std::max<u32>(block.advance, block.steps[l]);
+	}
+	block.length = sample.length;
+}
+
+}  // namespace
+
+void IndexGenerator::Init()
+{
+	Init(g_ActiveConfig.backend_info.bSupportsPrimitiveRestart, true);
+}
+
+void IndexGenerator::Init(bool use_primitive_restart, bool use_simd)
+{
+	primitive_restart = use_primitive_restart;
+	if (primitive_restart)
+		InitPrimitiveTable<true>();
+	else
+		InitPrimitiveTable<false>();
+
+	memset(s_blocks, 0, sizeof(s_blocks));
+	if (!use_simd)
+		return;
+
+	for (int primitive = 0; primitive < 8; ++primitive)
+	{
+		if (primitive != GX_DRAW_QUADS_2)
+			InitBlock(primitive, s_block_samples[primitive_restart][primitive]);
+	}
+	s_blocks[GX_DRAW_QUADS_2] = s_blocks[GX_DRAW_QUADS];
+}
+
+void IndexGenerator::Start(u16* Indexptr)
+{
+	index_buffer_current = Indexptr;
+	BASEIptr = Indexptr;
+	base_index = 0;
+}
+
+void IndexGenerator::AddIndices(int primitive, u32 numVerts)
+{
+	index_buffer_current = s_primitive_table[primitive](index_buffer_current, numVerts, base_index);
+	base_index += numVerts;
 }
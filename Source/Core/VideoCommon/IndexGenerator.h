@@ -10,6 +10,9 @@ class IndexGenerator
 public:
 	// Init
 	static void Init();
+	// Select strip output with restart indices and the vectorized block writers explicitly,
+	// used by the backend-independent Init() above and by the unit tests.
+	static void Init(bool primitive_restart, bool use_simd);
 	static void Start(u16 *Indexptr);
 
 	static void AddIndices(int primitive, u32 numVertices);
@@ -35,24 +38,18 @@ public:
 	{
 		return BASEIptr;
 	}
-private:
-	// Triangles
-	static void AddList(u32 numVerts);
-	static void AddStrip(u32 numVerts);
-	static void AddFan(u32 numVerts);
-	static void AddQuads(u32 numVerts);
-	static void AddQuads_nonstandard(u32 numVerts);
-
-	// Lines
-	static void AddLineList(u32 numVerts);
-	static void AddLineStrip(u32 numVerts);
 
-	// Points
-	static void AddPoints(u32 numVerts);
+	// Triangles are written as strips separated by this index
+	static inline bool UsesPrimitiveRestart()
+	{
+		return primitive_restart;
+	}
 
-	static u16* WriteTriangle(u16 *ptr, u32 index1, u32 index2, u32 index3);
+	static const u16 RESTART_INDEX = 0xFFFF;
 
+private:
 	static u16 *index_buffer_current;
 	static u16 *BASEIptr;
 	static u32 base_index;
+	static bool primitive_restart;
 };
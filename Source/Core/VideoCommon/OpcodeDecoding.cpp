@@ -12,6 +12,8 @@
 // while interpreting them, and hope that the vertex format doesn't change, though, if you do it right
 // when they are called. The reason is that the vertex format affects the sizes of the vertices.
 
+#include <chrono>
+
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/Logging/Log.h"
@@ -27,6 +29,7 @@
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
 bool g_bRecordFifoData = false;
@@ -158,11 +161,111 @@ void Init()
 	s_bFifoErrorSeen = false;
 }
 
-template <bool is_preprocess, bool sizeCheck>
-u8* Run(DataReader& reader, u32* cycles)
+namespace
+{
+// Setup of the last draw. Consecutive draws using the same VAT with nothing else in between
+// reuse it instead of redoing the loader lookup and skip checks.
+struct DrawRun
+{
+	int vtx_attr_group = -1;
+	bool skip_draw = false;
+	u32 vertex_size = 0;
+};
+
+enum DecodeTimer
+{
+	TIMER_DRAW,
+	TIMER_XF,
+	TIMER_BP,
+	TIMER_OTHER,
+	NUM_DECODE_TIMERS
+};
+
+// Returns false if the draw doesn't fit in the remaining data
+template <bool is_preprocess>
+__forceinline bool DecodeDraw(DataReader& reader, u8 cmd_byte, size_t distance, DrawRun& run, u32& totalCycles)
+{
+	u32 count = reader.Read<u16>();
+	distance -= GX_DRAW_PRIMITIVES_SIZE;
+	if (!count)
+	{
+		totalCycles += GX_NOP_CYCLES;
+		return true;
+	}
+
+	CPState& state = is_preprocess ? g_preprocess_cp_state : g_main_cp_state;
+	const int vtx_attr_group = cmd_byte & GX_VAT_MASK;
+	const bool same_setup = run.vtx_attr_group == vtx_attr_group && !(state.attr_dirty & (1u << vtx_attr_group));
+
+	VertexLoaderParameters parameters;
+	parameters.count = count;
+	parameters.buf_size = distance;
+	parameters.primitive = (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT;
+	parameters.vtx_attr_group = vtx_attr_group;
+	parameters.needloaderrefresh = (state.attr_dirty & (1u << vtx_attr_group)) != 0;
+	parameters.VtxDesc = &state.vtx_desc;
+	parameters.VtxAttr = &state.vtx_attr[vtx_attr_group];
+	parameters.source = reader.GetReadPosition();
+	state.attr_dirty &= ~(1 << vtx_attr_group);
+
+	u32 readsize = 0;
+	if (is_preprocess)
+	{
+		// Only the size is needed to skip over the vertices
+		if (!same_setup)
+		{
+			u32 components = 0;
+			VertexLoaderManager::GetVertexSizeAndComponents(parameters, run.vertex_size, components);
+			run.vtx_attr_group = vtx_attr_group;
+		}
+		readsize = run.vertex_size * count;
+		if (distance < readsize)
+			return false;
+		reader.ReadSkip(readsize);
+	}
+	else
+	{
+		if (same_setup)
+		{
+			INCSTAT(stats.thisFrame.numDrawsHoisted);
+		}
+		else
+		{
+			run.skip_draw = Fifo::WillSkipCurrentFrame()
+				|| xfmem.viewport.wd == 0.0f
+				|| xfmem.viewport.ht == 0.0f
+				|| (bpmem.scissorBR.x + 1 - bpmem.scissorTL.x) == 0
+				|| (bpmem.scissorBR.y + 1 - bpmem.scissorTL.y) == 0;
+			run.vtx_attr_group = vtx_attr_group;
+		}
+		parameters.skip_draw = run.skip_draw;
+
+		u32 writesize = 0;
+		if (!VertexLoaderManager::ConvertVertices(parameters, readsize, writesize))
+			return false;
+		reader.ReadSkip(readsize);
+		VertexManagerBase::s_pCurBufferPointer += writesize;
+		INCSTAT(stats.thisFrame.numDrawCommands);
+	}
+	totalCycles += GX_NOP_CYCLES + GX_DRAW_PRIMITIVES_CYCLES * count;
+	return true;
+}
+
+u64 DecodeTime()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// profile is only set for the main decoder while the statistics overlay is shown,
+// so the timing code isn't even compiled into the other variants.
+template <bool is_preprocess, bool sizeCheck, bool profile>
+u8* RunDecoder(DataReader& reader, u32* cycles)
 {
 	u32 totalCycles = 0;
 	u8* opcodeStart;
+	DrawRun draw_run;
+	u64 timers[NUM_DECODE_TIMERS] = {};
 	while (true)
 	{
 		opcodeStart = reader.GetReadPosition();
@@ -171,6 +274,8 @@ u8* Run(DataReader& reader, u32* cycles)
 
 		u8 cmd_byte = reader.Read<u8>();
 		size_t distance = reader.size();
+		u64 start_time = profile ? DecodeTime() : 0;
+		DecodeTimer timer = TIMER_OTHER;
 
 		switch (cmd_byte)
 		{
@@ -195,6 +300,7 @@ u8* Run(DataReader& reader, u32* cycles)
 			LoadCPReg<is_preprocess>(sub_cmd, value);
 			if (!is_preprocess)
 				INCSTAT(stats.thisFrame.numCPLoads);
+			draw_run.vtx_attr_group = -1;
 		}
 		break;
 		case GX_LOAD_XF_REG:
@@ -216,7 +322,9 @@ u8* Run(DataReader& reader, u32* cycles)
 				u32 xf_address = Cmd2 & 0xFFFF;
 				LoadXFReg(transfer_size, xf_address);
 				INCSTAT(stats.thisFrame.numXFLoads);
+				draw_run.vtx_attr_group = -1;
 			}
+			timer = TIMER_XF;
 		}
 		break;
 		case GX_LOAD_INDX_A: //used for position matrices
@@ -229,9 +337,16 @@ u8* Run(DataReader& reader, u32* cycles)
 			totalCycles += GX_LOAD_INDX_CYCLES;
 			const s32 ref_array = (cmd_byte >> 3) + 8;
 			if (is_preprocess)
+			{
 				PreprocessIndexedXF(reader.Read<u32>(), ref_array);
+			}
 			else
+			{
 				LoadIndexedXF(reader.Read<u32>(), ref_array);
+				INCSTAT(stats.thisFrame.numIndexedXFLoads);
+				draw_run.vtx_attr_group = -1;
+			}
+			timer = TIMER_XF;
 		}
 		break;
 		case GX_CMD_CALL_DL:
@@ -244,6 +359,9 @@ u8* Run(DataReader& reader, u32* cycles)
 				InterpretDisplayListPreprocess(address, count);
 			else
 				totalCycles += GX_CMD_CALL_DL_BASE_CYCLES + InterpretDisplayList(address, count);
+			draw_run.vtx_attr_group = -1;
+			// The display list accounts for its own commands
+			start_time = 0;
 		}
 		break;
 		case GX_CMD_UNKNOWN_METRICS: // zelda 4 swords calls it and checks the metrics registers after that
@@ -272,7 +390,9 @@ u8* Run(DataReader& reader, u32* cycles)
 			{
 				LoadBPReg(bp_cmd);
 				INCSTAT(stats.thisFrame.numBPLoads);
+				draw_run.vtx_attr_group = -1;
 			}
+			timer = TIMER_BP;
 		}
 		break;
 		// draw primitives 
@@ -282,63 +402,9 @@ u8* Run(DataReader& reader, u32* cycles)
 				// load vertices
 				if (sizeCheck && distance < GX_DRAW_PRIMITIVES_SIZE)
 					goto end;
-
-				u32 count = reader.Read<u16>();
-				distance -= GX_DRAW_PRIMITIVES_SIZE;
-				if (count)
-				{
-					CPState& state = is_preprocess ? g_preprocess_cp_state : g_main_cp_state;
-					VertexLoaderParameters parameters;
-					parameters.count = count;
-					parameters.buf_size = distance;
-					parameters.primitive = (cmd_byte & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT;
-					u32 vtx_attr_group = cmd_byte & GX_VAT_MASK;
-					parameters.vtx_attr_group = vtx_attr_group;
-					parameters.needloaderrefresh = (state.attr_dirty & (1u << vtx_attr_group)) != 0;
-					parameters.skip_draw = Fifo::WillSkipCurrentFrame()
-						|| xfmem.viewport.wd == 0.0f
-						|| xfmem.viewport.ht == 0.0f
-						|| (bpmem.scissorBR.x + 1 - bpmem.scissorTL.x) == 0
-						|| (bpmem.scissorBR.y + 1 - bpmem.scissorTL.y) == 0;
-					parameters.VtxDesc = &state.vtx_desc;
-					parameters.VtxAttr = &state.vtx_attr[vtx_attr_group];
-					parameters.source = reader.GetReadPosition();
-					state.attr_dirty &= ~(1 << vtx_attr_group);
-					u32 readsize = 0;
-					if (is_preprocess)
-					{
-						u32 components = 0;
-						VertexLoaderManager::GetVertexSizeAndComponents(parameters, readsize, components);
-						readsize *= count;
-						if (distance >= readsize)
-						{
-							totalCycles += GX_NOP_CYCLES + GX_DRAW_PRIMITIVES_CYCLES * parameters.count;
-							reader.ReadSkip(readsize);
-						}
-						else
-						{
-							goto end;
-						}
-					}
-					else
-					{
-						u32 writesize = 0;
-						if (VertexLoaderManager::ConvertVertices(parameters, readsize, writesize))
-						{
-							totalCycles += GX_NOP_CYCLES + GX_DRAW_PRIMITIVES_CYCLES * parameters.count;
-							reader.ReadSkip(readsize);
-							VertexManagerBase::s_pCurBufferPointer += writesize;
-						}
-						else
-						{
-							goto end;
-						}
-					}
-				}
-				else
-				{
-					totalCycles += GX_NOP_CYCLES;
-				}
+				if (!DecodeDraw<is_preprocess>(reader, cmd_byte, distance, draw_run, totalCycles))
+					goto end;
+				timer = TIMER_DRAW;
 			}
 			else
 			{
@@ -351,6 +417,9 @@ u8* Run(DataReader& reader, u32* cycles)
 			break;
 		}
 
+		if (profile && start_time)
+			timers[timer] += DecodeTime() - start_time;
+
 		// Display lists get added directly into the FIFO stream
 		if (!is_preprocess && g_bRecordFifoData && cmd_byte != GX_CMD_CALL_DL)
 		{
@@ -360,16 +429,32 @@ u8* Run(DataReader& reader, u32* cycles)
 		}
 	}
 end:
+	if (profile)
+	{
+		ADDSTAT(stats.thisFrame.usDecodeDraw, timers[TIMER_DRAW] / 1000);
+		ADDSTAT(stats.thisFrame.usDecodeXF, timers[TIMER_XF] / 1000);
+		ADDSTAT(stats.thisFrame.usDecodeBP, timers[TIMER_BP] / 1000);
+		ADDSTAT(stats.thisFrame.usDecodeOther, timers[TIMER_OTHER] / 1000);
+	}
 	if (cycles)
 	{
 		*cycles = totalCycles;
 	}
 	return opcodeStart;
 }
+}  // namespace
+
+template <bool is_preprocess, bool sizeCheck>
+u8* Run(DataReader& reader, u32* cycles)
+{
+	if (!is_preprocess && g_ActiveConfig.bOverlayStats)
+		return RunDecoder<is_preprocess, sizeCheck, true>(reader, cycles);
+	return RunDecoder<is_preprocess, sizeCheck, false>(reader, cycles);
+}
 
 template u8* Run<true, false>(DataReader& reader, u32* cycles);
 template u8* Run<false, false>(DataReader& reader, u32* cycles);
 template u8* Run<true, true>(DataReader& reader, u32* cycles);
 template u8* Run<false, true>(DataReader& reader, u32* cycles);
 
-} // namespace OpcodeDecoder
\ No newline at end of file
+} // namespace OpcodeDecoder
@@ -56,8 +56,14 @@ std::string Statistics::ToString()
 	str += StringFromFormat("dshaders alive: %i\n", stats.numDomainShadersAlive);
 	str += StringFromFormat("shaders changes: %i\n", stats.thisFrame.numShaderChanges);
 	str += StringFromFormat("dlists called: %i\n", stats.thisFrame.numDListsCalled);
+	str += StringFromFormat("Draw commands: %i\n", stats.thisFrame.numDrawCommands);
+	str += StringFromFormat("Draw setups reused: %i\n", stats.thisFrame.numDrawsHoisted);
 	str += StringFromFormat("Primitive joins: %i\n", stats.thisFrame.numPrimitiveJoins);
 	str += StringFromFormat("Draw calls: %i\n", stats.thisFrame.numDrawCalls);
+	str += StringFromFormat("Redundant BP writes: %i\n", stats.thisFrame.numRedundantBPWrites);
+	str += StringFromFormat("Redundant XF writes: %i\n", stats.thisFrame.numRedundantXFWrites);
+	str += StringFromFormat("Flushes skipped: %i\n", stats.thisFrame.numFlushesSkipped);
+	str += StringFromFormat("EFB peek stalls: %i\n", stats.thisFrame.numEFBPeekStalls);
 	str += StringFromFormat("Primitives: %i\n", stats.thisFrame.numPrims);
 	str += StringFromFormat("Primitives (DL): %i\n", stats.thisFrame.numDLPrims);
 	str += StringFromFormat("XF loads: %i\n", stats.thisFrame.numXFLoads);
@@ -66,6 +72,10 @@ std::string Statistics::ToString()
 	str += StringFromFormat("CP loads (DL): %i\n", stats.thisFrame.numCPLoadsInDL);
 	str += StringFromFormat("BP loads: %i\n", stats.thisFrame.numBPLoads);
 	str += StringFromFormat("BP loads (DL): %i\n", stats.thisFrame.numBPLoadsInDL);
+	str += StringFromFormat("Indexed XF loads: %i\n", stats.thisFrame.numIndexedXFLoads);
+	str += StringFromFormat("Decode time: draw %i us, XF %i us, BP %i us, other %i us\n",
+		stats.thisFrame.usDecodeDraw, stats.thisFrame.usDecodeXF, stats.thisFrame.usDecodeBP,
+		stats.thisFrame.usDecodeOther);
 	str += StringFromFormat("Vertex streamed: %i kB\n", stats.thisFrame.bytesVertexStreamed / 1024);
 	str += StringFromFormat("Index streamed: %i kB\n", stats.thisFrame.bytesIndexStreamed / 1024);
 	str += StringFromFormat("Uniform streamed: %i kB\n", stats.thisFrame.bytesUniformStreamed / 1024);
@@ -40,6 +40,7 @@ struct Statistics
 		int numBPLoadsInDL;
 		int numCPLoadsInDL;
 		int numXFLoadsInDL;
+		int numIndexedXFLoads;
 
 		int numPrims;
 		int numDLPrims;
@@ -47,8 +48,20 @@ struct Statistics
 
 		int numPrimitiveJoins;
 		int numDrawCalls;
+		int numRedundantBPWrites;
+		int numRedundantXFWrites;
+		int numFlushesSkipped;
+		int numEFBPeekStalls;
 
 		int numDListsCalled;
+		int numDrawCommands;
+		int numDrawsHoisted;
+
+		// Time spent in the GX command decoder, only measured while the stats overlay is shown
+		int usDecodeDraw;
+		int usDecodeXF;
+		int usDecodeBP;
+		int usDecodeOther;
 
 		int bytesVertexStreamed;
 		int bytesIndexStreamed;
@@ -41,6 +41,8 @@ TextureCacheBase::TexPool  TextureCacheBase::texture_pool;
 TextureCacheBase::HiresTexPool TextureCacheBase::hires_texture_pool;
 TextureCacheBase::TCacheEntryBase* TextureCacheBase::bound_textures[8];
 u32 TextureCacheBase::s_last_texture;
+std::vector<u64> TextureCacheBase::page_write_ticks;
+u64 TextureCacheBase::write_tracking_tick;
 
 
 TextureCacheBase::BackupConfig TextureCacheBase::backup_config;
@@ -518,6 +520,32 @@ void TextureCacheBase::UnbindTextures()
 	std::fill(std::begin(bound_textures), std::end(bound_textures), nullptr);
 }
 
+// Moves the pages written since the last call from Memory's write tracking into page_write_ticks.
+// Returns true if none of the pages in the range was written at or after the given stamp.
+bool TextureCacheBase::CollectWrittenPages(u32 address, u32 size, u64 stamp)
+{
+	if (page_write_ticks.empty())
+		page_write_ticks.resize(Memory::WRITE_TRACKING_NUM_PAGES);
+
+	bool unchanged = true;
+	u32 page = (address & Memory::WRITE_TRACKING_ADDRESS_MASK) >> Memory::WRITE_TRACKING_PAGE_SHIFT;
+	u32 last = ((address + size - 1) & Memory::WRITE_TRACKING_ADDRESS_MASK) >>
+		Memory::WRITE_TRACKING_PAGE_SHIFT;
+	for (;; page = (page + 1) % Memory::WRITE_TRACKING_NUM_PAGES)
+	{
+		// Take and clear the flag in one go, so that a write in between isn't lost
+		if (Memory::written_pages[page].exchange(0))
+		{
+			page_write_ticks[page] = write_tracking_tick;
+		}
+		if (page_write_ticks[page] >= stamp)
+			unchanged = false;
+		if (page == last)
+			break;
+	}
+	return unchanged;
+}
+
 TextureCacheBase::TCacheEntryBase* TextureCacheBase::Load(const u32 stage)
 {
 	const FourTexUnits &tex = bpmem.tex[stage >> 2];
@@ -594,8 +622,34 @@ TextureCacheBase::TCacheEntryBase* TextureCacheBase::Load(const u32 stage)
 	if (g_bRecordFifoData && !from_tmem)
 		FifoRecorder::GetInstance().UseMemory(address, texture_size + additional_mips_size, MemoryUpdate::TEXTURE_MAP);
 
+	// With write tracking, reuse the hash of an entry for the same texture if none of its pages have
+	// been written since it was hashed. EFB copies write to RAM behind the CPU's back and are
+	// matched by hash below, so they never provide one.
+	u64 write_stamp = 0;
+	if (Memory::bWriteTracking && !from_tmem)
+	{
+		write_stamp = ++write_tracking_tick;
+		for (auto it = textures_by_address.lower_bound(address);
+			it != textures_by_address.end() && it->first == address; ++it)
+		{
+			const TCacheEntryBase* entry = it->second;
+			if (!entry->IsEfbCopy() && entry->write_stamp != 0 &&
+				(entry->format & 0xf) == texformat && entry->native_width == nativeW &&
+				entry->native_height == nativeH &&
+				CollectWrittenPages(address, texture_size, entry->write_stamp))
+			{
+				tex_hash = entry->base_hash;
+				break;
+			}
+		}
+		CollectWrittenPages(address, texture_size, write_stamp);
+		// Pages collected at this tick are clean as far as the hash below is concerned.
+		++write_stamp;
+	}
+
 	// TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data from the low tmem bank than it should)	
-	tex_hash = GetHash64(src_data, texture_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
+	if (tex_hash == TEXHASH_INVALID)
+		tex_hash = GetHash64(src_data, texture_size, g_ActiveConfig.iSafeTextureCache_ColorSamples);
 	u32 palette_size = std::min(TexDecoder_GetPaletteSize(texformat), TMEM_SIZE - tlutaddr);
 	if (isPaletteTexture)
 	{
@@ -678,6 +732,8 @@ TextureCacheBase::TCacheEntryBase* TextureCacheBase::Load(const u32 stage)
 			if (entry->hash == (full_hash) && entry->format == full_format && entry->native_levels >= tex_levels &&
 				entry->native_width == nativeW && entry->native_height == nativeH)
 			{
+				if (entry->base_hash == tex_hash)
+					entry->write_stamp = write_stamp;
 				entry = DoPartialTextureUpdates(iter, tlutaddr, tlutfmt, palette_size);
 				return ReturnEntry(stage, entry);
 			}
@@ -818,6 +874,7 @@ TextureCacheBase::TCacheEntryBase* TextureCacheBase::Load(const u32 stage)
 	entry->SetDimensions(nativeW, nativeH, tex_levels);
 	entry->SetHiresParams(!!hires_tex, basename, use_scaling, !!hires_tex && hires_tex->emissive_in_color);
 	entry->SetHashes(full_hash, tex_hash);
+	entry->write_stamp = write_stamp;
 	entry->is_efb_copy = false;
 
 	// load texture
@@ -1293,6 +1350,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(u32 dstAddr, u32 dstFormat, u32
 			ptr += dstStride;
 		}
 	}
+	Memory::MarkWritten(dstAddr, num_blocks_y * dstStride);
 
 	if (g_bRecordFifoData)
 	{
@@ -8,6 +8,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Thread.h"
@@ -119,6 +120,9 @@ public:
 		s32 frameCount = {};
 		u64 hash = {};
 		u64 base_hash = {};
+		// With memory write tracking, base_hash stays valid while no page of the texture has been
+		// written since this tick
+		u64 write_stamp = {};
 
 		// Keep an iterator to the entry in textures_by_hash, so it does not need to be searched when removing the cache entry
 		std::multimap<u64, TCacheEntryBase*>::iterator textures_by_hash_iter;
@@ -262,6 +266,7 @@ private:
 	static TexCache::iterator GetTexCacheIter(TCacheEntryBase* entry);
 	static TexCache::iterator InvalidateTexture(TexCache::iterator t_iter);
 	static TCacheEntryBase* ReturnEntry(u32 stage, TCacheEntryBase* entry);
+	static bool CollectWrittenPages(u32 address, u32 size, u64 stamp);
 
 
 
@@ -272,6 +277,8 @@ private:
 	static HiresTexPool hires_texture_pool;
 	static TCacheEntryBase* bound_textures[8];
 	static u32 s_last_texture;
+	static std::vector<u64> page_write_ticks;
+	static u64 write_tracking_tick;
 
 	// Backup configuration values
 	static struct BackupConfig
@@ -21,8 +21,11 @@
 #endif
 
 #include <algorithm>
+#include <cinttypes>
 #include <cstdlib>
 #include <cmath>
+#include <functional>
+#include <memory>
 #include <xbrz.h>
 
 
@@ -30,9 +33,14 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/CommonFuncs.h"
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/StringUtil.h"
 #include "Common/ThreadPool.h"
 #include "Common/CPUDetect.h"
 #include "Common/Intrinsics.h"
+#include "Core/ConfigManager.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/TextureScalerCommon.h"
 
@@ -50,6 +58,8 @@
 
 /////////////////////////////////////// Helper Functions (mostly math for parallelization)
 
+namespace placeholder = std::placeholders;
+
 namespace {
 //////////////////////////////////////////////////////////////////// Various image processing
 
@@ -402,7 +412,7 @@ void scaleBicubicT(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
 	int rc[4][4], gc[4][4], bc[4][4], ac[4][4];
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -484,11 +494,11 @@ void scaleBicubicT(u32* data, u32* out, int w, int h, int l, int u)
 
 // perform jinc scaling by factor f.
 template<int f, int T>
-void scaleJincT(u32* data, u32* out, int w, int h)
+void scaleJincT(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
 	int rc[4][4], gc[4][4], bc[4][4], ac[4][4];
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -558,11 +568,11 @@ void scaleJincT(u32* data, u32* out, int w, int h)
 
 // perform DDT-Sharp scaling by factor f.
 template<int f>
-void scaleDDTSharpT(u32* data, u32* out, int w, int h)
+void scaleDDTSharpT(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, offset = -(f >> 1);
 	int rc[4][4], gc[4][4], bc[4][4], ac[4][4];
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -653,11 +663,11 @@ void scaleDDTSharpT(u32* data, u32* out, int w, int h)
 
 // perform DDT scaling by factor f.
 template<int f>
-void scaleDDTT(u32* data, u32* out, int w, int h)
+void scaleDDTT(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, offset = -(f >> 1);
 	int rc[2][2], gc[2][2], bc[2][2], ac[2][2];
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -743,11 +753,11 @@ void scaleDDTT(u32* data, u32* out, int w, int h)
 
 // perform 3-point scaling by factor f.
 template<int f>
-void scale3PointT(u32* data, u32* out, int w, int h)
+void scale3PointT(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, offset = -(f >> 1);
 	int rc[2][2], gc[2][2], bc[2][2], ac[2][2];
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -805,11 +815,11 @@ void scale3PointT(u32* data, u32* out, int w, int h)
 
 // perform smoothstep scaling by factor f.
 template<int f>
-void scaleSmoothstepT(u32* data, u32* out, int w, int h)
+void scaleSmoothstepT(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
 	int rc[2][2], gc[2][2], bc[2][2], ac[2][2];
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -866,10 +876,10 @@ void scaleSmoothstepT(u32* data, u32* out, int w, int h)
 
 // perform jinc scaling by factor f.
 template<int f, int T>
-void scaleJincTSSE41(u32* data, u32* out, int w, int h)
+void scaleJincTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -934,7 +944,7 @@ template<int f, int T>
 void scaleBicubicTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -982,10 +992,10 @@ void scaleBicubicTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 }
 
 template<int f>
-void scaleSmoothstepTSSE41(u32* data, u32* out, int w, int h)
+void scaleSmoothstepTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -1033,10 +1043,10 @@ void scaleSmoothstepTSSE41(u32* data, u32* out, int w, int h)
 }
 
 template<int f>
-void scale3PointTSSE41(u32* data, u32* out, int w, int h)
+void scale3PointTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -1084,10 +1094,10 @@ void scale3PointTSSE41(u32* data, u32* out, int w, int h)
 
 
 template<int f>
-void scaleDDTSharpTSSE41(u32* data, u32* out, int w, int h)
+void scaleDDTSharpTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -1159,10 +1169,10 @@ void scaleDDTSharpTSSE41(u32* data, u32* out, int w, int h)
 }
 
 template<int f>
-void scaleDDTTSSE41(u32* data, u32* out, int w, int h)
+void scaleDDTTSSE41(u32* data, u32* out, int w, int h, int l, int u)
 {
 	int outw = w * f, outh = h * f, factor = f - 2, offset = -(f >> 1);
-	for (int cy = 0; cy <= h; ++cy)
+	for (int cy = l; cy < u; ++cy)
 	{
 		for (int cx = 0; cx <= w; ++cx)
 		{
@@ -1293,17 +1303,17 @@ void scaleBicubicMitchell(int factor, u32* data, u32* out, int w, int h, int l,
 }
 
 
-void scaleJinc(int factor, u32* data, u32* out, int w, int h)
+void scaleJinc(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
 	if (cpu_info.bSSE4_1)
 	{
 		switch (factor)
 		{
-		case 2: scaleJincTSSE41<2, 0>(data, out, w, h); break;
-		case 3: scaleJincTSSE41<3, 0>(data, out, w, h); break;
-		case 4: scaleJincTSSE41<4, 0>(data, out, w, h); break;
-		case 5: scaleJincTSSE41<5, 0>(data, out, w, h); break;
+		case 2: scaleJincTSSE41<2, 0>(data, out, w, h, l, u); break;
+		case 3: scaleJincTSSE41<3, 0>(data, out, w, h, l, u); break;
+		case 4: scaleJincTSSE41<4, 0>(data, out, w, h, l, u); break;
+		case 5: scaleJincTSSE41<5, 0>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "Jinc upsampling only implemented for factors 2 to 5");
 		}
 	}
@@ -1312,10 +1322,10 @@ void scaleJinc(int factor, u32* data, u32* out, int w, int h)
 #endif
 		switch (factor)
 		{
-		case 2: scaleJincT<2, 0>(data, out, w, h); break;
-		case 3: scaleJincT<3, 0>(data, out, w, h); break;
-		case 4: scaleJincT<4, 0>(data, out, w, h); break;
-		case 5: scaleJincT<5, 0>(data, out, w, h); break;
+		case 2: scaleJincT<2, 0>(data, out, w, h, l, u); break;
+		case 3: scaleJincT<3, 0>(data, out, w, h, l, u); break;
+		case 4: scaleJincT<4, 0>(data, out, w, h, l, u); break;
+		case 5: scaleJincT<5, 0>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "Jinc upsampling only implemented for factors 2 to 5");
 		}
 #if _M_SSE >= 0x401
@@ -1323,17 +1333,17 @@ void scaleJinc(int factor, u32* data, u32* out, int w, int h)
 #endif
 }
 
-void scaleJincSharper(int factor, u32* data, u32* out, int w, int h)
+void scaleJincSharper(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
 	if (cpu_info.bSSE4_1)
 	{
 		switch (factor)
 		{
-		case 2: scaleJincTSSE41<2, 1>(data, out, w, h); break;
-		case 3: scaleJincTSSE41<3, 1>(data, out, w, h); break;
-		case 4: scaleJincTSSE41<4, 1>(data, out, w, h); break;
-		case 5: scaleJincTSSE41<5, 1>(data, out, w, h); break;
+		case 2: scaleJincTSSE41<2, 1>(data, out, w, h, l, u); break;
+		case 3: scaleJincTSSE41<3, 1>(data, out, w, h, l, u); break;
+		case 4: scaleJincTSSE41<4, 1>(data, out, w, h, l, u); break;
+		case 5: scaleJincTSSE41<5, 1>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "Jinc upsampling only implemented for factors 2 to 5");
 		}
 	}
@@ -1342,10 +1352,10 @@ void scaleJincSharper(int factor, u32* data, u32* out, int w, int h)
 #endif
 		switch (factor)
 		{
-		case 2: scaleJincT<2, 1>(data, out, w, h); break;
-		case 3: scaleJincT<3, 1>(data, out, w, h); break;
-		case 4: scaleJincT<4, 1>(data, out, w, h); break;
-		case 5: scaleJincT<5, 1>(data, out, w, h); break;
+		case 2: scaleJincT<2, 1>(data, out, w, h, l, u); break;
+		case 3: scaleJincT<3, 1>(data, out, w, h, l, u); break;
+		case 4: scaleJincT<4, 1>(data, out, w, h, l, u); break;
+		case 5: scaleJincT<5, 1>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "Jinc upsampling only implemented for factors 2 to 5");
 		}
 #if _M_SSE >= 0x401
@@ -1354,17 +1364,17 @@ void scaleJincSharper(int factor, u32* data, u32* out, int w, int h)
 }
 
 
-void scaleSmoothstep(int factor, u32* data, u32* out, int w, int h)
+void scaleSmoothstep(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
 	if (cpu_info.bSSE4_1)
 	{
 		switch (factor)
 		{
-		case 2: scaleSmoothstepTSSE41<2>(data, out, w, h); break;
-		case 3: scaleSmoothstepTSSE41<3>(data, out, w, h); break;
-		case 4: scaleSmoothstepTSSE41<4>(data, out, w, h); break;
-		case 5: scaleSmoothstepTSSE41<5>(data, out, w, h); break;
+		case 2: scaleSmoothstepTSSE41<2>(data, out, w, h, l, u); break;
+		case 3: scaleSmoothstepTSSE41<3>(data, out, w, h, l, u); break;
+		case 4: scaleSmoothstepTSSE41<4>(data, out, w, h, l, u); break;
+		case 5: scaleSmoothstepTSSE41<5>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "Smoothstep upsampling only implemented for factors 2 to 5");
 		}
 	}
@@ -1373,10 +1383,10 @@ void scaleSmoothstep(int factor, u32* data, u32* out, int w, int h)
 #endif
 		switch (factor)
 		{
-		case 2: scaleSmoothstepT<2>(data, out, w, h); break;
-		case 3: scaleSmoothstepT<3>(data, out, w, h); break;
-		case 4: scaleSmoothstepT<4>(data, out, w, h); break;
-		case 5: scaleSmoothstepT<5>(data, out, w, h); break;
+		case 2: scaleSmoothstepT<2>(data, out, w, h, l, u); break;
+		case 3: scaleSmoothstepT<3>(data, out, w, h, l, u); break;
+		case 4: scaleSmoothstepT<4>(data, out, w, h, l, u); break;
+		case 5: scaleSmoothstepT<5>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "Smoothstep upsampling only implemented for factors 2 to 5");
 		}
 #if _M_SSE >= 0x401
@@ -1385,17 +1395,17 @@ void scaleSmoothstep(int factor, u32* data, u32* out, int w, int h)
 }
 
 
-void scale3Point(int factor, u32* data, u32* out, int w, int h)
+void scale3Point(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
 	if (cpu_info.bSSE4_1)
 	{
 		switch (factor)
 		{
-		case 2: scale3PointTSSE41<2>(data, out, w, h); break;
-		case 3: scale3PointTSSE41<3>(data, out, w, h); break;
-		case 4: scale3PointTSSE41<4>(data, out, w, h); break;
-		case 5: scale3PointTSSE41<5>(data, out, w, h); break;
+		case 2: scale3PointTSSE41<2>(data, out, w, h, l, u); break;
+		case 3: scale3PointTSSE41<3>(data, out, w, h, l, u); break;
+		case 4: scale3PointTSSE41<4>(data, out, w, h, l, u); break;
+		case 5: scale3PointTSSE41<5>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "3-Point upsampling only implemented for factors 2 to 5");
 		}
 	}
@@ -1404,10 +1414,10 @@ void scale3Point(int factor, u32* data, u32* out, int w, int h)
 #endif
 		switch (factor)
 		{
-		case 2: scale3PointT<2>(data, out, w, h); break;
-		case 3: scale3PointT<3>(data, out, w, h); break;
-		case 4: scale3PointT<4>(data, out, w, h); break;
-		case 5: scale3PointT<5>(data, out, w, h); break;
+		case 2: scale3PointT<2>(data, out, w, h, l, u); break;
+		case 3: scale3PointT<3>(data, out, w, h, l, u); break;
+		case 4: scale3PointT<4>(data, out, w, h, l, u); break;
+		case 5: scale3PointT<5>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "3-Point upsampling only implemented for factors 2 to 5");
 		}
 #if _M_SSE >= 0x401
@@ -1415,17 +1425,17 @@ void scale3Point(int factor, u32* data, u32* out, int w, int h)
 #endif
 }
 
-void scaleDDTSharp(int factor, u32* data, u32* out, int w, int h)
+void scaleDDTSharp(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
 	if (cpu_info.bSSE4_1)
 	{
 		switch (factor)
 		{
-		case 2: scaleDDTSharpTSSE41<2>(data, out, w, h); break;
-		case 3: scaleDDTSharpTSSE41<3>(data, out, w, h); break;
-		case 4: scaleDDTSharpTSSE41<4>(data, out, w, h); break;
-		case 5: scaleDDTSharpTSSE41<5>(data, out, w, h); break;
+		case 2: scaleDDTSharpTSSE41<2>(data, out, w, h, l, u); break;
+		case 3: scaleDDTSharpTSSE41<3>(data, out, w, h, l, u); break;
+		case 4: scaleDDTSharpTSSE41<4>(data, out, w, h, l, u); break;
+		case 5: scaleDDTSharpTSSE41<5>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "DDT-Sharp upsampling only implemented for factors 2 to 5");
 		}
 	}
@@ -1434,10 +1444,10 @@ void scaleDDTSharp(int factor, u32* data, u32* out, int w, int h)
 #endif
 		switch (factor)
 		{
-		case 2: scaleDDTSharpT<2>(data, out, w, h); break;
-		case 3: scaleDDTSharpT<3>(data, out, w, h); break;
-		case 4: scaleDDTSharpT<4>(data, out, w, h); break;
-		case 5: scaleDDTSharpT<5>(data, out, w, h); break;
+		case 2: scaleDDTSharpT<2>(data, out, w, h, l, u); break;
+		case 3: scaleDDTSharpT<3>(data, out, w, h, l, u); break;
+		case 4: scaleDDTSharpT<4>(data, out, w, h, l, u); break;
+		case 5: scaleDDTSharpT<5>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "DDT-Sharp upsampling only implemented for factors 2 to 5");
 		}
 #if _M_SSE >= 0x401
@@ -1445,17 +1455,17 @@ void scaleDDTSharp(int factor, u32* data, u32* out, int w, int h)
 #endif
 }
 
-void scaleDDT(int factor, u32* data, u32* out, int w, int h)
+void scaleDDT(int factor, u32* data, u32* out, int w, int h, int l, int u)
 {
 #if _M_SSE >= 0x401
 	if (cpu_info.bSSE4_1)
 	{
 		switch (factor)
 		{
-		case 2: scaleDDTTSSE41<2>(data, out, w, h); break;
-		case 3: scaleDDTTSSE41<3>(data, out, w, h); break;
-		case 4: scaleDDTTSSE41<4>(data, out, w, h); break;
-		case 5: scaleDDTTSSE41<5>(data, out, w, h); break;
+		case 2: scaleDDTTSSE41<2>(data, out, w, h, l, u); break;
+		case 3: scaleDDTTSSE41<3>(data, out, w, h, l, u); break;
+		case 4: scaleDDTTSSE41<4>(data, out, w, h, l, u); break;
+		case 5: scaleDDTTSSE41<5>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "DDT upsampling only implemented for factors 2 to 5");
 		}
 	}
@@ -1464,10 +1474,10 @@ void scaleDDT(int factor, u32* data, u32* out, int w, int h)
 #endif
 		switch (factor)
 		{
-		case 2: scaleDDTT<2>(data, out, w, h); break;
-		case 3: scaleDDTT<3>(data, out, w, h); break;
-		case 4: scaleDDTT<4>(data, out, w, h); break;
-		case 5: scaleDDTT<5>(data, out, w, h); break;
+		case 2: scaleDDTT<2>(data, out, w, h, l, u); break;
+		case 3: scaleDDTT<3>(data, out, w, h, l, u); break;
+		case 4: scaleDDTT<4>(data, out, w, h, l, u); break;
+		case 5: scaleDDTT<5>(data, out, w, h, l, u); break;
 		default: ERROR_LOG(VIDEO, "DDT upsampling only implemented for factors 2 to 5");
 		}
 #if _M_SSE >= 0x401
@@ -1612,7 +1622,7 @@ void dbgPGM(int w, int h, u32* pixels, const char* prefix = "dbg")
 
 /////////////////////////////////////// Texture Scaler
 
-TextureScaler::TextureScaler()
+TextureScaler::TextureScaler() : m_disk_cache_size(0)
 {
 	initFilterWeights();
 }
@@ -1650,6 +1660,16 @@ u32* TextureScaler::Scale(u32* data, int width, int height)
 	u32 *inputBuf = data;
 	u32 *outputBuf = bufOutput.data();
 
+	std::string cache_filename;
+	if (g_ActiveConfig.iScaledTextureCacheSize > 0)
+	{
+		UpdateDiskCacheDirectory();
+		u64 hash = GetHash64((const u8*)data, width * height * sizeof(u32), 0);
+		cache_filename = m_disk_cache_dir + StringFromFormat("%016" PRIx64 "_%dx%d.bin", hash, width, height);
+		if (LoadFromDiskCache(cache_filename, outputBuf, width*height*factor*factor))
+			return outputBuf;
+	}
+
 	// deposterize
 	if (g_ActiveConfig.bTexDeposterize)
 	{
@@ -1694,6 +1714,8 @@ u32* TextureScaler::Scale(u32* data, int width, int height)
 	default:
 		ERROR_LOG(VIDEO, "Unknown scaling type: %d", g_ActiveConfig.iTexScalingType);
 	}
+	if (!cache_filename.empty())
+		StoreToDiskCache(cache_filename, outputBuf, width*height*factor*factor);
 #ifdef SCALING_MEASURE_TIME
 	if (width*height > 64 * 64 * factor*factor)
 	{
@@ -1705,34 +1727,82 @@ u32* TextureScaler::Scale(u32* data, int width, int height)
 	return outputBuf;
 }
 
+void TextureScaler::UpdateDiskCacheDirectory()
+{
+	std::string dir = StringFromFormat("%sScaledTextures" DIR_SEP "%s" DIR_SEP "%d_%dx%s" DIR_SEP,
+		File::GetUserPath(D_CACHE_IDX).c_str(), SConfig::GetInstance().m_strUniqueID.c_str(),
+		g_ActiveConfig.iTexScalingType, g_ActiveConfig.iTexScalingFactor,
+		g_ActiveConfig.bTexDeposterize ? "_deposterized" : "");
+	if (dir == m_disk_cache_dir)
+		return;
+
+	m_disk_cache_dir = dir;
+	File::CreateFullPath(dir);
+	u64 size = 0;
+	File::FSTEntry entries = File::ScanDirectoryTree(dir, false);
+	for (const File::FSTEntry& entry : entries.children)
+	{
+		if (!entry.isDirectory)
+			size += entry.size;
+	}
+	m_disk_cache_size.store(size);
+}
+
+bool TextureScaler::LoadFromDiskCache(const std::string& filename, u32* dest, size_t pixels)
+{
+	File::IOFile file(filename, "rb");
+	if (!file || file.GetSize() != pixels * sizeof(u32))
+		return false;
+	return file.ReadArray(dest, pixels);
+}
+
+void TextureScaler::StoreToDiskCache(const std::string& filename, const u32* source, size_t pixels)
+{
+	// Once the cache is full it stays as it is, new textures are just scaled every time.
+	const u64 bytes = pixels * sizeof(u32);
+	const u64 limit = static_cast<u64>(g_ActiveConfig.iScaledTextureCacheSize) << 20;
+	if (m_disk_cache_size.load() + bytes > limit)
+		return;
+	m_disk_cache_size.fetch_add(bytes);
+
+	// Written in the background; the rename keeps readers from seeing partial files.
+	auto data = std::make_shared<std::vector<u32>>(source, source + pixels);
+	Common::AsyncWorker::ExecuteAsync([filename, data] {
+		std::string temp_filename = filename + ".tmp";
+		{
+			File::IOFile file(temp_filename, "wb");
+			if (!file || !file.WriteArray(data->data(), data->size()))
+				return;
+		}
+		File::Rename(temp_filename, filename);
+	});
+}
+
 void TextureScaler::ScaleXBRZ(int factor, u32* source, u32* dest, int width, int height)
 {
 	xbrz::ScalerCfg cfg;
 	xbrz::init();
-	//GlobalThreadPool::Loop(std::bind(&xbrz::scale, factor, source, dest, width, height, xbrz::ColorFormat::ARGB, cfg, placeholder::_1, placeholder::_2), 0, height);
-	xbrz::scale(factor, source, dest, width, height, xbrz::ColorFormat::ARGB, cfg, 0, height);
+	Common::ThreadPool::Loop(std::bind(&xbrz::scale, factor, source, dest, width, height, xbrz::ColorFormat::ARGB, cfg, placeholder::_1, placeholder::_2), 0, height);
 }
 
 void TextureScaler::ScaleBilinear(int factor, u32* source, u32* dest, int width, int height)
 {
 	bufTmp1.resize(width*height*factor);
 	u32 *tmpBuf = bufTmp1.data();
-	//GlobalThreadPool::Loop(std::bind(&bilinearH, factor, source, tmpBuf, width, placeholder::_1, placeholder::_2), 0, height);
-	//GlobalThreadPool::Loop(std::bind(&bilinearV, factor, tmpBuf, dest, width, 0, height, placeholder::_1, placeholder::_2), 0, height);
-	bilinearH(factor, source, tmpBuf, width, 0, height);
-	bilinearV(factor, tmpBuf, dest, width, 0, height, 0, height);
+	Common::ThreadPool::Loop(std::bind(&bilinearH, factor, source, tmpBuf, width, placeholder::_1, placeholder::_2), 0, height);
+	Common::ThreadPool::Loop(std::bind(&bilinearV, factor, tmpBuf, dest, width, 0, height, placeholder::_1, placeholder::_2), 0, height);
 }
 
+// The filters below write the output pixels around each source pixel corner, so they run over height + 1 rows.
+
 void TextureScaler::ScaleBicubicBSpline(int factor, u32* source, u32* dest, int width, int height)
 {
-	//GlobalThreadPool::Loop(std::bind(&scaleBicubicBSpline, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height);
-	scaleBicubicBSpline(factor, source, dest, width, height, 0, height);
+	Common::ThreadPool::Loop(std::bind(&scaleBicubicBSpline, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height + 1);
 }
 
 void TextureScaler::ScaleBicubicMitchell(int factor, u32* source, u32* dest, int width, int height)
 {
-	//GlobalThreadPool::Loop(std::bind(&scaleBicubicMitchell, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height);
-	scaleBicubicMitchell(factor, source, dest, width, height, 0, height);
+	Common::ThreadPool::Loop(std::bind(&scaleBicubicMitchell, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height + 1);
 }
 
 void TextureScaler::ScaleHybrid(int factor, u32* source, u32* dest, int width, int height, bool bicubic)
@@ -1749,10 +1819,8 @@ void TextureScaler::ScaleHybrid(int factor, u32* source, u32* dest, int width, i
 	bufTmp1.resize(width*height);
 	bufTmp2.resize(width*height*factor*factor);
 	bufTmp3.resize(width*height*factor*factor);
-	//GlobalThreadPool::Loop(std::bind(&generateDistanceMask, source, bufTmp1.data(), width, height, placeholder::_1, placeholder::_2), 0, height);
-	//GlobalThreadPool::Loop(std::bind(&convolve3x3, bufTmp1.data(), bufTmp2.data(), KERNEL_SPLAT, width, height, placeholder::_1, placeholder::_2), 0, height);
-	generateDistanceMask(source, bufTmp1.data(), width, height, 0, height);
-	convolve3x3(bufTmp1.data(), bufTmp2.data(), KERNEL_SPLAT, width, height, 0, height);
+	Common::ThreadPool::Loop(std::bind(&generateDistanceMask, source, bufTmp1.data(), width, height, placeholder::_1, placeholder::_2), 0, height);
+	Common::ThreadPool::Loop(std::bind(&convolve3x3, bufTmp1.data(), bufTmp2.data(), KERNEL_SPLAT, width, height, placeholder::_1, placeholder::_2), 0, height);
 
 	ScaleBilinear(factor, bufTmp2.data(), bufTmp3.data(), width, height);
 	// mask C is now in bufTmp3
@@ -1766,55 +1834,44 @@ void TextureScaler::ScaleHybrid(int factor, u32* source, u32* dest, int width, i
 
 	// Now we can mix it all together
 	// The factor 8192 was found through practical testing on a variety of textures
-	//GlobalThreadPool::Loop(std::bind(&mix, dest, bufTmp2.data(), bufTmp3.data(), 8192, width*factor, placeholder::_1, placeholder::_2), 0, height*factor);
-	mix(dest, bufTmp2.data(), bufTmp3.data(), 8192, width*factor, 0, height*factor);
+	Common::ThreadPool::Loop(std::bind(&mix, dest, bufTmp2.data(), bufTmp3.data(), 8192, width*factor, placeholder::_1, placeholder::_2), 0, height*factor);
 }
 
 void TextureScaler::ScaleJinc(int factor, u32* source, u32* dest, int width, int height)
 {
-	//GlobalThreadPool::Loop(std::bind(&scaleJinc, factor, source, dest, width, height), 0, height);
-	scaleJinc(factor, source, dest, width, height);
+	Common::ThreadPool::Loop(std::bind(&scaleJinc, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height + 1);
 }
 
 void TextureScaler::ScaleJincSharper(int factor, u32* source, u32* dest, int width, int height)
 {
-	//GlobalThreadPool::Loop(std::bind(&scaleJincSharper, factor, source, dest, width, height), 0, height);
-	scaleJincSharper(factor, source, dest, width, height);
+	Common::ThreadPool::Loop(std::bind(&scaleJincSharper, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height + 1);
 }
 
 void TextureScaler::ScaleSmoothstep(int factor, u32* source, u32* dest, int width, int height)
 {
-	//GlobalThreadPool::Loop(std::bind(&scaleSmoothstep, factor, source, dest, width, height), 0, height);
-	scaleSmoothstep(factor, source, dest, width, height);
+	Common::ThreadPool::Loop(std::bind(&scaleSmoothstep, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height + 1);
 }
 
 void TextureScaler::Scale3Point(int factor, u32* source, u32* dest, int width, int height)
 {
-	//GlobalThreadPool::Loop(std::bind(&scale3Point, factor, source, dest, width, height), 0, height);
-	scale3Point(factor, source, dest, width, height);
+	Common::ThreadPool::Loop(std::bind(&scale3Point, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height + 1);
 }
 
 void TextureScaler::ScaleDDT(int factor, u32* source, u32* dest, int width, int height)
 {
-	//GlobalThreadPool::Loop(std::bind(&scaleDDT, factor, source, dest, width, height), 0, height);
-	scaleDDT(factor, source, dest, width, height);
+	Common::ThreadPool::Loop(std::bind(&scaleDDT, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height + 1);
 }
 
 void TextureScaler::ScaleDDTSharp(int factor, u32* source, u32* dest, int width, int height)
 {
-	//GlobalThreadPool::Loop(std::bind(&scaleDDTSharp, factor, source, dest, width, height), 0, height);
-	scaleDDTSharp(factor, source, dest, width, height);
+	Common::ThreadPool::Loop(std::bind(&scaleDDTSharp, factor, source, dest, width, height, placeholder::_1, placeholder::_2), 0, height + 1);
 }
 
 void TextureScaler::DePosterize(u32* source, u32* dest, int width, int height)
 {
 	bufTmp3.resize(width*height);
-	//GlobalThreadPool::Loop(std::bind(&deposterizeH, source, bufTmp3.data(), width, placeholder::_1, placeholder::_2), 0, height);
-	//GlobalThreadPool::Loop(std::bind(&deposterizeV, bufTmp3.data(), dest, width, height, placeholder::_1, placeholder::_2), 0, height);
-	//GlobalThreadPool::Loop(std::bind(&deposterizeH, dest, bufTmp3.data(), width, placeholder::_1, placeholder::_2), 0, height);
-	//GlobalThreadPool::Loop(std::bind(&deposterizeV, bufTmp3.data(), dest, width, height, placeholder::_1, placeholder::_2), 0, height);
-	deposterizeH(source, bufTmp3.data(), width, 0, height);
-	deposterizeV(bufTmp3.data(), dest, width, height, 0, height);
-	deposterizeH(dest, bufTmp3.data(), width, 0, height);
-	deposterizeV(bufTmp3.data(), dest, width, height, 0, height);
+	Common::ThreadPool::Loop(std::bind(&deposterizeH, source, bufTmp3.data(), width, placeholder::_1, placeholder::_2), 0, height);
+	Common::ThreadPool::Loop(std::bind(&deposterizeV, bufTmp3.data(), dest, width, height, placeholder::_1, placeholder::_2), 0, height);
+	Common::ThreadPool::Loop(std::bind(&deposterizeH, dest, bufTmp3.data(), width, placeholder::_1, placeholder::_2), 0, height);
+	Common::ThreadPool::Loop(std::bind(&deposterizeV, bufTmp3.data(), dest, width, height, placeholder::_1, placeholder::_2), 0, height);
 }
@@ -20,6 +20,8 @@
 #include "Common/CommonTypes.h"
 #include "Common/MemoryUtil.h"
 
+#include <atomic>
+#include <string>
 #include <vector>
 
 class TextureScaler
@@ -53,6 +55,14 @@ private:
 
 	bool IsEmptyOrFlat(u32* data, int pixels);
 
+	// Scaled textures are kept on disk, keyed by the hash of the unscaled data and the scaler settings
+	void UpdateDiskCacheDirectory();
+	bool LoadFromDiskCache(const std::string& filename, u32* dest, size_t pixels);
+	void StoreToDiskCache(const std::string& filename, const u32* source, size_t pixels);
+
+	std::string m_disk_cache_dir;
+	std::atomic<u64> m_disk_cache_size;
+
 	// depending on the factor and texture sizes, these can get pretty large 
 	// maximum is (100 MB total for a 512 by 512 texture with scaling factor 5 and hybrid scaling)
 	// of course, scaling factor 5 is totally silly anyway
@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <memory>
 
 #include "Common/CommonTypes.h"
@@ -72,6 +73,17 @@ inline u32 GetRemainingSize()
 inline u32 GetRemainingIndices(int primitive)
 {
 	u32 index_len = VertexManagerBase::MAXIBUFFERSIZE - IndexGenerator::GetIndexLen();
+	if (IndexGenerator::UsesPrimitiveRestart() && primitive < GX_DRAW_LINES)
+	{
+		// Every strip is terminated by a restart index
+		if (primitive == GX_DRAW_TRIANGLE_STRIP)
+			return index_len ? index_len - 1 : 0;
+		if (primitive == GX_DRAW_TRIANGLE_FAN)
+			return index_len / 2 + 1;
+		if (primitive == GX_DRAW_TRIANGLES)
+			return index_len / 4 * 3;
+		return index_len / 5 * 4;
+	}
 	if (primitive == GX_DRAW_TRIANGLE_STRIP || primitive == GX_DRAW_TRIANGLE_FAN)
 	{
 		return index_len / 3 + 2;
@@ -212,9 +224,22 @@ void VertexManagerBase::DoFlush()
 				s_zslope_refresh_required = false;
 			}
 		}
-		else if (IndexGenerator::GetIndexLen() >= 3)
+		else
 		{
-			CalculateZSlope(vtx_dcl, g_vertex_manager->GetIndexBuffer() + IndexGenerator::GetIndexLen() - 3);
+			// Use the last triangle, skipping the restart index that terminates the last strip
+			const u16* indices = g_vertex_manager->GetIndexBuffer();
+			u32 index_len = IndexGenerator::GetIndexLen();
+			if (IndexGenerator::UsesPrimitiveRestart() && index_len &&
+				indices[index_len - 1] == IndexGenerator::RESTART_INDEX)
+			{
+				--index_len;
+			}
+			if (index_len >= 3 &&
+				std::none_of(indices + index_len - 3, indices + index_len,
+					[](u16 index) { return index == IndexGenerator::RESTART_INDEX; }))
+			{
+				CalculateZSlope(vtx_dcl, indices + index_len - 3);
+			}
 		}
 
 		// if cull mode is CULL_ALL, ignore triangles and quads
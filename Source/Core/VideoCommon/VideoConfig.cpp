@@ -54,6 +54,7 @@ VideoConfig::VideoConfig()
 	bTexDeposterize = false;
 	iTexScalingType = 0;
 	iTexScalingFactor = 2;
+	iScaledTextureCacheSize = 512;
 }
 
 void VideoConfig::Load(const std::string& ini_file)
@@ -92,6 +93,7 @@ void VideoConfig::Load(const std::string& ini_file)
 	settings->Get("CompileShaderOnStartup", &bCompileShaderOnStartup, 1);
 
 	settings->Get("UseFFV1", &bUseFFV1, 0);
+	settings->Get("FrameDumpThreads", &iFrameDumpThreads, 0);
 	settings->Get("EnablePixelLighting", &bEnablePixelLighting, 0);
 	settings->Get("ForcedLighting", &bForcedLighting, 0);
 
@@ -138,6 +140,7 @@ void VideoConfig::Load(const std::string& ini_file)
 	enhancements->Get("TextureScalingType", &iTexScalingType, 0);
 	enhancements->Get("TextureScalingFactor", &iTexScalingFactor, 2);
 	enhancements->Get("UseDePosterize", &bTexDeposterize, true);
+	enhancements->Get("ScaledTextureCacheSize", &iScaledTextureCacheSize, 512);
 	enhancements->Get("Tessellation", &bTessellation, 0);
 	enhancements->Get("TessellationEarlyCulling", &bTessellationEarlyCulling, 0);
 	enhancements->Get("TessellationDistance", &iTessellationDistance, 0);
@@ -156,6 +159,7 @@ void VideoConfig::Load(const std::string& ini_file)
 	IniFile::Section* hacks = iniFile.GetOrCreateSection("Hacks");
 	hacks->Get("EFBAccessEnable", &bEFBAccessEnable, true);
 	hacks->Get("EFBFastAccess", &bEFBFastAccess, false);
+	hacks->Get("EFBAccessDeferInvalidation", &bEFBAccessDeferInvalidation, false);
 	hacks->Get("ForceProgressive", &bForceProgressive, true);
 	hacks->Get("EFBToTextureEnable", &bSkipEFBCopyToRam, true);
 	hacks->Get("EFBScaledCopy", &bCopyEFBScaled, true);
@@ -303,6 +307,7 @@ void VideoConfig::GameIniLoad()
 
 	CHECK_SETTING("Video_Hacks", "EFBAccessEnable", bEFBAccessEnable);
 	CHECK_SETTING("Video_Hacks", "EFBFastAccess", bEFBFastAccess);
+	CHECK_SETTING("Video_Hacks", "EFBAccessDeferInvalidation", bEFBAccessDeferInvalidation);
 	CHECK_SETTING("Video_Hacks", "ForceProgressive", bForceProgressive);
 	CHECK_SETTING("Video_Hacks", "EFBToTextureEnable", bSkipEFBCopyToRam);
 	CHECK_SETTING("Video_Hacks", "EFBScaledCopy", bCopyEFBScaled);
@@ -431,6 +436,7 @@ void VideoConfig::Save(const std::string& ini_file)
 	settings->Set("CompileShaderOnStartup", bCompileShaderOnStartup);
 
 	settings->Set("UseFFV1", bUseFFV1);
+	settings->Set("FrameDumpThreads", iFrameDumpThreads);
 	settings->Set("EnablePixelLighting", bEnablePixelLighting);
 	settings->Set("ForcedLighting", bForcedLighting);
 	settings->Set("ForcePhongShading", bForcePhongShading);
@@ -477,6 +483,7 @@ void VideoConfig::Save(const std::string& ini_file)
 	enhancements->Set("TextureScalingType", iTexScalingType);
 	enhancements->Set("TextureScalingFactor", iTexScalingFactor);
 	enhancements->Set("UseDePosterize", bTexDeposterize);
+	enhancements->Set("ScaledTextureCacheSize", iScaledTextureCacheSize);
 	enhancements->Set("Tessellation", bTessellation);
 	enhancements->Set("TessellationEarlyCulling", bTessellationEarlyCulling);
 	enhancements->Set("TessellationDistance", iTessellationDistance);
@@ -495,6 +502,7 @@ void VideoConfig::Save(const std::string& ini_file)
 	IniFile::Section* hacks = iniFile.GetOrCreateSection("Hacks");
 	hacks->Set("EFBAccessEnable", bEFBAccessEnable);
 	hacks->Set("EFBFastAccess", bEFBFastAccess);
+	hacks->Set("EFBAccessDeferInvalidation", bEFBAccessDeferInvalidation);
 	hacks->Set("ForceProgressive", bForceProgressive);
 	hacks->Set("EFBToTextureEnable", bSkipEFBCopyToRam);
 	hacks->Set("EFBScaledCopy", bCopyEFBScaled);
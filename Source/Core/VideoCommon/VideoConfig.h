@@ -115,6 +115,7 @@ struct VideoConfig final
 	bool bTexDeposterize;
 	int iTexScalingType;
 	int iTexScalingFactor;
+	int iScaledTextureCacheSize; // MiB on disk per game and scaler setting, 0 disables the cache
 	bool bTessellation;
 	bool bTessellationEarlyCulling;
 	int iTessellationDistance;
@@ -150,6 +151,7 @@ struct VideoConfig final
 	bool bCacheHiresTexturesGPU;
 	bool bDumpEFBTarget;
 	bool bUseFFV1;
+	int iFrameDumpThreads; // encoder threads, 0 = let the codec decide
 	bool bFreeLook;
 	bool bBorderlessFullscreen;
 	bool bCompileShaderOnStartup;
@@ -157,6 +159,7 @@ struct VideoConfig final
 	// Hacks
 	bool bEFBAccessEnable;
 	bool bEFBFastAccess;
+	bool bEFBAccessDeferInvalidation;
 	bool bForceProgressive;
 	bool bPerfQueriesEnable;
 	bool bFullAsyncShaderCompilation;
@@ -250,6 +253,7 @@ struct VideoConfig final
 		bool bSupportsDepthClamp;  // Needed by VertexShaderGen, so must stay in VideoCommon
 		bool bSupportsComputeTextureDecoding;
 		bool bSupportsComputeTextureEncoding;
+		bool bSupportsPrimitiveRestart; // IndexGenerator emits strips separated by 0xFFFF
 	} backend_info;
 
 	// Utility
@@ -2,6 +2,8 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <algorithm>
+
 #include "Common/Common.h"
 #include "Core/HW/Memmap.h"
 #include "VideoCommon/CPMemory.h"
@@ -13,6 +15,18 @@
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/Statistics.h"
+
+// Compares the next count words of the command with what's already in xfmem
+static bool XFDataChanged(u32 address, u32 count, u32 dataIndex)
+{
+	for (u32 i = 0; i < count; ++i)
+	{
+		if (((u32*)&xfmem)[address + i] != g_VideoData.Peek<u32>((dataIndex + i) * sizeof(u32)))
+			return true;
+	}
+	return false;
+}
 
 inline void XFMemWritten(u32 transferSize, u32 baseAddress)
 {
@@ -86,7 +100,7 @@ inline void XFRegWritten(int transferSize, u32 baseAddress)
 		case XFMEM_SETCHAN1_COLOR:
 		case XFMEM_SETCHAN0_ALPHA: // Channel Alpha
 		case XFMEM_SETCHAN1_ALPHA:
-			if (((u32*)&xfmem)[address - 0x1000] != (newValue & 0x7fff))
+			if ((((u32*)&xfmem)[address] & 0x7fff) != (newValue & 0x7fff))
 				VertexManagerBase::Flush();
 			break;
 
@@ -111,11 +125,16 @@ inline void XFRegWritten(int transferSize, u32 baseAddress)
 		case XFMEM_SETVIEWPORT + 3:
 		case XFMEM_SETVIEWPORT + 4:
 		case XFMEM_SETVIEWPORT + 5:
+			nextAddress = XFMEM_SETVIEWPORT + 6;
+			if (!XFDataChanged(address, std::min<u32>(transferSize, nextAddress - address), dataIndex))
+			{
+				INCSTAT(stats.thisFrame.numRedundantXFWrites);
+				break;
+			}
 			VertexManagerBase::Flush();
 			VertexShaderManager::SetViewportChanged();
 			GeometryShaderManager::SetViewportChanged();
 			PixelShaderManager::SetViewportChanged();
-			nextAddress = XFMEM_SETVIEWPORT + 6;
 			break;
 
 		case XFMEM_SETPROJECTION:
@@ -125,10 +144,15 @@ inline void XFRegWritten(int transferSize, u32 baseAddress)
 		case XFMEM_SETPROJECTION + 4:
 		case XFMEM_SETPROJECTION + 5:
 		case XFMEM_SETPROJECTION + 6:
+			nextAddress = XFMEM_SETPROJECTION + 7;
+			if (!XFDataChanged(address, std::min<u32>(transferSize, nextAddress - address), dataIndex))
+			{
+				INCSTAT(stats.thisFrame.numRedundantXFWrites);
+				break;
+			}
 			VertexManagerBase::Flush();
 			VertexShaderManager::SetProjectionChanged();
 			GeometryShaderManager::SetProjectionChanged();
-			nextAddress = XFMEM_SETPROJECTION + 7;
 			break;
 
 		case XFMEM_SETNUMTEXGENS: // GXSetNumTexGens
@@ -144,9 +168,11 @@ inline void XFRegWritten(int transferSize, u32 baseAddress)
 		case XFMEM_SETTEXMTXINFO + 5:
 		case XFMEM_SETTEXMTXINFO + 6:
 		case XFMEM_SETTEXMTXINFO + 7:
-			VertexManagerBase::Flush();
-
 			nextAddress = XFMEM_SETTEXMTXINFO + 8;
+			if (XFDataChanged(address, std::min<u32>(transferSize, nextAddress - address), dataIndex))
+				VertexManagerBase::Flush();
+			else
+				INCSTAT(stats.thisFrame.numRedundantXFWrites);
 			break;
 
 		case XFMEM_SETPOSMTXINFO:
@@ -157,9 +183,11 @@ inline void XFRegWritten(int transferSize, u32 baseAddress)
 		case XFMEM_SETPOSMTXINFO + 5:
 		case XFMEM_SETPOSMTXINFO + 6:
 		case XFMEM_SETPOSMTXINFO + 7:
-			VertexManagerBase::Flush();
-
 			nextAddress = XFMEM_SETPOSMTXINFO + 8;
+			if (XFDataChanged(address, std::min<u32>(transferSize, nextAddress - address), dataIndex))
+				VertexManagerBase::Flush();
+			else
+				INCSTAT(stats.thisFrame.numRedundantXFWrites);
 			break;
 
 			// --------------
@@ -231,7 +259,11 @@ void LoadXFReg(u32 transferSize, u32 baseAddress)
 			transferSize = 0;
 		}
 
-		XFMemWritten(xfMemTransferSize, xfMemBase);
+		// Games often reload the same matrices between draws
+		if (XFDataChanged(xfMemBase, xfMemTransferSize, 0))
+			XFMemWritten(xfMemTransferSize, xfMemBase);
+		else
+			INCSTAT(stats.thisFrame.numRedundantXFWrites);
 		OpcodeDecoder::DataReadU32xFuncs[xfMemTransferSize - 1](&((u32*)&xfmem)[xfMemBase]);
 	}
 
@@ -276,6 +308,10 @@ void LoadIndexedXF(u32 val, int refarray)
 		for (int i = 0; i < size; ++i)
 			currData[i] = Common::swap32(newData[i]);
 	}
+	else
+	{
+		INCSTAT(stats.thisFrame.numRedundantXFWrites);
+	}
 }
 
 void PreprocessIndexedXF(u32 val, int refarray)
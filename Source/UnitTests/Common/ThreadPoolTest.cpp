@@ -0,0 +1,44 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/ThreadPool.h"
+
+using Common::ThreadPool;
+
+TEST(ThreadPool, LoopCoversRangeOnce)
+{
+  std::vector<std::atomic<int>> hits(1000);
+  for (auto& hit : hits)
+    hit.store(0);
+
+  ThreadPool::Loop([&](int l, int u) {
+    for (int i = l; i < u; i++)
+      hits[i].fetch_add(1);
+  }, 0, static_cast<int>(hits.size()));
+
+  for (const auto& hit : hits)
+    EXPECT_EQ(1, hit.load());
+}
+
+TEST(ThreadPool, LoopSmallRange)
+{
+  int calls = 0;
+  int lower = -1, upper = -1;
+  ThreadPool::Loop([&](int l, int u) {
+    calls++;
+    lower = l;
+    upper = u;
+  }, 5, 9);
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(5, lower);
+  EXPECT_EQ(9, upper);
+
+  calls = 0;
+  ThreadPool::Loop([&](int, int) { calls++; }, 3, 3);
+  EXPECT_EQ(0, calls);
+}
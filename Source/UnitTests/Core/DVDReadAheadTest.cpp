@@ -0,0 +1,185 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Core/HW/DVDReadAhead.h"
+
+namespace
+{
+class FakeDisc
+{
+public:
+  explicit FakeDisc(size_t size) : m_data(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      m_data[i] = static_cast<u8>(i * 7 + i / 256);
+  }
+
+  DVDReadAhead::ReadFunction Reader()
+  {
+    return [this](u64 offset, u64 length, u8* buffer, bool decrypt) {
+      reads.push_back(length);
+      if (offset + length > m_data.size())
+        return false;
+      std::memcpy(buffer, m_data.data() + offset, length);
+      return true;
+    };
+  }
+
+  bool Matches(u64 offset, const std::vector<u8>& buffer) const
+  {
+    return std::memcmp(m_data.data() + offset, buffer.data(), buffer.size()) == 0;
+  }
+
+  std::vector<u64> reads;
+
+private:
+  std::vector<u8> m_data;
+};
+}
+
+TEST(DVDReadAhead, SequentialReadsAreReadAhead)
+{
+  FakeDisc disc(8 * 1024 * 1024);
+  DVDReadAhead read_ahead;
+  std::vector<u8> buffer(0x8000);
+
+  // The first read can't know what comes next
+  EXPECT_TRUE(read_ahead.Read(0, 0x8000, buffer.data(), false, disc.Reader()));
+  EXPECT_TRUE(disc.Matches(0, buffer));
+  ASSERT_EQ(1u, disc.reads.size());
+  EXPECT_EQ(0x8000u, disc.reads[0]);
+
+  // The second one is read together with the data after it
+  EXPECT_TRUE(read_ahead.Read(0x8000, 0x8000, buffer.data(), false, disc.Reader()));
+  EXPECT_TRUE(disc.Matches(0x8000, buffer));
+  ASSERT_EQ(2u, disc.reads.size());
+  EXPECT_EQ(0x8000u + 4 * 0x8000, disc.reads[1]);
+
+  for (u64 offset = 0x10000; offset < 0x30000; offset += 0x8000)
+  {
+    EXPECT_TRUE(read_ahead.TryRead(offset, 0x8000, buffer.data(), false));
+    EXPECT_TRUE(disc.Matches(offset, buffer));
+  }
+  EXPECT_FALSE(read_ahead.TryRead(0x30000, 0x8000, buffer.data(), false));
+  EXPECT_EQ(2u, disc.reads.size());
+
+  DVDReadAhead::Stats stats = read_ahead.GetStats();
+  EXPECT_EQ(4u, stats.hits);
+  EXPECT_EQ(2u, stats.misses);
+  EXPECT_EQ(0x30000u, stats.bytes_requested);
+  EXPECT_EQ(2u, stats.disc_reads);
+}
+
+TEST(DVDReadAhead, ReadAheadFillsInChunks)
+{
+  FakeDisc disc(8 * 1024 * 1024);
+  DVDReadAhead read_ahead;
+  std::vector<u8> buffer(0x80000);
+
+  read_ahead.Read(0, 0x80000, buffer.data(), false, disc.Reader());
+  read_ahead.Read(0x80000, 0x80000, buffer.data(), false, disc.Reader());
+  EXPECT_FALSE(read_ahead.IsRunningLow());
+  // Nothing is missing yet
+  EXPECT_FALSE(read_ahead.ReadAhead(disc.Reader()));
+
+  // Use most of what was read ahead
+  for (u64 offset = 0x100000; offset < 0x280000; offset += 0x80000)
+    EXPECT_TRUE(read_ahead.TryRead(offset, 0x80000, buffer.data(), false));
+  EXPECT_TRUE(read_ahead.IsRunningLow());
+
+  const size_t reads = disc.reads.size();
+  while (read_ahead.ReadAhead(disc.Reader()))
+  {
+  }
+  EXPECT_FALSE(read_ahead.IsRunningLow());
+  for (size_t i = reads; i < disc.reads.size(); ++i)
+    EXPECT_GE(DVDReadAhead::CHUNK_SIZE, disc.reads[i]);
+
+  for (u64 offset = 0x280000; offset < 0x400000; offset += 0x80000)
+  {
+    EXPECT_TRUE(read_ahead.TryRead(offset, 0x80000, buffer.data(), false));
+    EXPECT_TRUE(disc.Matches(offset, buffer));
+  }
+}
+
+TEST(DVDReadAhead, RandomReadsDontReadAhead)
+{
+  FakeDisc disc(1024 * 1024);
+  DVDReadAhead read_ahead;
+  std::vector<u8> buffer(0x800);
+
+  for (u64 offset : {0x1000, 0x40000, 0x8000, 0x2000, 0x90000})
+  {
+    EXPECT_TRUE(read_ahead.Read(offset, 0x800, buffer.data(), false, disc.Reader()));
+    EXPECT_TRUE(disc.Matches(offset, buffer));
+  }
+  for (u64 length : disc.reads)
+    EXPECT_EQ(0x800u, length);
+  EXPECT_FALSE(read_ahead.ReadAhead(disc.Reader()));
+  EXPECT_EQ(5u, read_ahead.GetStats().misses);
+}
+
+TEST(DVDReadAhead, TwoSequences)
+{
+  FakeDisc disc(4 * 1024 * 1024);
+  DVDReadAhead read_ahead;
+  std::vector<u8> buffer(0x20);
+
+  // Streamed audio in small blocks between larger reads elsewhere on the disc
+  std::vector<u8> data(0x4000);
+  for (int i = 0; i < 20; ++i)
+  {
+    const u64 audio = 0x200000 + i * 0x20;
+    if (!read_ahead.TryRead(audio, 0x20, buffer.data(), false))
+      EXPECT_TRUE(read_ahead.Read(audio, 0x20, buffer.data(), false, disc.Reader()));
+    EXPECT_TRUE(disc.Matches(audio, buffer));
+
+    EXPECT_TRUE(read_ahead.Read(i * 0x4000, 0x4000, data.data(), false, disc.Reader()));
+    EXPECT_TRUE(disc.Matches(i * 0x4000, data));
+
+    // What the DVD thread does between reads
+    while (read_ahead.ReadAhead(disc.Reader()))
+    {
+    }
+  }
+
+  // Two reads to start each sequence, everything else came from the read-ahead
+  EXPECT_EQ(4u, read_ahead.GetStats().misses);
+  EXPECT_EQ(36u, read_ahead.GetStats().hits);
+}
+
+TEST(DVDReadAhead, EndOfDisc)
+{
+  FakeDisc disc(0x20000);
+  DVDReadAhead read_ahead;
+  std::vector<u8> buffer(0x4000);
+
+  for (u64 offset = 0; offset < 0x20000; offset += 0x4000)
+  {
+    EXPECT_TRUE(read_ahead.Read(offset, 0x4000, buffer.data(), false, disc.Reader()));
+    EXPECT_TRUE(disc.Matches(offset, buffer));
+  }
+  EXPECT_FALSE(read_ahead.ReadAhead(disc.Reader()));
+  EXPECT_FALSE(read_ahead.Read(0x20000, 0x4000, buffer.data(), false, disc.Reader()));
+}
+
+TEST(DVDReadAhead, ClearForgetsData)
+{
+  FakeDisc disc(1024 * 1024);
+  DVDReadAhead read_ahead;
+  std::vector<u8> buffer(0x1000);
+
+  read_ahead.Read(0, 0x1000, buffer.data(), false, disc.Reader());
+  read_ahead.Read(0x1000, 0x1000, buffer.data(), false, disc.Reader());
+  EXPECT_TRUE(read_ahead.TryRead(0x2000, 0x1000, buffer.data(), false));
+  // Decrypted reads are a separate sequence
+  EXPECT_FALSE(read_ahead.TryRead(0x3000, 0x1000, buffer.data(), true));
+
+  read_ahead.Clear();
+  EXPECT_FALSE(read_ahead.TryRead(0x3000, 0x1000, buffer.data(), false));
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "Core/IPC_HLE/WII_IPC_HLE_FSThreads.h"
+
+static void Sleep(int ms)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+TEST(FSThreads, SameKeyRunsInOrder)
+{
+  FSThreads::Start();
+
+  std::atomic<int> running{0};
+  std::atomic<int> next{0};
+  std::atomic<bool> ok{true};
+  for (u32 i = 0; i < 20; ++i)
+  {
+    FSThreads::Post(0x1000 + i * 0x40, "/file", [&, i] {
+      if (running++ != 0 || next++ != (int)i)
+        ok = false;
+      Sleep(1);
+      running--;
+      return (s32)i;
+    });
+  }
+
+  for (u32 i = 0; i < 20; ++i)
+  {
+    s32 result = -1;
+    EXPECT_TRUE(FSThreads::WaitForResult(0x1000 + i * 0x40, &result));
+    EXPECT_EQ((s32)i, result);
+  }
+  EXPECT_TRUE(ok);
+
+  FSThreads::Stop();
+}
+
+TEST(FSThreads, BarrierRunsAlone)
+{
+  FSThreads::Start();
+
+  std::atomic<int> started{0};
+  std::atomic<int> finished{0};
+  std::atomic<bool> barrier_done{false};
+  std::atomic<bool> ok{true};
+  auto before = [&] {
+    started++;
+    Sleep(5);
+    finished++;
+    return 0;
+  };
+  auto after = [&] {
+    if (!barrier_done)
+      ok = false;
+    return 0;
+  };
+
+  FSThreads::Post(0x100, "/a", before);
+  FSThreads::Post(0x200, "/b", before);
+  FSThreads::Post(0x300, FSThreads::BARRIER, [&] {
+    if (started != 2 || finished != 2)
+      ok = false;
+    Sleep(5);
+    barrier_done = true;
+    return 0;
+  });
+  FSThreads::Post(0x400, "/a", after);
+  FSThreads::Post(0x500, "/c", after);
+
+  FSThreads::WaitUntilIdle();
+  EXPECT_TRUE(ok);
+
+  s32 result;
+  for (u32 address : {0x100, 0x200, 0x300, 0x400, 0x500})
+    EXPECT_TRUE(FSThreads::WaitForResult(address, &result));
+  // Results are only handed out once
+  EXPECT_FALSE(FSThreads::WaitForResult(0x100, &result));
+
+  FSThreads::Stop();
+}
+
+TEST(FSThreads, OnlyPostedCommandsHaveResults)
+{
+  FSThreads::Start();
+
+  s32 result = 0;
+  EXPECT_FALSE(FSThreads::WaitForResult(0x1234, &result));
+
+  FSThreads::Post(0x1234, "/file", [] { return -106; });
+  EXPECT_TRUE(FSThreads::WaitForResult(0x1234, &result));
+  EXPECT_EQ(-106, result);
+
+  // Results left over are dropped
+  FSThreads::Post(0x2000, "/file", [] { return 1; });
+  FSThreads::Reset();
+  EXPECT_FALSE(FSThreads::WaitForResult(0x2000, &result));
+
+  FSThreads::Stop();
+}
@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include "Core/NetPlayBufferController.h"
+
+using NetPlay::PadBufferController;
+
+TEST(NetPlayBufferController, TargetSize)
+{
+  // Only the host's own client
+  EXPECT_EQ(1u, PadBufferController::TargetSize({{0, 0, false}}));
+
+  // Data from one player to the other takes 50 ms, three polls
+  EXPECT_EQ(4u, PadBufferController::TargetSize({{0, 0, false}, {100, 0, false}}));
+
+  // Only the two slowest players matter, jitter adds a margin
+  EXPECT_EQ(6u, PadBufferController::TargetSize(
+                    {{20, 0, false}, {60, 5, false}, {40, 5, false}, {0, 0, false}}));
+
+  EXPECT_EQ(PadBufferController::MAX_SIZE,
+            PadBufferController::TargetSize({{5000, 0, false}, {5000, 0, false}}));
+}
+
+TEST(NetPlayBufferController, GoesUpAtOnceAndDownSlowly)
+{
+  PadBufferController controller;
+  controller.Reset(2);
+
+  EXPECT_EQ(4u, controller.Update({{0, 0, false}, {100, 0, false}}));
+
+  // A stall adds one even if the estimate says otherwise
+  EXPECT_EQ(5u, controller.Update({{0, 0, false}, {100, 0, true}}));
+
+  u32 size = 5;
+  int updates = 0;
+  while (size > 1 && updates < 100)
+  {
+    size = controller.Update({{0, 0, false}, {0, 0, false}});
+    ++updates;
+  }
+  EXPECT_EQ(1u, size);
+  EXPECT_GT(updates, 4);
+}
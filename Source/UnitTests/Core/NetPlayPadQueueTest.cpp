@@ -0,0 +1,108 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+
+#include "Core/NetPlayPadQueue.h"
+
+using NetPlay::PadSendQueue;
+using NetPlay::PadStates;
+
+static GCPadStatus MakePad(u16 button)
+{
+  GCPadStatus pad = {};
+  pad.button = button;
+  pad.stickX = static_cast<u8>(button);
+  return pad;
+}
+
+static PadStates WriteAndRead(PadSendQueue& queue, u64 now)
+{
+  sf::Packet packet;
+  queue.Write(packet, 2, now);
+  PadStates data;
+  EXPECT_TRUE(NetPlay::ReadPadStates(packet, &data));
+  EXPECT_EQ(2, data.map);
+  return data;
+}
+
+TEST(NetPlayPadQueue, RepeatsUntilAcked)
+{
+  PadSendQueue queue;
+  EXPECT_FALSE(queue.ShouldSend(0));
+
+  queue.Push(MakePad(0));
+  queue.Push(MakePad(1));
+  EXPECT_TRUE(queue.ShouldSend(0));
+  PadStates data = WriteAndRead(queue, 0);
+  EXPECT_EQ(0u, data.first_seq);
+  ASSERT_EQ(2u, data.states.size());
+  EXPECT_EQ(1, data.states[1].button);
+  EXPECT_EQ(1, data.states[1].stickX);
+
+  // Nothing new, so only sent again after a while
+  EXPECT_FALSE(queue.ShouldSend(1));
+  EXPECT_TRUE(queue.ShouldSend(NetPlay::PAD_RESEND_INTERVAL_MS));
+
+  // The first packet got lost, the next one repeats its states
+  queue.Push(MakePad(2));
+  EXPECT_TRUE(queue.ShouldSend(1));
+  data = WriteAndRead(queue, 1);
+  EXPECT_EQ(0u, data.first_seq);
+  EXPECT_EQ(3u, data.states.size());
+
+  queue.Ack(2);
+  data = WriteAndRead(queue, 2);
+  EXPECT_EQ(2u, data.first_seq);
+  ASSERT_EQ(1u, data.states.size());
+  EXPECT_EQ(2, data.states[0].button);
+
+  queue.Ack(3);
+  EXPECT_FALSE(queue.HasUnacked());
+  EXPECT_FALSE(queue.ShouldSend(1000));
+}
+
+TEST(NetPlayPadQueue, LimitsStatesPerPacket)
+{
+  PadSendQueue queue;
+  for (u16 i = 0; i < NetPlay::MAX_PAD_STATES_PER_PACKET + 8; ++i)
+    queue.Push(MakePad(i));
+
+  PadStates data = WriteAndRead(queue, 0);
+  EXPECT_EQ(NetPlay::MAX_PAD_STATES_PER_PACKET, data.states.size());
+  EXPECT_FALSE(queue.ShouldSend(1));
+
+  // The rest goes out as soon as there is room
+  queue.Ack(8);
+  EXPECT_TRUE(queue.ShouldSend(1));
+  data = WriteAndRead(queue, 1);
+  EXPECT_EQ(8u, data.first_seq);
+  EXPECT_EQ(NetPlay::MAX_PAD_STATES_PER_PACKET, data.states.size());
+}
+
+TEST(NetPlayPadQueue, FirstNew)
+{
+  PadStates data;
+  data.first_seq = 10;
+  data.states.resize(4);
+
+  EXPECT_EQ(0u, data.FirstNew(10));
+  EXPECT_EQ(2u, data.FirstNew(12));
+  EXPECT_EQ(4u, data.FirstNew(14));
+  EXPECT_EQ(4u, data.FirstNew(20));
+  // States in between are missing
+  EXPECT_EQ(4u, data.FirstNew(9));
+}
+
+TEST(NetPlayPadQueue, RejectsBadData)
+{
+  sf::Packet packet;
+  packet << static_cast<PadMapping>(4) << static_cast<u32>(0) << static_cast<u8>(0);
+  PadStates data;
+  EXPECT_FALSE(NetPlay::ReadPadStates(packet, &data));
+
+  sf::Packet truncated;
+  truncated << static_cast<PadMapping>(0) << static_cast<u32>(0) << static_cast<u8>(2);
+  EXPECT_FALSE(NetPlay::ReadPadStates(truncated, &data));
+}
@@ -0,0 +1,89 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DiscHash.h"
+
+namespace
+{
+class DiscHashTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_dir = File::CreateTempDir();
+    ASSERT_FALSE(m_dir.empty());
+    m_dir += DIR_SEP;
+    // Keep the hash cache out of the real user directory
+    File::SetUserPath(D_USER_IDX, m_dir);
+
+    // A bit more than two hash chunks
+    m_data.resize(9 * 1024 * 1024 + 123);
+    u32 state = 12345;
+    for (u8& byte : m_data)
+    {
+      state = state * 1103515245 + 12345;
+      byte = (u8)(state >> 16);
+    }
+  }
+
+  void TearDown() override { File::DeleteDirRecursively(m_dir); }
+
+  std::string WriteISO(const std::string& name)
+  {
+    const std::string path = m_dir + name;
+    File::IOFile file(path, "wb");
+    EXPECT_TRUE(file.WriteBytes(m_data.data(), m_data.size()));
+    return path;
+  }
+
+  static std::string Hash(const std::string& path)
+  {
+    return DiscIO::ComputeDiscHash(path, [](int) { return true; });
+  }
+
+  std::string m_dir;
+  std::vector<u8> m_data;
+};
+
+bool CompressCallback(const std::string&, float, void*)
+{
+  return true;
+}
+}
+
+// A GCZ holds every byte of the disc it was made from, so it hashes like that ISO
+TEST_F(DiscHashTest, GCZMatchesISO)
+{
+  const std::string iso = WriteISO("game.iso");
+  const std::string gcz = m_dir + "game.gcz";
+  ASSERT_TRUE(DiscIO::CompressFileToBlob(iso, gcz, 0, 16384, CompressCallback));
+
+  const std::string iso_hash = Hash(iso);
+  EXPECT_EQ(16u, iso_hash.size());
+  EXPECT_EQ(iso_hash, Hash(gcz));
+}
+
+TEST_F(DiscHashTest, ChangedByteChangesHash)
+{
+  const std::string original = Hash(WriteISO("original.iso"));
+  m_data[5 * 1024 * 1024] ^= 1;
+  const std::string changed = Hash(WriteISO("changed.iso"));
+
+  EXPECT_FALSE(original.empty());
+  EXPECT_NE(original, changed);
+}
+
+TEST_F(DiscHashTest, AbortReturnsNothing)
+{
+  const std::string iso = WriteISO("game.iso");
+  EXPECT_EQ("", DiscIO::ComputeDiscHash(iso, [](int) { return false; }));
+}
@@ -0,0 +1,65 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/EFBCacheBase.h"
+#include "VideoCommon/RenderBase.h"
+#include "VideoCommon/VideoCommon.h"
+
+namespace
+{
+// Reads back x + y * EFB_WIDTH for every pixel
+class TestEFBCache final : public EFBCacheBase
+{
+public:
+  int readbacks = 0;
+
+protected:
+  void StartReadback(EFBAccessType type) override { ++readbacks; }
+  bool IsReadbackDone(EFBAccessType type) override { return true; }
+  void FinishReadback(EFBAccessType type, u32* data) override
+  {
+    for (u32 i = 0; i < EFB_WIDTH * EFB_HEIGHT; ++i)
+      data[i] = i;
+  }
+};
+}
+
+TEST(EFBCache, PeekReadsBack)
+{
+  TestEFBCache cache;
+  EXPECT_EQ(EFB_WIDTH - 1u, cache.Peek(PEEK_COLOR, EFB_WIDTH - 1, 0));
+  EXPECT_EQ(EFB_WIDTH * EFB_HEIGHT - 1u, cache.Peek(PEEK_COLOR, EFB_WIDTH - 1, EFB_HEIGHT - 1));
+  EXPECT_EQ(1, cache.readbacks);
+}
+
+TEST(EFBCache, PeekOutsideEFB)
+{
+  TestEFBCache cache;
+  EXPECT_EQ(0u, cache.Peek(PEEK_COLOR, EFB_WIDTH, 0));
+  EXPECT_EQ(0u, cache.Peek(PEEK_Z, 0, EFB_HEIGHT));
+  EXPECT_EQ(0u, cache.Peek(PEEK_COLOR, 1023, 1023));
+}
+
+TEST(EFBCache, PokeOutsideEFB)
+{
+  TestEFBCache cache;
+  cache.Peek(PEEK_COLOR, 0, 0);
+
+  const std::vector<EfbPokeData> points = {
+      {EFB_WIDTH, 0, 0x12345678},
+      {0, EFB_HEIGHT, 0x12345678},
+      {1023, 1023, 0x12345678},
+      {EFB_WIDTH - 1, EFB_HEIGHT - 1, 0xAABBCCDD},
+  };
+  cache.Poke(POKE_COLOR, points.data(), points.size());
+
+  EXPECT_EQ(0xAABBCCDDu, cache.Peek(PEEK_COLOR, EFB_WIDTH - 1, EFB_HEIGHT - 1));
+  EXPECT_EQ(0u, cache.Peek(PEEK_COLOR, 0, 0));
+  EXPECT_EQ(0u, cache.Peek(PEEK_COLOR, EFB_WIDTH, 0));
+  EXPECT_EQ(1, cache.readbacks);
+}
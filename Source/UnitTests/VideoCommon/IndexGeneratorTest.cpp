@@ -0,0 +1,152 @@
+// Copyright 2026 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+namespace
+{
+const u16 RESTART = 0xFFFF;
+
+// Feeds the same sequence of primitives to the generator, returns the number of indices
+u32 GenerateInto(std::vector<u16>* buffer, bool primitive_restart, bool use_simd, int primitive,
+                 const std::vector<u32>& counts)
+{
+  IndexGenerator::Init(primitive_restart, use_simd);
+  IndexGenerator::Start(buffer->data());
+  for (u32 count : counts)
+    IndexGenerator::AddIndices(primitive, count);
+  return IndexGenerator::GetIndexLen();
+}
+
+std::vector<u16> Generate(bool primitive_restart, bool use_simd, int primitive,
+                          const std::vector<u32>& counts)
+{
+  std::vector<u16> buffer(65536 * 6);
+  buffer.resize(GenerateInto(&buffer, primitive_restart, use_simd, primitive, counts));
+  return buffer;
+}
+
+// Rotates a triangle so its smallest index comes first, keeping the winding
+std::array<u16, 3> Normalize(u16 a, u16 b, u16 c)
+{
+  if (b < a && b < c)
+    return {{b, c, a}};
+  if (c < a && c < b)
+    return {{c, a, b}};
+  return {{a, b, c}};
+}
+
+std::vector<std::array<u16, 3>> TrianglesFromList(const std::vector<u16>& indices)
+{
+  std::vector<std::array<u16, 3>> triangles;
+  for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    triangles.push_back(Normalize(indices[i], indices[i + 1], indices[i + 2]));
+  return triangles;
+}
+
+std::vector<std::array<u16, 3>> TrianglesFromStrips(const std::vector<u16>& indices)
+{
+  std::vector<std::array<u16, 3>> triangles;
+  size_t start = 0;
+  for (size_t i = 0; i < indices.size(); ++i)
+  {
+    if (indices[i] != RESTART)
+    {
+      if (i - start >= 2)
+      {
+        bool odd = (i - start) % 2 == 1;
+        u16 a = indices[i - 2], b = indices[i - 1], c = indices[i];
+        triangles.push_back(odd ? Normalize(b, a, c) : Normalize(a, b, c));
+      }
+      continue;
+    }
+    start = i + 1;
+  }
+  return triangles;
+}
+
+const std::vector<u32>& Counts()
+{
+  static std::vector<u32> counts = [] {
+    std::vector<u32> c;
+    for (u32 i = 0; i < 120; ++i)
+      c.push_back(i);
+    c.push_back(1000);
+    c.push_back(4095);
+    return c;
+  }();
+  return counts;
+}
+}
+
+TEST(IndexGenerator, VectorMatchesScalar)
+{
+  for (bool primitive_restart : {false, true})
+  {
+    for (int primitive = GX_DRAW_QUADS; primitive <= GX_DRAW_POINTS; ++primitive)
+    {
+      if (primitive == GX_DRAW_QUADS_2)
+        continue;
+      EXPECT_EQ(Generate(primitive_restart, false, primitive, Counts()),
+                Generate(primitive_restart, true, primitive, Counts()))
+          << "primitive " << primitive << " restart " << primitive_restart;
+    }
+  }
+}
+
+TEST(IndexGenerator, RestartStripsMatchLists)
+{
+  for (int primitive : {GX_DRAW_QUADS, GX_DRAW_TRIANGLES, GX_DRAW_TRIANGLE_STRIP,
+                        GX_DRAW_TRIANGLE_FAN})
+  {
+    for (bool use_simd : {false, true})
+    {
+      EXPECT_EQ(TrianglesFromList(Generate(false, use_simd, primitive, Counts())),
+                TrianglesFromStrips(Generate(true, use_simd, primitive, Counts())))
+          << "primitive " << primitive << " simd " << use_simd;
+    }
+  }
+}
+
+TEST(IndexGenerator, Quads)
+{
+  std::vector<u16> expected = {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7, 8, 9, 10};
+  EXPECT_EQ(expected, Generate(false, true, GX_DRAW_QUADS, {11}));
+  expected = {1, 2, 0, 3, RESTART, 5, 6, 4, 7, RESTART, 8, 9, 10, RESTART};
+  EXPECT_EQ(expected, Generate(true, true, GX_DRAW_QUADS, {11}));
+}
+
+TEST(IndexGenerator, Benchmark)
+{
+  const std::vector<u32> counts(64, 1000);
+  std::vector<u16> buffer(65536 * 6);
+  for (int primitive : {GX_DRAW_QUADS, GX_DRAW_TRIANGLE_STRIP, GX_DRAW_TRIANGLE_FAN})
+  {
+    for (bool primitive_restart : {false, true})
+    {
+      double us[2];
+      for (bool use_simd : {false, true})
+      {
+        auto start = std::chrono::steady_clock::now();
+        size_t len = 0;
+        for (int run = 0; run < 20; ++run)
+          len += GenerateInto(&buffer, primitive_restart, use_simd, primitive, counts);
+        auto end = std::chrono::steady_clock::now();
+        us[use_simd] = std::chrono::duration<double, std::micro>(end - start).count();
+        EXPECT_NE(0u, len);
+      }
+      std::printf("primitive %d restart %d: scalar %.0f us, vector %.0f us\n", primitive,
+                  primitive_restart, us[0], us[1]);
+    }
+  }
+}